@@ -0,0 +1,164 @@
+#ifndef MUTEXGUARD_BENCH_UTIL_H
+#define MUTEXGUARD_BENCH_UTIL_H
+
+/**
+ * @file BenchUtil.h
+ * @brief Shared helpers for the MutexGuard benchmarks
+ *
+ * Benchmarks are plain sketches: on target they run from setup(), on the host
+ * build from main(). Results are printed as one JSON document on stdout so
+ * runs can be diffed or fed to a regression check.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "esp_timer.h"
+
+#ifdef ARDUINO
+    #include <Arduino.h>
+    #define BENCH_PLATFORM "target"
+#else
+    #define BENCH_PLATFORM "host"
+#endif
+
+namespace bench {
+
+/**
+ * @brief Keep the compiler from discarding a value computed by a benchmark
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    __asm__ __volatile__("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Monotonic time in nanoseconds (microsecond resolution on target)
+ */
+inline int64_t nowNs() {
+#ifdef ARDUINO
+    return esp_timer_get_time() * 1000;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Measure the average cost of one call to fn
+ *
+ * Runs the loop `repeats` times after a short warm-up and keeps the fastest
+ * repetition, which filters out preemption and cache noise.
+ *
+ * @return Nanoseconds per operation
+ */
+template <typename Fn>
+double measureNsPerOp(uint32_t iterations, Fn fn, uint32_t repeats = 5) {
+    for (uint32_t i = 0; i < iterations / 10 + 1; i++) {
+        fn();
+    }
+
+    double best = -1.0;
+    for (uint32_t r = 0; r < repeats; r++) {
+        int64_t start = nowNs();
+        for (uint32_t i = 0; i < iterations; i++) {
+            fn();
+        }
+        double perOp = (double)(nowNs() - start) / (double)iterations;
+        if (best < 0.0 || perOp < best) {
+            best = perOp;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Parse an unsigned command line argument with a fallback
+ */
+inline uint32_t argU32(int argc, char** argv, int index, uint32_t fallback) {
+    if (index < argc) {
+        long value = strtol(argv[index], nullptr, 0);
+        if (value > 0) {
+            return (uint32_t)value;
+        }
+    }
+    return fallback;
+}
+
+/**
+ * @brief Minimal streaming JSON writer for benchmark reports
+ *
+ * Produces {"benchmark": ..., "platform": ..., <meta>, "results": [ {...}, ... ]}.
+ */
+class JsonReport {
+public:
+    explicit JsonReport(const char* benchmark) : m_firstResult(true), m_firstField(true) {
+        printf("{\"benchmark\": \"%s\", \"platform\": \"%s\"", benchmark, BENCH_PLATFORM);
+    }
+
+    void meta(const char* key, uint32_t value) { printf(", \"%s\": %u", key, (unsigned)value); }
+    void meta(const char* key, const char* value) { printf(", \"%s\": \"%s\"", key, value); }
+
+    void beginResult() {
+        printf(m_firstResult ? ", \"results\": [\n  {" : ",\n  {");
+        m_firstResult = false;
+        m_firstField = true;
+    }
+
+    void field(const char* key, const char* value) {
+        separator();
+        printf("\"%s\": \"%s\"", key, value);
+    }
+    void field(const char* key, uint32_t value) {
+        separator();
+        printf("\"%s\": %u", key, (unsigned)value);
+    }
+    void field(const char* key, double value) {
+        separator();
+        printf("\"%s\": %.2f", key, value);
+    }
+
+    void endResult() { printf("}"); }
+
+    void finish() {
+        printf(m_firstResult ? ", \"results\": []}\n" : "\n]}\n");
+        fflush(stdout);
+    }
+
+private:
+    void separator() {
+        if (!m_firstField) {
+            printf(", ");
+        }
+        m_firstField = false;
+    }
+
+    bool m_firstResult;
+    bool m_firstField;
+};
+
+} // namespace bench
+
+/**
+ * @brief Define the sketch entry points for a benchmark function
+ *
+ * `entry` has the signature int(int argc, char** argv); on target it is
+ * called once from setup() with no arguments.
+ */
+#ifdef ARDUINO
+    #define BENCH_MAIN(entry)                                   \
+        void setup() {                                          \
+            Serial.begin(115200);                               \
+            delay(2000);                                        \
+            entry(0, nullptr);                                  \
+        }                                                       \
+        void loop() { vTaskDelay(portMAX_DELAY); }
+#else
+    #define BENCH_MAIN(entry)                                   \
+        int main(int argc, char** argv) { return entry(argc, argv); }
+#endif
+
+#endif // MUTEXGUARD_BENCH_UTIL_H
@@ -0,0 +1,267 @@
+/**
+ * @file bench_contended_scaling.cpp
+ * @brief Contended guard throughput and acquisition latency across 1..N tasks
+ *
+ * Usage (host): bench_contended_scaling [max_tasks] [cs_ns_list] [duration_ms] [csv|json] [mutex|adaptive]
+ *   max_tasks    Largest task count; runs 1, 2, 4, ... up to it (default 8)
+ *   cs_ns_list   Comma separated critical-section lengths in ns (default 0,1000,10000)
+ *   duration_ms  Measurement window per configuration (default 500)
+ *   guard        mutex (MutexGuard, default) or adaptive (AdaptiveMutexGuard)
+ *
+ * Each task loops: take a guard, busy-spin for the critical-section
+ * length, release. The time spent in the guard constructor is recorded as the
+ * acquisition latency. Output is one row per (tasks, cs_ns) pair so the knee
+ * where throughput stops scaling can be plotted directly.
+ */
+
+#include "BenchUtil.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "AdaptiveMutex.h"
+#include "MutexGuard.h"
+
+namespace {
+
+#ifdef ARDUINO
+const size_t kMaxSamplesPerTask = 2048;
+#else
+const size_t kMaxSamplesPerTask = 1u << 16;
+#endif
+const size_t kMaxCsLengths = 8;
+
+struct WorkerContext {
+    SemaphoreHandle_t mutex;
+    AdaptiveMutex* adaptive;  ///< Used instead of mutex when not null
+    SemaphoreHandle_t start;
+    SemaphoreHandle_t done;
+    std::atomic<bool>* stop;
+    uint32_t csNs;
+    uint32_t ops;
+    uint32_t timeouts;
+    uint32_t sampleCount;
+    std::vector<uint32_t> samples;  ///< Acquisition latencies in ns
+};
+
+struct Row {
+    uint32_t tasks;
+    uint32_t csNs;
+    uint32_t ops;
+    uint32_t timeouts;
+    double opsPerSec;
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t p999;
+    uint32_t max;
+};
+
+void spinFor(uint32_t ns) {
+    if (ns == 0) {
+        return;
+    }
+    int64_t end = bench::nowNs() + ns;
+    while (bench::nowNs() < end) {
+    }
+}
+
+/**
+ * Run one critical section under an already constructed guard.
+ * @return false if the guard timed out
+ */
+template <typename Guard>
+bool criticalSection(Guard& lock, uint32_t csNs) {
+    if (!lock) {
+        return false;
+    }
+    spinFor(csNs);
+    lock.unlock();
+    return true;
+}
+
+void workerTask(void* param) {
+    WorkerContext* ctx = static_cast<WorkerContext*>(param);
+
+    xSemaphoreTake(ctx->start, portMAX_DELAY);
+
+    while (!ctx->stop->load(std::memory_order_relaxed)) {
+        int64_t t0 = bench::nowNs();
+        int64_t t1;
+        bool locked;
+        if (ctx->adaptive != nullptr) {
+            AdaptiveMutexGuard lock(*ctx->adaptive, pdMS_TO_TICKS(1000));
+            t1 = bench::nowNs();
+            locked = criticalSection(lock, ctx->csNs);
+        } else {
+            MutexGuard lock(ctx->mutex, pdMS_TO_TICKS(1000));
+            t1 = bench::nowNs();
+            locked = criticalSection(lock, ctx->csNs);
+        }
+
+        if (!locked) {
+            ctx->timeouts++;
+            continue;
+        }
+
+        // Keep the most recent kMaxSamplesPerTask latencies so long runs
+        // stay within a fixed buffer.
+        uint32_t latency = (uint32_t)(t1 - t0);
+        ctx->samples[ctx->sampleCount % kMaxSamplesPerTask] = latency;
+        ctx->sampleCount++;
+        ctx->ops++;
+
+        // Give same-priority peers a chance on single-core targets
+        if ((ctx->ops & 0xff) == 0) {
+            taskYIELD();
+        }
+    }
+
+    xSemaphoreGive(ctx->done);
+    vTaskDelete(NULL);
+}
+
+uint32_t percentile(const std::vector<uint32_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+Row runConfiguration(uint32_t tasks, uint32_t csNs, uint32_t durationMs, bool adaptive) {
+    SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+    AdaptiveMutex* adaptiveMutex = adaptive ? new AdaptiveMutex() : nullptr;
+    SemaphoreHandle_t start = xSemaphoreCreateCounting(tasks, 0);
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(tasks, 0);
+    std::atomic<bool> stop(false);
+
+    std::vector<WorkerContext> contexts(tasks);
+    for (uint32_t i = 0; i < tasks; i++) {
+        WorkerContext& ctx = contexts[i];
+        ctx.mutex = mutex;
+        ctx.adaptive = adaptiveMutex;
+        ctx.start = start;
+        ctx.done = done;
+        ctx.stop = &stop;
+        ctx.csNs = csNs;
+        ctx.ops = 0;
+        ctx.timeouts = 0;
+        ctx.sampleCount = 0;
+        ctx.samples.assign(kMaxSamplesPerTask, 0);
+        xTaskCreatePinnedToCore(workerTask, "bench", 4096, &ctx, 1, nullptr,
+                                (BaseType_t)(i % portNUM_PROCESSORS));
+    }
+
+    int64_t begin = bench::nowNs();
+    for (uint32_t i = 0; i < tasks; i++) {
+        xSemaphoreGive(start);
+    }
+    vTaskDelay(pdMS_TO_TICKS(durationMs));
+    stop.store(true, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < tasks; i++) {
+        xSemaphoreTake(done, portMAX_DELAY);
+    }
+    int64_t elapsed = bench::nowNs() - begin;
+
+    Row row;
+    row.tasks = tasks;
+    row.csNs = csNs;
+    row.ops = 0;
+    row.timeouts = 0;
+
+    std::vector<uint32_t> all;
+    for (uint32_t i = 0; i < tasks; i++) {
+        const WorkerContext& ctx = contexts[i];
+        row.ops += ctx.ops;
+        row.timeouts += ctx.timeouts;
+        size_t kept = std::min<size_t>(ctx.sampleCount, kMaxSamplesPerTask);
+        all.insert(all.end(), ctx.samples.begin(), ctx.samples.begin() + kept);
+    }
+    std::sort(all.begin(), all.end());
+
+    row.opsPerSec = elapsed > 0 ? (double)row.ops * 1e9 / (double)elapsed : 0.0;
+    row.p50 = percentile(all, 0.50);
+    row.p99 = percentile(all, 0.99);
+    row.p999 = percentile(all, 0.999);
+    row.max = all.empty() ? 0 : all.back();
+
+    vSemaphoreDelete(mutex);
+    delete adaptiveMutex;
+    vSemaphoreDelete(start);
+    vSemaphoreDelete(done);
+    return row;
+}
+
+size_t parseCsList(const char* text, uint32_t* out, size_t capacity) {
+    size_t count = 0;
+    while (text != nullptr && *text != '\0' && count < capacity) {
+        char* end = nullptr;
+        out[count++] = (uint32_t)strtoul(text, &end, 10);
+        if (end == text) {
+            break;
+        }
+        text = (*end == ',') ? end + 1 : end;
+    }
+    return count;
+}
+
+int runContendedScaling(int argc, char** argv) {
+    const uint32_t maxTasks = bench::argU32(argc, argv, 1, 8);
+    uint32_t csLengths[kMaxCsLengths] = {0, 1000, 10000};
+    size_t csCount = 3;
+    if (argc > 2) {
+        csCount = parseCsList(argv[2], csLengths, kMaxCsLengths);
+    }
+    const uint32_t durationMs = bench::argU32(argc, argv, 3, 500);
+    const bool csv = !(argc > 4 && strcmp(argv[4], "json") == 0);
+    const bool adaptive = argc > 5 && strcmp(argv[5], "adaptive") == 0;
+
+    std::vector<Row> rows;
+    for (size_t c = 0; c < csCount; c++) {
+        for (uint32_t tasks = 1; tasks <= maxTasks; tasks *= 2) {
+            rows.push_back(runConfiguration(tasks, csLengths[c], durationMs, adaptive));
+        }
+    }
+
+    if (csv) {
+        printf("tasks,cs_ns,ops,ops_per_sec,p50_ns,p99_ns,p999_ns,max_ns,timeouts\n");
+        for (size_t i = 0; i < rows.size(); i++) {
+            const Row& r = rows[i];
+            printf("%u,%u,%u,%.0f,%u,%u,%u,%u,%u\n", (unsigned)r.tasks, (unsigned)r.csNs,
+                   (unsigned)r.ops, r.opsPerSec, (unsigned)r.p50, (unsigned)r.p99,
+                   (unsigned)r.p999, (unsigned)r.max, (unsigned)r.timeouts);
+        }
+        fflush(stdout);
+        return 0;
+    }
+
+    bench::JsonReport json("contended_scaling");
+    json.meta("duration_ms", durationMs);
+    json.meta("guard", adaptive ? "adaptive" : "mutex");
+    for (size_t i = 0; i < rows.size(); i++) {
+        const Row& r = rows[i];
+        json.beginResult();
+        json.field("tasks", r.tasks);
+        json.field("cs_ns", r.csNs);
+        json.field("ops", r.ops);
+        json.field("ops_per_sec", r.opsPerSec);
+        json.field("p50_ns", r.p50);
+        json.field("p99_ns", r.p99);
+        json.field("p999_ns", r.p999);
+        json.field("max_ns", r.max);
+        json.field("timeouts", r.timeouts);
+        json.endResult();
+    }
+    json.finish();
+    return 0;
+}
+
+} // namespace
+
+BENCH_MAIN(runContendedScaling)
@@ -0,0 +1,121 @@
+/**
+ * @file bench_guard_inline.cpp
+ * @brief Call-site size and latency of MutexGuard, out of line vs MUTEXGUARD_HEADER_ONLY
+ *
+ * Usage (host): bench_guard_inline [iterations]
+ *
+ * Built twice by CMake: bench_guard_inline calls the guard compiled in the
+ * library, bench_guard_inline_header_only defines MUTEXGUARD_HEADER_ONLY and
+ * gets it inlined. On target, compare the guard-inline and
+ * guard-inline-header-only environments of bench/platformio.ini.
+ *
+ * Each probe is a noinline function holding one typical guard use. The
+ * report gives its ns/op (and cycles/op on target) and, on ELF hosts, the
+ * size of the probe function in bytes, i.e. what every such call site costs
+ * in flash. The out-of-line build additionally carries one shared copy of
+ * the guard in the library.
+ */
+
+#include "BenchUtil.h"
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "MutexGuard.h"
+
+#ifdef MUTEXGUARD_HEADER_ONLY
+#define GUARD_MODE "header_only"
+#else
+#define GUARD_MODE "out_of_line"
+#endif
+
+// Each probe gets its own section so the linker-provided __start_/__stop_
+// symbols give its size
+#if defined(__ELF__) && !defined(ARDUINO)
+#define PROBE_SIZE_AVAILABLE 1
+#define PROBE(name) __attribute__((noinline, used, section(#name)))
+#define PROBE_BOUNDS(name)                   \
+    extern "C" const char __start_##name[]; \
+    extern "C" const char __stop_##name[];
+#define PROBE_BYTES(name) ((uint32_t)(__stop_##name - __start_##name))
+#else
+#define PROBE_SIZE_AVAILABLE 0
+#define PROBE(name) __attribute__((noinline))
+#define PROBE_BOUNDS(name)
+#define PROBE_BYTES(name) 0u
+#endif
+
+PROBE_BOUNDS(mg_probe_scope)
+PROBE_BOUNDS(mg_probe_unlock)
+PROBE_BOUNDS(mg_probe_try)
+
+namespace {
+
+SemaphoreHandle_t g_mutex = nullptr;
+volatile uint32_t g_counter = 0;
+
+PROBE(mg_probe_scope) void probeScope() {
+    MutexGuard lock(g_mutex);
+    if (lock) {
+        g_counter = g_counter + 1;
+    }
+}
+
+PROBE(mg_probe_unlock) void probeEarlyUnlock() {
+    MutexGuard lock(g_mutex);
+    if (lock) {
+        g_counter = g_counter + 1;
+        lock.unlock();
+    }
+}
+
+PROBE(mg_probe_try) bool probeTry() {
+    MutexGuard lock(g_mutex, 0);
+    return lock.hasLock();
+}
+
+void report(bench::JsonReport& json, const char* name, double nsPerOp, uint32_t bytes) {
+    json.beginResult();
+    json.field("name", name);
+    json.field("ns_per_op", nsPerOp);
+#ifdef ARDUINO
+    json.field("cycles_per_op", nsPerOp * getCpuFrequencyMhz() / 1000.0);
+#endif
+    if (PROBE_SIZE_AVAILABLE) {
+        json.field("call_site_bytes", bytes);
+    }
+    json.endResult();
+}
+
+int runGuardInline(int argc, char** argv) {
+    const uint32_t iterations = bench::argU32(argc, argv, 1, 200000);
+
+    g_mutex = xSemaphoreCreateMutex();
+    esp_log_level_set("*", ESP_LOG_NONE);
+
+    bench::JsonReport json("guard_inline");
+    json.meta("mode", GUARD_MODE);
+    json.meta("iterations", iterations);
+
+    report(json, "guard_scope", bench::measureNsPerOp(iterations, [] { probeScope(); }),
+           PROBE_BYTES(mg_probe_scope));
+    report(json, "guard_early_unlock", bench::measureNsPerOp(iterations, [] { probeEarlyUnlock(); }),
+           PROBE_BYTES(mg_probe_unlock));
+
+    // Held by this task, so the zero-timeout take fails immediately
+    xSemaphoreTake(g_mutex, portMAX_DELAY);
+    report(json, "guard_try_fail", bench::measureNsPerOp(iterations, [] {
+        bench::doNotOptimize(probeTry());
+    }), PROBE_BYTES(mg_probe_try));
+    xSemaphoreGive(g_mutex);
+
+    json.finish();
+    esp_log_level_set("*", ESP_LOG_INFO);
+
+    vSemaphoreDelete(g_mutex);
+    return 0;
+}
+
+} // namespace
+
+BENCH_MAIN(runGuardInline)
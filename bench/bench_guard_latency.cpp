@@ -0,0 +1,145 @@
+/**
+ * @file bench_guard_latency.cpp
+ * @brief Uncontended acquire/release latency of the guards vs raw FreeRTOS calls
+ *
+ * Usage (host): bench_guard_latency [iterations]
+ *
+ * Every case is timed single-task so the numbers isolate the per-call cost of
+ * the guard (null check, ISR check, bookkeeping) on top of the semaphore
+ * operations. Guard cases report their ratio to the matching raw baseline.
+ * Logging is silenced at runtime so the null-handle cases time the check and
+ * the log level test, not the UART.
+ */
+
+#include "BenchUtil.h"
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "AdaptiveMutex.h"
+#include "MutexGuard.h"
+#include "RecursiveMutexGuard.h"
+
+namespace {
+
+SemaphoreHandle_t g_mutex = nullptr;
+SemaphoreHandle_t g_recursive = nullptr;
+AdaptiveMutex* g_adaptive = nullptr;
+
+void report(bench::JsonReport& json, const char* name, double nsPerOp, double baselineNs) {
+    json.beginResult();
+    json.field("name", name);
+    json.field("ns_per_op", nsPerOp);
+    if (baselineNs > 0.0) {
+        json.field("vs_raw", nsPerOp / baselineNs);
+    }
+    json.endResult();
+}
+
+int runGuardLatency(int argc, char** argv) {
+    const uint32_t iterations = bench::argU32(argc, argv, 1, 200000);
+
+    g_mutex = xSemaphoreCreateMutex();
+    g_recursive = xSemaphoreCreateRecursiveMutex();
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+
+    bench::JsonReport json("guard_latency");
+    json.meta("iterations", iterations);
+
+    // --- Standard mutex --------------------------------------------------
+
+    double raw = bench::measureNsPerOp(iterations, [] {
+        xSemaphoreTake(g_mutex, portMAX_DELAY);
+        xSemaphoreGive(g_mutex);
+    });
+    report(json, "raw_take_give", raw, 0.0);
+
+    report(json, "mutex_guard_scope", bench::measureNsPerOp(iterations, [] {
+        MutexGuard lock(g_mutex);
+        bench::doNotOptimize(lock.hasLock());
+    }), raw);
+
+    report(json, "mutex_guard_unlock", bench::measureNsPerOp(iterations, [] {
+        MutexGuard lock(g_mutex);
+        lock.unlock();
+        bench::doNotOptimize(lock.hasLock());
+    }), raw);
+
+    // Inline instantiation without checks or logging
+    report(json, "unchecked_guard_scope", bench::measureNsPerOp(iterations, [] {
+        BasicGuard<MutexLockPolicy, NoGuardChecks, SilentGuardLog> lock(g_mutex);
+        bench::doNotOptimize(lock.hasLock());
+    }), raw);
+
+    report(json, "mutex_guard_null_handle", bench::measureNsPerOp(iterations, [] {
+        MutexGuard lock(nullptr);
+        bench::doNotOptimize(lock.hasLock());
+    }), 0.0);
+
+    // Held by this task: a non-recursive take with zero timeout fails
+    // immediately, which isolates the failure path without sleeping.
+    xSemaphoreTake(g_mutex, portMAX_DELAY);
+    double rawTimeout = bench::measureNsPerOp(iterations, [] {
+        bench::doNotOptimize(xSemaphoreTake(g_mutex, 0));
+    });
+    report(json, "raw_take_timeout", rawTimeout, 0.0);
+    report(json, "mutex_guard_timeout", bench::measureNsPerOp(iterations, [] {
+        MutexGuard lock(g_mutex, 0);
+        bench::doNotOptimize(lock.hasLock());
+    }), rawTimeout);
+    xSemaphoreGive(g_mutex);
+
+    // --- Recursive mutex -------------------------------------------------
+
+    double rawRecursive = bench::measureNsPerOp(iterations, [] {
+        xSemaphoreTakeRecursive(g_recursive, portMAX_DELAY);
+        xSemaphoreGiveRecursive(g_recursive);
+    });
+    report(json, "raw_take_give_recursive", rawRecursive, 0.0);
+
+    report(json, "recursive_guard_scope", bench::measureNsPerOp(iterations, [] {
+        RecursiveMutexGuard lock(g_recursive);
+        bench::doNotOptimize(lock.hasLock());
+    }), rawRecursive);
+
+    report(json, "recursive_guard_unlock", bench::measureNsPerOp(iterations, [] {
+        RecursiveMutexGuard lock(g_recursive);
+        lock.unlock();
+        bench::doNotOptimize(lock.hasLock());
+    }), rawRecursive);
+
+    // Re-entrant acquisition while the outer level is already held
+    xSemaphoreTakeRecursive(g_recursive, portMAX_DELAY);
+    report(json, "recursive_guard_nested", bench::measureNsPerOp(iterations, [] {
+        RecursiveMutexGuard lock(g_recursive);
+        bench::doNotOptimize(lock.hasLock());
+    }), rawRecursive);
+    xSemaphoreGiveRecursive(g_recursive);
+
+    report(json, "recursive_guard_null_handle", bench::measureNsPerOp(iterations, [] {
+        RecursiveMutexGuard lock(nullptr);
+        bench::doNotOptimize(lock.hasLock());
+    }), 0.0);
+
+    // --- Adaptive mutex --------------------------------------------------
+
+    // Uncontended, so this is the CAS fast path without spinning or blocking
+    g_adaptive = new AdaptiveMutex();
+    report(json, "adaptive_guard_scope", bench::measureNsPerOp(iterations, [] {
+        AdaptiveMutexGuard lock(*g_adaptive);
+        bench::doNotOptimize(lock.hasLock());
+    }), raw);
+    delete g_adaptive;
+
+    json.finish();
+    esp_log_level_set("*", ESP_LOG_INFO);
+
+    vSemaphoreDelete(g_mutex);
+    vSemaphoreDelete(g_recursive);
+    return 0;
+}
+
+} // namespace
+
+BENCH_MAIN(runGuardLatency)
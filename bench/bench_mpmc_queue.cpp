@@ -0,0 +1,222 @@
+/**
+ * @file bench_mpmc_queue.cpp
+ * @brief Fan-in throughput of MpmcQueue vs a MutexGuard-protected buffer
+ *
+ * Usage (host): bench_mpmc_queue [max_producers] [duration_ms]
+ *   max_producers  Largest producer count; runs 1, 2, 4, ... (default 16)
+ *   duration_ms    Measurement window per configuration (default 300)
+ *
+ * Producer tasks spread over all cores push uint32_t records as fast as
+ * they can; one consumer task drains them, like sensor tasks feeding a
+ * logger. The mutex buffer is the ThreadSafeBuffer pattern (MutexGuard
+ * around every push and pop). `mpmc_queue` uses tryPush()/tryPop() with the
+ * same retry policy, taskYIELD() when full or empty, so the two rows compare
+ * the data structures. `mpmc_queue_blocking` uses push()/pop(), which sleep
+ * on a semaphore instead and show the cost of that hand-off when the
+ * producers outrun the consumer. All hold 128 elements. Reports items/sec
+ * through the consumer and, for the queues, the speedup over the mutex
+ * buffer at the same producer count.
+ */
+
+#include "BenchUtil.h"
+
+#include <atomic>
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "MpmcQueue.h"
+#include "MutexGuard.h"
+
+namespace {
+
+const size_t kCapacity = 128;
+const TickType_t kPollTicks = pdMS_TO_TICKS(10);  ///< Bounded waits so tasks notice the stop flag
+
+class MutexBuffer {
+public:
+    MutexBuffer() : m_writeIndex(0), m_readIndex(0), m_count(0), m_mutex(xSemaphoreCreateMutex()) {}
+    ~MutexBuffer() { vSemaphoreDelete(m_mutex); }
+
+    bool push(uint32_t value) {
+        MutexGuard lock(m_mutex, portMAX_DELAY);
+        if (m_count >= kCapacity) {
+            return false;
+        }
+        m_buffer[m_writeIndex] = value;
+        m_writeIndex = (m_writeIndex + 1) % kCapacity;
+        m_count++;
+        return true;
+    }
+
+    bool pop(uint32_t& value) {
+        MutexGuard lock(m_mutex, portMAX_DELAY);
+        if (m_count == 0) {
+            return false;
+        }
+        value = m_buffer[m_readIndex];
+        m_readIndex = (m_readIndex + 1) % kCapacity;
+        m_count--;
+        return true;
+    }
+
+private:
+    uint32_t m_buffer[kCapacity];
+    size_t m_writeIndex;
+    size_t m_readIndex;
+    size_t m_count;
+    SemaphoreHandle_t m_mutex;
+};
+
+// Static so the cache-line alignment holds (C++11 new ignores it)
+MpmcQueue<uint32_t, kCapacity> queue;
+
+enum Mode {
+    kMutexBuffer,
+    kMpmcQueue,
+    kMpmcQueueBlocking
+};
+
+const char* modeName(Mode mode) {
+    switch (mode) {
+        case kMutexBuffer: return "mutex_buffer";
+        case kMpmcQueue: return "mpmc_queue";
+        case kMpmcQueueBlocking: return "mpmc_queue_blocking";
+    }
+    return "?";
+}
+
+struct Context {
+    Mode mode;
+    MutexBuffer* buffer;
+    SemaphoreHandle_t start;
+    SemaphoreHandle_t done;
+    std::atomic<bool> stop;
+    std::atomic<uint32_t> consumed;
+};
+
+void producerTask(void* param) {
+    Context* ctx = static_cast<Context*>(param);
+    uint32_t sequence = 0;
+
+    xSemaphoreTake(ctx->start, portMAX_DELAY);
+    while (!ctx->stop.load(std::memory_order_relaxed)) {
+        bool pushed = false;
+        switch (ctx->mode) {
+            case kMutexBuffer: pushed = ctx->buffer->push(sequence); break;
+            case kMpmcQueue: pushed = queue.tryPush(sequence); break;
+            case kMpmcQueueBlocking: pushed = queue.push(sequence, kPollTicks); break;
+        }
+        if (pushed) {
+            sequence++;
+        } else if (ctx->mode != kMpmcQueueBlocking) {
+            taskYIELD();
+        }
+    }
+
+    xSemaphoreGive(ctx->done);
+    vTaskDelete(NULL);
+}
+
+void consumerTask(void* param) {
+    Context* ctx = static_cast<Context*>(param);
+    uint32_t consumed = 0;
+    uint32_t value = 0;
+
+    xSemaphoreTake(ctx->start, portMAX_DELAY);
+    while (!ctx->stop.load(std::memory_order_relaxed)) {
+        bool popped = false;
+        switch (ctx->mode) {
+            case kMutexBuffer: popped = ctx->buffer->pop(value); break;
+            case kMpmcQueue: popped = queue.tryPop(value); break;
+            case kMpmcQueueBlocking: popped = queue.pop(value, kPollTicks); break;
+        }
+        if (popped) {
+            consumed++;
+        } else if (ctx->mode != kMpmcQueueBlocking) {
+            taskYIELD();
+        }
+        bench::doNotOptimize(value);
+    }
+
+    ctx->consumed.store(consumed, std::memory_order_relaxed);
+    xSemaphoreGive(ctx->done);
+    vTaskDelete(NULL);
+}
+
+double runConfiguration(bench::JsonReport& json, Mode mode, uint32_t producers,
+                        uint32_t durationMs, double mutexItemsPerSec) {
+    const uint32_t tasks = producers + 1;
+
+    Context* ctx = new Context();
+    ctx->mode = mode;
+    ctx->buffer = mode == kMutexBuffer ? new MutexBuffer() : nullptr;
+    ctx->start = xSemaphoreCreateCounting(tasks, 0);
+    ctx->done = xSemaphoreCreateCounting(tasks, 0);
+    ctx->stop.store(false);
+    ctx->consumed.store(0);
+
+    // Consumer on core 0, producers spread over all cores
+    xTaskCreatePinnedToCore(consumerTask, "consumer", 4096, ctx, 1, nullptr, 0);
+    for (uint32_t i = 0; i < producers; i++) {
+        xTaskCreatePinnedToCore(producerTask, "producer", 4096, ctx, 1, nullptr,
+                                (BaseType_t)((i + 1) % portNUM_PROCESSORS));
+    }
+
+    int64_t begin = bench::nowNs();
+    for (uint32_t i = 0; i < tasks; i++) {
+        xSemaphoreGive(ctx->start);
+    }
+    vTaskDelay(pdMS_TO_TICKS(durationMs));
+    ctx->stop.store(true, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < tasks; i++) {
+        xSemaphoreTake(ctx->done, portMAX_DELAY);
+    }
+    double seconds = (double)(bench::nowNs() - begin) / 1e9;
+    double itemsPerSec = seconds > 0.0 ? (double)ctx->consumed.load() / seconds : 0.0;
+
+    json.beginResult();
+    json.field("buffer", modeName(mode));
+    json.field("producers", producers);
+    json.field("items_per_sec", itemsPerSec);
+    if (mode != kMutexBuffer) {
+        json.field("speedup", mutexItemsPerSec > 0.0 ? itemsPerSec / mutexItemsPerSec : 0.0);
+    }
+    json.endResult();
+
+    // Leave the queue empty for the next configuration
+    uint32_t drained;
+    while (queue.tryPop(drained)) {
+    }
+
+    delete ctx->buffer;
+    vSemaphoreDelete(ctx->start);
+    vSemaphoreDelete(ctx->done);
+    delete ctx;
+    return itemsPerSec;
+}
+
+int runMpmcQueueBench(int argc, char** argv) {
+    const uint32_t maxProducers = bench::argU32(argc, argv, 1, 16);
+    const uint32_t durationMs = bench::argU32(argc, argv, 2, 300);
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+
+    bench::JsonReport json("mpmc_queue");
+    json.meta("duration_ms", durationMs);
+    json.meta("capacity", (uint32_t)kCapacity);
+
+    for (uint32_t producers = 1; producers <= maxProducers; producers *= 2) {
+        double mutexItemsPerSec = runConfiguration(json, kMutexBuffer, producers, durationMs, 0.0);
+        runConfiguration(json, kMpmcQueue, producers, durationMs, mutexItemsPerSec);
+        runConfiguration(json, kMpmcQueueBlocking, producers, durationMs, mutexItemsPerSec);
+    }
+
+    json.finish();
+    return 0;
+}
+
+} // namespace
+
+BENCH_MAIN(runMpmcQueueBench)
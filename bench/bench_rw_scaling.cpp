@@ -0,0 +1,171 @@
+/**
+ * @file bench_rw_scaling.cpp
+ * @brief Read throughput of SharedGuard vs MutexGuard as reader tasks are added
+ *
+ * Usage (host): bench_rw_scaling [max_readers] [read_cs_ns] [duration_ms] [write_period_ms]
+ *   max_readers      Largest reader count; runs 1, 2, 4, ... (default 2 * portNUM_PROCESSORS)
+ *   read_cs_ns       Length of each read-side critical section (default 2000)
+ *   duration_ms      Measurement window per configuration (default 300)
+ *   write_period_ms  One writer updates the data this often (default 10)
+ *
+ * Readers are pinned round-robin to the cores and loop: take the lock,
+ * busy-spin for read_cs_ns, release. With MutexGuard every reader is
+ * serialized, so reads/sec stays flat; with SharedGuard readers overlap
+ * and reads/sec grows with the number of cores. The writer's completed
+ * updates are reported to show that writers still make progress.
+ */
+
+#include "BenchUtil.h"
+
+#include <atomic>
+#include <vector>
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "MutexGuard.h"
+#include "SharedMutex.h"
+
+namespace {
+
+struct Shared {
+    SemaphoreHandle_t mutex;   ///< Used when rw is null
+    SharedMutex* rw;
+    uint32_t csNs;
+    uint32_t writePeriodMs;
+    SemaphoreHandle_t start;
+    SemaphoreHandle_t done;
+    std::atomic<bool> stop;
+    std::atomic<uint32_t> reads;
+    std::atomic<uint32_t> writes;
+};
+
+void spinFor(uint32_t ns) {
+    int64_t end = bench::nowNs() + ns;
+    while (bench::nowNs() < end) {
+    }
+}
+
+void readerTask(void* param) {
+    Shared* shared = static_cast<Shared*>(param);
+    uint32_t reads = 0;
+
+    xSemaphoreTake(shared->start, portMAX_DELAY);
+    while (!shared->stop.load(std::memory_order_relaxed)) {
+        if (shared->rw != nullptr) {
+            SharedGuard lock(*shared->rw, portMAX_DELAY);
+            spinFor(shared->csNs);
+        } else {
+            MutexGuard lock(shared->mutex, portMAX_DELAY);
+            spinFor(shared->csNs);
+        }
+        reads++;
+
+        // Give same-priority peers a chance on single-core targets
+        if ((reads & 0xff) == 0) {
+            taskYIELD();
+        }
+    }
+
+    shared->reads.fetch_add(reads, std::memory_order_relaxed);
+    xSemaphoreGive(shared->done);
+    vTaskDelete(NULL);
+}
+
+void writerTask(void* param) {
+    Shared* shared = static_cast<Shared*>(param);
+
+    xSemaphoreTake(shared->start, portMAX_DELAY);
+    while (!shared->stop.load(std::memory_order_relaxed)) {
+        vTaskDelay(pdMS_TO_TICKS(shared->writePeriodMs));
+        if (shared->rw != nullptr) {
+            ExclusiveGuard lock(*shared->rw, portMAX_DELAY);
+            spinFor(shared->csNs);
+        } else {
+            MutexGuard lock(shared->mutex, portMAX_DELAY);
+            spinFor(shared->csNs);
+        }
+        shared->writes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    xSemaphoreGive(shared->done);
+    vTaskDelete(NULL);
+}
+
+void runConfiguration(bench::JsonReport& json, bool useShared, uint32_t readers, uint32_t csNs,
+                      uint32_t durationMs, uint32_t writePeriodMs) {
+    const uint32_t tasks = readers + (writePeriodMs > 0 ? 1 : 0);
+
+    Shared shared;
+    shared.mutex = useShared ? nullptr : xSemaphoreCreateMutex();
+    shared.rw = useShared ? new SharedMutex() : nullptr;
+    shared.csNs = csNs;
+    shared.writePeriodMs = writePeriodMs;
+    shared.start = xSemaphoreCreateCounting(tasks, 0);
+    shared.done = xSemaphoreCreateCounting(tasks, 0);
+    shared.stop.store(false);
+    shared.reads.store(0);
+    shared.writes.store(0);
+
+    for (uint32_t i = 0; i < readers; i++) {
+        xTaskCreatePinnedToCore(readerTask, "reader", 4096, &shared, 1, nullptr,
+                                (BaseType_t)(i % portNUM_PROCESSORS));
+    }
+    if (writePeriodMs > 0) {
+        xTaskCreate(writerTask, "writer", 4096, &shared, 2, nullptr);
+    }
+
+    int64_t begin = bench::nowNs();
+    for (uint32_t i = 0; i < tasks; i++) {
+        xSemaphoreGive(shared.start);
+    }
+    vTaskDelay(pdMS_TO_TICKS(durationMs));
+    shared.stop.store(true, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < tasks; i++) {
+        xSemaphoreTake(shared.done, portMAX_DELAY);
+    }
+    int64_t elapsed = bench::nowNs() - begin;
+
+    double readsPerSec = elapsed > 0 ? (double)shared.reads.load() * 1e9 / (double)elapsed : 0.0;
+    json.beginResult();
+    json.field("guard", useShared ? "shared_guard" : "mutex_guard");
+    json.field("readers", readers);
+    json.field("reads_per_sec", readsPerSec);
+    json.field("writes", shared.writes.load());
+    json.endResult();
+
+    if (shared.mutex != nullptr) {
+        vSemaphoreDelete(shared.mutex);
+    }
+    delete shared.rw;
+    vSemaphoreDelete(shared.start);
+    vSemaphoreDelete(shared.done);
+}
+
+int runRwScaling(int argc, char** argv) {
+    const uint32_t maxReaders = bench::argU32(argc, argv, 1, 2 * portNUM_PROCESSORS);
+    const uint32_t csNs = bench::argU32(argc, argv, 2, 2000);
+    const uint32_t durationMs = bench::argU32(argc, argv, 3, 300);
+    // 0 is a meaningful value here (no writer), so argU32's fallback is not used
+    const uint32_t writePeriodMs = argc > 4 ? (uint32_t)strtoul(argv[4], nullptr, 10) : 10;
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+
+    bench::JsonReport json("rw_scaling");
+    json.meta("read_cs_ns", csNs);
+    json.meta("duration_ms", durationMs);
+    json.meta("write_period_ms", writePeriodMs);
+
+    for (uint32_t readers = 1; readers <= maxReaders; readers *= 2) {
+        runConfiguration(json, false, readers, csNs, durationMs, writePeriodMs);
+        runConfiguration(json, true, readers, csNs, durationMs, writePeriodMs);
+    }
+
+    json.finish();
+    return 0;
+}
+
+} // namespace
+
+BENCH_MAIN(runRwScaling)
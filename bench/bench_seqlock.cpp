@@ -0,0 +1,184 @@
+/**
+ * @file bench_seqlock.cpp
+ * @brief Snapshot read throughput of SeqLocked<T> vs MutexGuard under a concurrent writer
+ *
+ * Usage (host): bench_seqlock [max_readers] [duration_ms] [write_period_us]
+ *   max_readers      Largest reader count; runs 1, 2, 4, ... (default 2 * portNUM_PROCESSORS)
+ *   duration_ms      Measurement window per configuration (default 300)
+ *   write_period_us  Busy wait between writer updates, 0 writes back to back (default 100)
+ *
+ * One writer task publishes a 32-byte sensor snapshot while readers copy it
+ * in a loop, either under a MutexGuard or through SeqLocked::read(). Reports
+ * reads/sec and the writer's updates/sec for both, showing how much the
+ * mutex costs readers and how much readers slow the writer down.
+ */
+
+#include "BenchUtil.h"
+
+#include <atomic>
+#include <vector>
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "MutexGuard.h"
+#include "SeqLock.h"
+
+namespace {
+
+struct SensorSnapshot {
+    float accel[3];
+    float gyro[3];
+    uint32_t timestampUs;
+    uint32_t sequence;
+};
+
+struct Context {
+    bool useSeqLock;
+    SemaphoreHandle_t mutex;
+    SensorSnapshot guarded;  ///< Protected by mutex
+    SeqLocked<SensorSnapshot> seq;
+    uint32_t writePeriodUs;
+    SemaphoreHandle_t start;
+    SemaphoreHandle_t done;
+    std::atomic<bool> stop;
+    std::atomic<uint32_t> reads;
+    std::atomic<uint32_t> writes;
+};
+
+void spinFor(uint32_t ns) {
+    int64_t end = bench::nowNs() + ns;
+    while (bench::nowNs() < end) {
+    }
+}
+
+void readerTask(void* param) {
+    Context* ctx = static_cast<Context*>(param);
+    uint32_t reads = 0;
+
+    xSemaphoreTake(ctx->start, portMAX_DELAY);
+    while (!ctx->stop.load(std::memory_order_relaxed)) {
+        SensorSnapshot copy;
+        if (ctx->useSeqLock) {
+            copy = ctx->seq.read();
+        } else {
+            MutexGuard lock(ctx->mutex, portMAX_DELAY);
+            copy = ctx->guarded;
+        }
+        bench::doNotOptimize(copy);
+        reads++;
+
+        // Give same-priority peers a chance on single-core targets
+        if ((reads & 0xff) == 0) {
+            taskYIELD();
+        }
+    }
+
+    ctx->reads.fetch_add(reads, std::memory_order_relaxed);
+    xSemaphoreGive(ctx->done);
+    vTaskDelete(NULL);
+}
+
+void writerTask(void* param) {
+    Context* ctx = static_cast<Context*>(param);
+    uint32_t writes = 0;
+    SensorSnapshot next = {};
+
+    xSemaphoreTake(ctx->start, portMAX_DELAY);
+    while (!ctx->stop.load(std::memory_order_relaxed)) {
+        next.sequence = writes;
+        next.timestampUs = (uint32_t)(bench::nowNs() / 1000);
+        next.accel[0] = (float)writes;
+        if (ctx->useSeqLock) {
+            ctx->seq.write(next);
+        } else {
+            MutexGuard lock(ctx->mutex, portMAX_DELAY);
+            ctx->guarded = next;
+        }
+        writes++;
+
+        if (ctx->writePeriodUs > 0) {
+            spinFor(ctx->writePeriodUs * 1000);
+        }
+        if ((writes & 0xff) == 0) {
+            taskYIELD();
+        }
+    }
+
+    ctx->writes.store(writes, std::memory_order_relaxed);
+    xSemaphoreGive(ctx->done);
+    vTaskDelete(NULL);
+}
+
+void runConfiguration(bench::JsonReport& json, bool useSeqLock, uint32_t readers,
+                      uint32_t durationMs, uint32_t writePeriodUs) {
+    const uint32_t tasks = readers + 1;
+
+    Context* ctx = new Context();
+    ctx->useSeqLock = useSeqLock;
+    ctx->mutex = xSemaphoreCreateMutex();
+    ctx->guarded = SensorSnapshot();
+    ctx->writePeriodUs = writePeriodUs;
+    ctx->start = xSemaphoreCreateCounting(tasks, 0);
+    ctx->done = xSemaphoreCreateCounting(tasks, 0);
+    ctx->stop.store(false);
+    ctx->reads.store(0);
+    ctx->writes.store(0);
+
+    // Writer on core 0, readers spread over all cores
+    xTaskCreatePinnedToCore(writerTask, "writer", 4096, ctx, 1, nullptr, 0);
+    for (uint32_t i = 0; i < readers; i++) {
+        xTaskCreatePinnedToCore(readerTask, "reader", 4096, ctx, 1, nullptr,
+                                (BaseType_t)((i + 1) % portNUM_PROCESSORS));
+    }
+
+    int64_t begin = bench::nowNs();
+    for (uint32_t i = 0; i < tasks; i++) {
+        xSemaphoreGive(ctx->start);
+    }
+    vTaskDelay(pdMS_TO_TICKS(durationMs));
+    ctx->stop.store(true, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < tasks; i++) {
+        xSemaphoreTake(ctx->done, portMAX_DELAY);
+    }
+    double seconds = (double)(bench::nowNs() - begin) / 1e9;
+
+    json.beginResult();
+    json.field("guard", useSeqLock ? "seqlock" : "mutex_guard");
+    json.field("readers", readers);
+    json.field("reads_per_sec", seconds > 0.0 ? (double)ctx->reads.load() / seconds : 0.0);
+    json.field("writes_per_sec", seconds > 0.0 ? (double)ctx->writes.load() / seconds : 0.0);
+    json.endResult();
+
+    vSemaphoreDelete(ctx->mutex);
+    vSemaphoreDelete(ctx->start);
+    vSemaphoreDelete(ctx->done);
+    delete ctx;
+}
+
+int runSeqLockBench(int argc, char** argv) {
+    const uint32_t maxReaders = bench::argU32(argc, argv, 1, 2 * portNUM_PROCESSORS);
+    const uint32_t durationMs = bench::argU32(argc, argv, 2, 300);
+    // 0 is a meaningful value here (back-to-back writes), so argU32's fallback is not used
+    const uint32_t writePeriodUs = argc > 3 ? (uint32_t)strtoul(argv[3], nullptr, 10) : 100;
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+
+    bench::JsonReport json("seqlock");
+    json.meta("duration_ms", durationMs);
+    json.meta("write_period_us", writePeriodUs);
+    json.meta("snapshot_bytes", (uint32_t)sizeof(SensorSnapshot));
+
+    for (uint32_t readers = 1; readers <= maxReaders; readers *= 2) {
+        runConfiguration(json, false, readers, durationMs, writePeriodUs);
+        runConfiguration(json, true, readers, durationMs, writePeriodUs);
+    }
+
+    json.finish();
+    return 0;
+}
+
+} // namespace
+
+BENCH_MAIN(runSeqLockBench)
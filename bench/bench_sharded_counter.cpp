@@ -0,0 +1,176 @@
+/**
+ * @file bench_sharded_counter.cpp
+ * @brief Increment throughput of ShardedCounter vs a MutexGuard-protected counter
+ *
+ * Usage (host): bench_sharded_counter [max_tasks] [duration_ms]
+ *   max_tasks    Largest task count; runs 1, 2, 4, ... (default 8)
+ *   duration_ms  Measurement window per configuration (default 300)
+ *
+ * Tasks spread over all cores increment one shared counter as fast as they
+ * can. `mutex_counter` is the counter from test_concurrent_increment and the
+ * README's ThreadSafeCounter: a MutexGuard around every increment (without
+ * the test's vTaskDelay). `atomic_counter` is a single std::atomic, which
+ * needs no lock but makes every core write the same cache line.
+ * `sharded_counter` is ShardedCounter with one padded slot per core. Each row
+ * reports increments/sec, the speedup over the mutex counter at the same task
+ * count, and whether the final value matched the increments done.
+ */
+
+#include "BenchUtil.h"
+
+#include <atomic>
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "MutexGuard.h"
+#include "ShardedCounter.h"
+
+namespace {
+
+const uint32_t kBatch = 64;  ///< Increments between two checks of the stop flag
+
+enum Mode {
+    kMutexCounter,
+    kAtomicCounter,
+    kShardedCounter
+};
+
+const char* modeName(Mode mode) {
+    switch (mode) {
+        case kMutexCounter: return "mutex_counter";
+        case kAtomicCounter: return "atomic_counter";
+        case kShardedCounter: return "sharded_counter";
+    }
+    return "?";
+}
+
+// Static so the cache-line alignment holds (C++11 new ignores it)
+ShardedCounter<uint32_t> shardedCounter;
+std::atomic<uint32_t> atomicCounter(0);
+uint32_t mutexCounter = 0;
+
+struct Context {
+    Mode mode;
+    SemaphoreHandle_t mutex;
+    SemaphoreHandle_t start;
+    SemaphoreHandle_t done;
+    std::atomic<bool> stop;
+    std::atomic<uint32_t> increments;
+};
+
+void incrementTask(void* param) {
+    Context* ctx = static_cast<Context*>(param);
+    uint32_t increments = 0;
+
+    xSemaphoreTake(ctx->start, portMAX_DELAY);
+    while (!ctx->stop.load(std::memory_order_relaxed)) {
+        for (uint32_t i = 0; i < kBatch; i++) {
+            switch (ctx->mode) {
+                case kMutexCounter: {
+                    MutexGuard lock(ctx->mutex, portMAX_DELAY);
+                    mutexCounter++;
+                    break;
+                }
+                case kAtomicCounter:
+                    atomicCounter.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                case kShardedCounter:
+                    shardedCounter.increment();
+                    break;
+            }
+        }
+        increments += kBatch;
+        // Give same-priority peers a chance on single-core targets
+        if ((increments & 0x3fff) == 0) {
+            taskYIELD();
+        }
+    }
+
+    ctx->increments.fetch_add(increments, std::memory_order_relaxed);
+    xSemaphoreGive(ctx->done);
+    vTaskDelete(NULL);
+}
+
+uint32_t counterValue(Mode mode) {
+    switch (mode) {
+        case kMutexCounter: return mutexCounter;
+        case kAtomicCounter: return atomicCounter.load();
+        case kShardedCounter: return shardedCounter.value();
+    }
+    return 0;
+}
+
+double runConfiguration(bench::JsonReport& json, Mode mode, uint32_t tasks, uint32_t durationMs,
+                        double mutexPerSec) {
+    mutexCounter = 0;
+    atomicCounter.store(0);
+    shardedCounter.reset();
+
+    Context* ctx = new Context();
+    ctx->mode = mode;
+    ctx->mutex = xSemaphoreCreateMutex();
+    ctx->start = xSemaphoreCreateCounting(tasks, 0);
+    ctx->done = xSemaphoreCreateCounting(tasks, 0);
+    ctx->stop.store(false);
+    ctx->increments.store(0);
+
+    for (uint32_t i = 0; i < tasks; i++) {
+        xTaskCreatePinnedToCore(incrementTask, "counter", 4096, ctx, 1, nullptr,
+                                (BaseType_t)(i % portNUM_PROCESSORS));
+    }
+
+    int64_t begin = bench::nowNs();
+    for (uint32_t i = 0; i < tasks; i++) {
+        xSemaphoreGive(ctx->start);
+    }
+    vTaskDelay(pdMS_TO_TICKS(durationMs));
+    ctx->stop.store(true, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < tasks; i++) {
+        xSemaphoreTake(ctx->done, portMAX_DELAY);
+    }
+    double seconds = (double)(bench::nowNs() - begin) / 1e9;
+    uint32_t increments = ctx->increments.load();
+    double perSec = seconds > 0.0 ? (double)increments / seconds : 0.0;
+
+    json.beginResult();
+    json.field("counter", modeName(mode));
+    json.field("tasks", tasks);
+    json.field("increments_per_sec", perSec);
+    if (mode != kMutexCounter) {
+        json.field("speedup", mutexPerSec > 0.0 ? perSec / mutexPerSec : 0.0);
+    }
+    json.field("exact", (uint32_t)(counterValue(mode) == increments));
+    json.endResult();
+
+    vSemaphoreDelete(ctx->mutex);
+    vSemaphoreDelete(ctx->start);
+    vSemaphoreDelete(ctx->done);
+    delete ctx;
+    return perSec;
+}
+
+int runShardedCounterBench(int argc, char** argv) {
+    const uint32_t maxTasks = bench::argU32(argc, argv, 1, 8);
+    const uint32_t durationMs = bench::argU32(argc, argv, 2, 300);
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+
+    bench::JsonReport json("sharded_counter");
+    json.meta("duration_ms", durationMs);
+    json.meta("shards", (uint32_t)shardedCounter.shards());
+
+    for (uint32_t tasks = 1; tasks <= maxTasks; tasks *= 2) {
+        double mutexPerSec = runConfiguration(json, kMutexCounter, tasks, durationMs, 0.0);
+        runConfiguration(json, kAtomicCounter, tasks, durationMs, mutexPerSec);
+        runConfiguration(json, kShardedCounter, tasks, durationMs, mutexPerSec);
+    }
+
+    json.finish();
+    return 0;
+}
+
+} // namespace
+
+BENCH_MAIN(runShardedCounterBench)
@@ -0,0 +1,204 @@
+/**
+ * @file bench_spinlock_vs_mutex.cpp
+ * @brief SpinlockGuard vs MutexGuard cost for short critical sections
+ *
+ * Usage (host): bench_spinlock_vs_mutex [iterations] [duration_ms] [max_tasks] [work_list]
+ *   iterations  Loop count for the uncontended cases (default 200000)
+ *   duration_ms Measurement window per contended configuration (default 300)
+ *   max_tasks   Largest task count; runs 1, 2, 4, ... up to it (default portNUM_PROCESSORS)
+ *   work_list   Comma separated critical-section lengths in loop iterations
+ *               of a volatile increment (default 1,10,100,1000)
+ *
+ * The uncontended cases time one lock/unlock pair per guard type. The
+ * contended cases run the same loop on several tasks, one per core where
+ * possible, and report throughput of both guards for each critical-section
+ * length; spinlock_speedup above 1 is where SpinlockGuard wins.
+ */
+
+#include "BenchUtil.h"
+
+#include <string.h>
+
+#include <atomic>
+#include <vector>
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "MutexGuard.h"
+#include "SpinlockGuard.h"
+
+namespace {
+
+const size_t kMaxWorkLengths = 8;
+
+portMUX_TYPE g_spinlock = portMUX_INITIALIZER_UNLOCKED;
+SemaphoreHandle_t g_mutex = nullptr;
+volatile uint32_t g_shared = 0;
+
+enum GuardKind { kSpinlock, kMutex };
+
+struct WorkerContext {
+    GuardKind kind;
+    uint32_t work;
+    SemaphoreHandle_t start;
+    SemaphoreHandle_t done;
+    std::atomic<bool>* stop;
+    uint32_t ops;
+};
+
+inline void doWork(uint32_t work) {
+    for (uint32_t i = 0; i < work; i++) {
+        g_shared = g_shared + 1;
+    }
+}
+
+void workerTask(void* param) {
+    WorkerContext* ctx = static_cast<WorkerContext*>(param);
+
+    xSemaphoreTake(ctx->start, portMAX_DELAY);
+
+    while (!ctx->stop->load(std::memory_order_relaxed)) {
+        if (ctx->kind == kSpinlock) {
+            SpinlockGuard lock(&g_spinlock);
+            doWork(ctx->work);
+        } else {
+            MutexGuard lock(g_mutex, portMAX_DELAY);
+            doWork(ctx->work);
+        }
+        ctx->ops++;
+
+        // Give same-priority peers a chance on single-core targets
+        if ((ctx->ops & 0xff) == 0) {
+            taskYIELD();
+        }
+    }
+
+    xSemaphoreGive(ctx->done);
+    vTaskDelete(NULL);
+}
+
+double runContended(GuardKind kind, uint32_t tasks, uint32_t work, uint32_t durationMs) {
+    SemaphoreHandle_t start = xSemaphoreCreateCounting(tasks, 0);
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(tasks, 0);
+    std::atomic<bool> stop(false);
+
+    std::vector<WorkerContext> contexts(tasks);
+    for (uint32_t i = 0; i < tasks; i++) {
+        WorkerContext& ctx = contexts[i];
+        ctx.kind = kind;
+        ctx.work = work;
+        ctx.start = start;
+        ctx.done = done;
+        ctx.stop = &stop;
+        ctx.ops = 0;
+        xTaskCreatePinnedToCore(workerTask, "bench", 4096, &ctx, 1, nullptr,
+                                (BaseType_t)(i % portNUM_PROCESSORS));
+    }
+
+    int64_t begin = bench::nowNs();
+    for (uint32_t i = 0; i < tasks; i++) {
+        xSemaphoreGive(start);
+    }
+    vTaskDelay(pdMS_TO_TICKS(durationMs));
+    stop.store(true, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < tasks; i++) {
+        xSemaphoreTake(done, portMAX_DELAY);
+    }
+    int64_t elapsed = bench::nowNs() - begin;
+
+    uint64_t ops = 0;
+    for (uint32_t i = 0; i < tasks; i++) {
+        ops += contexts[i].ops;
+    }
+
+    vSemaphoreDelete(start);
+    vSemaphoreDelete(done);
+    return elapsed > 0 ? (double)ops * 1e9 / (double)elapsed : 0.0;
+}
+
+size_t parseList(const char* text, uint32_t* out, size_t capacity) {
+    size_t count = 0;
+    while (text != nullptr && *text != '\0' && count < capacity) {
+        char* end = nullptr;
+        out[count++] = (uint32_t)strtoul(text, &end, 10);
+        if (end == text) {
+            break;
+        }
+        text = (*end == ',') ? end + 1 : end;
+    }
+    return count;
+}
+
+int runSpinlockVsMutex(int argc, char** argv) {
+    const uint32_t iterations = bench::argU32(argc, argv, 1, 200000);
+    const uint32_t durationMs = bench::argU32(argc, argv, 2, 300);
+    const uint32_t maxTasks = bench::argU32(argc, argv, 3, portNUM_PROCESSORS);
+    uint32_t workLengths[kMaxWorkLengths] = {1, 10, 100, 1000};
+    size_t workCount = 4;
+    if (argc > 4) {
+        workCount = parseList(argv[4], workLengths, kMaxWorkLengths);
+    }
+
+    g_mutex = xSemaphoreCreateMutex();
+    esp_log_level_set("*", ESP_LOG_NONE);
+
+    bench::JsonReport json("spinlock_vs_mutex");
+    json.meta("iterations", iterations);
+    json.meta("duration_ms", durationMs);
+
+    // --- Uncontended lock/unlock pair ------------------------------------
+
+    double mutexNs = bench::measureNsPerOp(iterations, [] {
+        MutexGuard lock(g_mutex);
+        bench::doNotOptimize(lock.hasLock());
+    });
+    double rawNs = bench::measureNsPerOp(iterations, [] {
+        portENTER_CRITICAL(&g_spinlock);
+        portEXIT_CRITICAL(&g_spinlock);
+    });
+    double spinNs = bench::measureNsPerOp(iterations, [] {
+        SpinlockGuard lock(&g_spinlock);
+        bench::doNotOptimize(lock.hasLock());
+    });
+    double spinIsrNs = bench::measureNsPerOp(iterations, [] {
+        SpinlockGuardISR lock(&g_spinlock);
+        bench::doNotOptimize(lock.hasLock());
+    });
+
+    const char* names[] = {"mutex_guard", "raw_critical", "spinlock_guard", "spinlock_guard_isr"};
+    const double values[] = {mutexNs, rawNs, spinNs, spinIsrNs};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        json.beginResult();
+        json.field("name", names[i]);
+        json.field("ns_per_op", values[i]);
+        json.field("vs_mutex", mutexNs > 0.0 ? values[i] / mutexNs : 0.0);
+        json.endResult();
+    }
+
+    // --- Contended throughput --------------------------------------------
+
+    for (size_t w = 0; w < workCount; w++) {
+        for (uint32_t tasks = 1; tasks <= maxTasks; tasks *= 2) {
+            double spinOps = runContended(kSpinlock, tasks, workLengths[w], durationMs);
+            double mutexOps = runContended(kMutex, tasks, workLengths[w], durationMs);
+            json.beginResult();
+            json.field("name", "contended");
+            json.field("tasks", tasks);
+            json.field("cs_work", workLengths[w]);
+            json.field("spinlock_ops_per_sec", spinOps);
+            json.field("mutex_ops_per_sec", mutexOps);
+            json.field("spinlock_speedup", mutexOps > 0.0 ? spinOps / mutexOps : 0.0);
+            json.endResult();
+        }
+    }
+
+    json.finish();
+    vSemaphoreDelete(g_mutex);
+    return 0;
+}
+
+} // namespace
+
+BENCH_MAIN(runSpinlockVsMutex)
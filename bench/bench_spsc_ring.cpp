@@ -0,0 +1,251 @@
+/**
+ * @file bench_spsc_ring.cpp
+ * @brief Producer-to-consumer throughput of SpscRing vs a MutexGuard-protected buffer
+ *
+ * Usage (host): bench_spsc_ring [items] [batch]
+ *   items  Elements sent from the producer to the consumer (default 200000)
+ *   batch  Elements per pushN()/popN() call in the bulk case (default 16)
+ *
+ * A producer task on core 0 streams uint32_t values to a consumer task on
+ * core 1 through a 64-slot buffer. Compared: the ThreadSafeBuffer pattern
+ * from examples/basic_usage.cpp (a MutexGuard around every push and pop),
+ * SpscRing with single-element and bulk calls (retrying with taskYIELD()
+ * when full or empty), and BlockingSpscRing, which sleeps on a task
+ * notification instead. Reports items/sec and ns per item.
+ */
+
+#include "BenchUtil.h"
+
+#include <atomic>
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "MutexGuard.h"
+#include "SpscRing.h"
+
+namespace {
+
+const size_t kCapacity = 64;
+const uint32_t kMaxBatch = 64;
+
+enum Mode {
+    kMutexBuffer,
+    kSpscRing,
+    kSpscRingBulk,
+    kBlockingSpscRing
+};
+
+const char* modeName(Mode mode) {
+    switch (mode) {
+        case kMutexBuffer: return "mutex_buffer";
+        case kSpscRing: return "spsc_ring";
+        case kSpscRingBulk: return "spsc_ring_bulk";
+        case kBlockingSpscRing: return "blocking_spsc_ring";
+    }
+    return "?";
+}
+
+/**
+ * @brief The ThreadSafeBuffer from the examples, sized like the rings
+ */
+class MutexBuffer {
+public:
+    MutexBuffer() : m_writeIndex(0), m_readIndex(0), m_count(0), m_mutex(xSemaphoreCreateMutex()) {}
+    ~MutexBuffer() { vSemaphoreDelete(m_mutex); }
+
+    bool push(uint32_t value) {
+        MutexGuard lock(m_mutex, portMAX_DELAY);
+        if (m_count >= kCapacity) {
+            return false;
+        }
+        m_buffer[m_writeIndex] = value;
+        m_writeIndex = (m_writeIndex + 1) % kCapacity;
+        m_count++;
+        return true;
+    }
+
+    bool pop(uint32_t& value) {
+        MutexGuard lock(m_mutex, portMAX_DELAY);
+        if (m_count == 0) {
+            return false;
+        }
+        value = m_buffer[m_readIndex];
+        m_readIndex = (m_readIndex + 1) % kCapacity;
+        m_count--;
+        return true;
+    }
+
+private:
+    uint32_t m_buffer[kCapacity];
+    size_t m_writeIndex;
+    size_t m_readIndex;
+    size_t m_count;
+    SemaphoreHandle_t m_mutex;
+};
+
+// Static so the cache-line alignment holds (C++11 new ignores it)
+MutexBuffer* mutexBuffer = nullptr;
+SpscRing<uint32_t, kCapacity> spscRing;
+BlockingSpscRing<uint32_t, kCapacity> blockingRing;
+
+struct Context {
+    Mode mode;
+    uint32_t items;
+    uint32_t batch;
+    SemaphoreHandle_t start;
+    SemaphoreHandle_t done;
+    uint32_t checksum;  ///< Sum of received values, checked against the sent ones
+};
+
+void producerTask(void* param) {
+    Context* ctx = static_cast<Context*>(param);
+    uint32_t batch[kMaxBatch];
+
+    xSemaphoreTake(ctx->start, portMAX_DELAY);
+    for (uint32_t i = 0; i < ctx->items;) {
+        switch (ctx->mode) {
+            case kMutexBuffer:
+                if (mutexBuffer->push(i)) {
+                    i++;
+                } else {
+                    taskYIELD();
+                }
+                break;
+            case kSpscRing:
+                if (spscRing.push(i)) {
+                    i++;
+                } else {
+                    taskYIELD();
+                }
+                break;
+            case kSpscRingBulk: {
+                uint32_t n = ctx->items - i < ctx->batch ? ctx->items - i : ctx->batch;
+                for (uint32_t j = 0; j < n; j++) {
+                    batch[j] = i + j;
+                }
+                uint32_t sent = 0;
+                while (sent < n) {
+                    size_t pushed = spscRing.pushN(batch + sent, n - sent);
+                    if (pushed == 0) {
+                        taskYIELD();
+                    }
+                    sent += pushed;
+                }
+                i += n;
+                break;
+            }
+            case kBlockingSpscRing:
+                blockingRing.push(i, portMAX_DELAY);
+                i++;
+                break;
+        }
+    }
+
+    xSemaphoreGive(ctx->done);
+    vTaskDelete(NULL);
+}
+
+void consumerTask(void* param) {
+    Context* ctx = static_cast<Context*>(param);
+    uint32_t batch[kMaxBatch];
+    uint32_t checksum = 0;
+
+    xSemaphoreTake(ctx->start, portMAX_DELAY);
+    for (uint32_t received = 0; received < ctx->items;) {
+        size_t n = 0;
+        switch (ctx->mode) {
+            case kMutexBuffer:
+                n = mutexBuffer->pop(batch[0]) ? 1 : 0;
+                break;
+            case kSpscRing:
+                n = spscRing.pop(batch[0]) ? 1 : 0;
+                break;
+            case kSpscRingBulk:
+                n = spscRing.popN(batch, ctx->batch);
+                break;
+            case kBlockingSpscRing:
+                n = blockingRing.pop(batch[0], portMAX_DELAY) ? 1 : 0;
+                break;
+        }
+        if (n == 0) {
+            taskYIELD();
+        }
+        for (size_t j = 0; j < n; j++) {
+            checksum += batch[j];
+        }
+        received += n;
+    }
+
+    ctx->checksum = checksum;
+    xSemaphoreGive(ctx->done);
+    vTaskDelete(NULL);
+}
+
+void runMode(bench::JsonReport& json, Mode mode, uint32_t items, uint32_t batch) {
+    Context ctx;
+    ctx.mode = mode;
+    ctx.items = items;
+    ctx.batch = batch;
+    ctx.start = xSemaphoreCreateCounting(2, 0);
+    ctx.done = xSemaphoreCreateCounting(2, 0);
+    ctx.checksum = 0;
+    if (mode == kMutexBuffer) {
+        mutexBuffer = new MutexBuffer();
+    }
+
+    xTaskCreatePinnedToCore(producerTask, "producer", 4096, &ctx, 1, nullptr, 0);
+    xTaskCreatePinnedToCore(consumerTask, "consumer", 4096, &ctx, 1, nullptr, 1 % portNUM_PROCESSORS);
+
+    int64_t begin = bench::nowNs();
+    xSemaphoreGive(ctx.start);
+    xSemaphoreGive(ctx.start);
+    xSemaphoreTake(ctx.done, portMAX_DELAY);
+    xSemaphoreTake(ctx.done, portMAX_DELAY);
+    int64_t elapsedNs = bench::nowNs() - begin;
+
+    uint32_t expected = 0;
+    for (uint32_t i = 0; i < items; i++) {
+        expected += i;
+    }
+
+    json.beginResult();
+    json.field("buffer", modeName(mode));
+    json.field("batch", mode == kSpscRingBulk ? batch : 1u);
+    json.field("items_per_sec", elapsedNs > 0 ? (double)items * 1e9 / (double)elapsedNs : 0.0);
+    json.field("ns_per_item", (double)elapsedNs / (double)items);
+    json.field("checksum_ok", ctx.checksum == expected ? "yes" : "no");
+    json.endResult();
+
+    delete mutexBuffer;
+    mutexBuffer = nullptr;
+    vSemaphoreDelete(ctx.start);
+    vSemaphoreDelete(ctx.done);
+}
+
+int runSpscRingBench(int argc, char** argv) {
+    const uint32_t items = bench::argU32(argc, argv, 1, 200000);
+    uint32_t batch = bench::argU32(argc, argv, 2, 16);
+    if (batch > kMaxBatch) {
+        batch = kMaxBatch;
+    }
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+
+    bench::JsonReport json("spsc_ring");
+    json.meta("items", items);
+    json.meta("capacity", (uint32_t)kCapacity);
+
+    runMode(json, kMutexBuffer, items, batch);
+    runMode(json, kSpscRing, items, batch);
+    runMode(json, kSpscRingBulk, items, batch);
+    runMode(json, kBlockingSpscRing, items, batch);
+
+    json.finish();
+    return 0;
+}
+
+} // namespace
+
+BENCH_MAIN(runSpscRingBench)
@@ -0,0 +1,38 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/**
+ * @file Arduino.h
+ * @brief Minimal Arduino-ESP32 core shim so test sketches build on a host
+ *
+ * Provides the timing helpers and the Serial object the sketches in test/
+ * and examples/ use. Like the real ESP32 core, it pulls in the FreeRTOS
+ * headers.
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void yield();
+
+class HostSerial {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    size_t print(const char* s) { return (size_t)fputs(s, stdout); }
+    size_t println(const char* s = "") { return (size_t)printf("%s\n", s); }
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    void flush() { fflush(stdout); }
+};
+
+extern HostSerial Serial;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,53 @@
+#ifndef HOST_ESP_LOG_H
+#define HOST_ESP_LOG_H
+
+/**
+ * @file esp_log.h
+ * @brief Minimal ESP-IDF logging shim for host builds
+ *
+ * Messages are written to stderr in the ESP-IDF "L (timestamp) tag: msg"
+ * layout. The runtime level defaults to ESP_LOG_INFO and can be changed
+ * with esp_log_level_set() and read with esp_log_level_get() (the tag
+ * argument is ignored).
+ */
+
+#include <stdint.h>
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void esp_log_level_set(const char* tag, esp_log_level_t level);
+esp_log_level_t esp_log_level_get(const char* tag);
+uint32_t esp_log_timestamp(void);
+void esp_log_write(esp_log_level_t level, const char* tag, const char* format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+#ifdef __cplusplus
+}
+#endif
+
+#define ESP_LOG_LEVEL(level, tag, format, ...) do {                                         \
+        if ((level) == ESP_LOG_ERROR)        { esp_log_write(ESP_LOG_ERROR, tag, "E (%u) %s: " format "\n", (unsigned)esp_log_timestamp(), tag, ##__VA_ARGS__); } \
+        else if ((level) == ESP_LOG_WARN)    { esp_log_write(ESP_LOG_WARN, tag, "W (%u) %s: " format "\n", (unsigned)esp_log_timestamp(), tag, ##__VA_ARGS__); } \
+        else if ((level) == ESP_LOG_INFO)    { esp_log_write(ESP_LOG_INFO, tag, "I (%u) %s: " format "\n", (unsigned)esp_log_timestamp(), tag, ##__VA_ARGS__); } \
+        else if ((level) == ESP_LOG_DEBUG)   { esp_log_write(ESP_LOG_DEBUG, tag, "D (%u) %s: " format "\n", (unsigned)esp_log_timestamp(), tag, ##__VA_ARGS__); } \
+        else if ((level) == ESP_LOG_VERBOSE) { esp_log_write(ESP_LOG_VERBOSE, tag, "V (%u) %s: " format "\n", (unsigned)esp_log_timestamp(), tag, ##__VA_ARGS__); } \
+    } while (0)
+
+#define ESP_LOGE(tag, format, ...) ESP_LOG_LEVEL(ESP_LOG_ERROR, tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) ESP_LOG_LEVEL(ESP_LOG_WARN, tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) ESP_LOG_LEVEL(ESP_LOG_INFO, tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) ESP_LOG_LEVEL(ESP_LOG_DEBUG, tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) ESP_LOG_LEVEL(ESP_LOG_VERBOSE, tag, format, ##__VA_ARGS__)
+
+#endif // HOST_ESP_LOG_H
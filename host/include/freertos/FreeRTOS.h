@@ -0,0 +1,98 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+/**
+ * @file FreeRTOS.h
+ * @brief Minimal FreeRTOS API shim for building the library on a Linux host
+ *
+ * Only the subset of the kernel API used by this library, its tests and its
+ * benchmarks is provided. Tasks map onto std::thread, semaphores onto
+ * std::mutex/std::condition_variable and ticks onto milliseconds of
+ * std::chrono::steady_clock. Scheduling semantics (priorities, priority
+ * inheritance, core pinning) are not emulated.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdFAIL pdFALSE
+#define pdPASS pdTRUE
+
+#define configTICK_RATE_HZ 1000
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+
+#ifndef pdMS_TO_TICKS
+#define pdMS_TO_TICKS(xTimeInMs) \
+    ((TickType_t)(((TickType_t)(xTimeInMs) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000U))
+#endif
+
+// The ESP32 targets this library ships for are dual-core
+#ifndef portNUM_PROCESSORS
+#define portNUM_PROCESSORS 2
+#endif
+
+#define configASSERT(x) ((x) ? (void)0 : vHostAssertFailed(__FILE__, __LINE__))
+
+/**
+ * @brief ESP-IDF style critical-section spinlock
+ *
+ * Recursive for the owning thread, like the ESP-IDF port. On the host it
+ * only spins; it cannot mask interrupts or suspend preemption.
+ */
+typedef struct {
+    uintptr_t owner;  ///< Owning thread token, 0 when free
+    uint32_t count;   ///< Recursion depth
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0, 0}
+#define portMUX_INITIALIZE(mux) do { (mux)->owner = 0; (mux)->count = 0; } while (0)
+
+#define portENTER_CRITICAL(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux) vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux) vPortExitCritical(mux)
+#define taskENTER_CRITICAL(mux) vPortEnterCritical(mux)
+#define taskEXIT_CRITICAL(mux) vPortExitCritical(mux)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void vHostAssertFailed(const char* file, int line);
+
+void vPortEnterCritical(portMUX_TYPE* mux);
+void vPortExitCritical(portMUX_TYPE* mux);
+
+/**
+ * @brief Host stand-in for the ESP-IDF port's ISR context query
+ *
+ * Always false unless a test explicitly simulates interrupt context on the
+ * calling thread with vHostSetIsrContext().
+ */
+BaseType_t xPortInIsrContext(void);
+
+/**
+ * @brief Host-only helper: mark the calling thread as running in ISR context
+ */
+void vHostSetIsrContext(BaseType_t inIsr);
+
+/**
+ * @brief Host stand-in for the ESP-IDF port's core id query
+ * @return The host CPU the calling thread is running on, folded onto
+ *         portNUM_PROCESSORS
+ */
+BaseType_t xPortGetCoreID(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_FREERTOS_H
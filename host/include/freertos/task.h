@@ -0,0 +1,69 @@
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct tskTaskControlBlock* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define tskNO_AFFINITY ((BaseType_t)0x7fffffff)
+
+/**
+ * @brief Create a task backed by a detached host thread
+ *
+ * Stack depth and priority are recorded but not enforced. A task function
+ * that returns behaves as if it had called vTaskDelete(NULL).
+ */
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode,
+                       const char* pcName,
+                       uint32_t usStackDepth,
+                       void* pvParameters,
+                       UBaseType_t uxPriority,
+                       TaskHandle_t* pxCreatedTask);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode,
+                                   const char* pcName,
+                                   uint32_t usStackDepth,
+                                   void* pvParameters,
+                                   UBaseType_t uxPriority,
+                                   TaskHandle_t* pxCreatedTask,
+                                   BaseType_t xCoreID);
+
+/**
+ * @brief Delete a task
+ *
+ * Only self-deletion (NULL or the caller's own handle) is supported; it
+ * unwinds the calling task's stack and ends its thread.
+ */
+void vTaskDelete(TaskHandle_t xTaskToDelete);
+
+void vTaskDelay(TickType_t xTicksToDelay);
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+char* pcTaskGetName(TaskHandle_t xTaskToQuery);
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask);
+
+/**
+ * @brief Direct-to-task notification, used as a lightweight counting semaphore
+ *
+ * Only the counting form (xTaskNotifyGive/ulTaskNotifyTake) of notification
+ * index 0 is provided. Like on target, the task must still exist.
+ */
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify);
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t* pxHigherPriorityTaskWoken);
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+
+void vHostYield(void);
+
+#define taskYIELD() vHostYield()
+#define portYIELD() vHostYield()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_FREERTOS_TASK_H
@@ -0,0 +1,66 @@
+#ifndef HOST_UNITY_H
+#define HOST_UNITY_H
+
+/**
+ * @file unity.h
+ * @brief Unity-compatible subset for running the test sketches on a host
+ *
+ * Implements the assertions used under test/ with Unity's output format. A
+ * failed assertion aborts the current test by throwing, so RAII guards in
+ * the test body are still released. The host runner calls the sketch's
+ * setup() once and exits with the number of failed tests.
+ */
+
+#include <stdint.h>
+
+void setUp(void);
+void tearDown(void);
+
+void UnityBegin(const char* filename);
+int UnityEnd(void);
+void UnityDefaultTestRun(void (*func)(void), const char* name, int line);
+void UnityFail(const char* message, int line);
+void UnityPass(void);
+void UnityAssertEqualNumber(int64_t expected, int64_t actual, const char* message, int line);
+void UnityAssertCompare(int64_t threshold, int64_t actual, int wantGreater, int orEqual,
+                        const char* message, int line);
+void UnityAssertEqualString(const char* expected, const char* actual, const char* message, int line);
+
+#define UNITY_BEGIN() UnityBegin(__FILE__)
+#define UNITY_END() UnityEnd()
+#define RUN_TEST(func) UnityDefaultTestRun(func, #func, __LINE__)
+
+#define TEST_PASS() UnityPass()
+#define TEST_FAIL() UnityFail("", __LINE__)
+#define TEST_FAIL_MESSAGE(message) UnityFail((message), __LINE__)
+
+#define TEST_ASSERT_TRUE_MESSAGE(condition, message) \
+    do { if (!(condition)) UnityFail((message), __LINE__); } while (0)
+#define TEST_ASSERT_FALSE_MESSAGE(condition, message) \
+    do { if ((condition)) UnityFail((message), __LINE__); } while (0)
+#define TEST_ASSERT_TRUE(condition) TEST_ASSERT_TRUE_MESSAGE((condition), "Expected TRUE Was FALSE")
+#define TEST_ASSERT_FALSE(condition) TEST_ASSERT_FALSE_MESSAGE((condition), "Expected FALSE Was TRUE")
+#define TEST_ASSERT(condition) TEST_ASSERT_TRUE(condition)
+#define TEST_ASSERT_NULL(pointer) TEST_ASSERT_TRUE_MESSAGE((pointer) == NULL, "Expected NULL")
+#define TEST_ASSERT_NOT_NULL(pointer) TEST_ASSERT_TRUE_MESSAGE((pointer) != NULL, "Expected Non-NULL")
+
+#define TEST_ASSERT_EQUAL_MESSAGE(expected, actual, message) \
+    UnityAssertEqualNumber((int64_t)(expected), (int64_t)(actual), (message), __LINE__)
+#define TEST_ASSERT_EQUAL(expected, actual) TEST_ASSERT_EQUAL_MESSAGE(expected, actual, NULL)
+#define TEST_ASSERT_EQUAL_INT(expected, actual) TEST_ASSERT_EQUAL(expected, actual)
+#define TEST_ASSERT_EQUAL_UINT32(expected, actual) TEST_ASSERT_EQUAL(expected, actual)
+#define TEST_ASSERT_EQUAL_PTR(expected, actual) \
+    UnityAssertEqualNumber((int64_t)(intptr_t)(expected), (int64_t)(intptr_t)(actual), NULL, __LINE__)
+#define TEST_ASSERT_EQUAL_STRING(expected, actual) \
+    UnityAssertEqualString((expected), (actual), NULL, __LINE__)
+
+#define TEST_ASSERT_GREATER_THAN(threshold, actual) \
+    UnityAssertCompare((int64_t)(threshold), (int64_t)(actual), 1, 0, NULL, __LINE__)
+#define TEST_ASSERT_GREATER_OR_EQUAL(threshold, actual) \
+    UnityAssertCompare((int64_t)(threshold), (int64_t)(actual), 1, 1, NULL, __LINE__)
+#define TEST_ASSERT_LESS_THAN(threshold, actual) \
+    UnityAssertCompare((int64_t)(threshold), (int64_t)(actual), 0, 0, NULL, __LINE__)
+#define TEST_ASSERT_LESS_OR_EQUAL(threshold, actual) \
+    UnityAssertCompare((int64_t)(threshold), (int64_t)(actual), 0, 1, NULL, __LINE__)
+
+#endif // HOST_UNITY_H
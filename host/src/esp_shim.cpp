@@ -0,0 +1,50 @@
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <atomic>
+#include <chrono>
+
+namespace {
+
+const std::chrono::steady_clock::time_point kStartTime = std::chrono::steady_clock::now();
+
+std::atomic<int> g_logLevel(ESP_LOG_INFO);
+
+} // namespace
+
+extern "C" {
+
+int64_t esp_timer_get_time(void) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - kStartTime).count();
+}
+
+void esp_log_level_set(const char* tag, esp_log_level_t level) {
+    (void)tag;
+    g_logLevel.store(level, std::memory_order_relaxed);
+}
+
+esp_log_level_t esp_log_level_get(const char* tag) {
+    (void)tag;
+    return (esp_log_level_t)g_logLevel.load(std::memory_order_relaxed);
+}
+
+uint32_t esp_log_timestamp(void) {
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+void esp_log_write(esp_log_level_t level, const char* tag, const char* format, ...) {
+    (void)tag;
+    if (level > g_logLevel.load(std::memory_order_relaxed)) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
+
+} // extern "C"
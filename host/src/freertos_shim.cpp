@@ -0,0 +1,372 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const Clock::time_point kStartTime = Clock::now();
+
+thread_local bool t_inIsr = false;
+thread_local TaskHandle_t t_currentTask = nullptr;
+
+// Thrown by vTaskDelete(NULL) to unwind the calling task's stack
+struct TaskExit {};
+
+enum QueueType {
+    kMutex,
+    kRecursiveMutex,
+    kBinary,
+    kCounting
+};
+
+Clock::time_point deadlineFor(TickType_t ticks) {
+    return Clock::now() + std::chrono::milliseconds(ticks * portTICK_PERIOD_MS);
+}
+
+} // namespace
+
+struct tskTaskControlBlock {
+    std::string name;
+    UBaseType_t priority;
+    std::mutex notifyLock;
+    std::condition_variable notified;
+    uint32_t notifyValue = 0;  ///< Notification index 0, used as a counter
+};
+
+struct QueueDefinition {
+    std::mutex lock;
+    std::condition_variable available;
+    QueueType type;
+    UBaseType_t count;
+    UBaseType_t maxCount;
+    TaskHandle_t holder;
+    UBaseType_t recursion;
+    bool staticStorage;  ///< Lives in a StaticSemaphore_t; not freed on delete
+
+    QueueDefinition(QueueType t, UBaseType_t maxCnt, UBaseType_t initial)
+        : type(t), count(initial), maxCount(maxCnt), holder(nullptr), recursion(0),
+          staticStorage(false) {}
+
+    bool isMutex() const { return type == kMutex || type == kRecursiveMutex; }
+
+    // Wait for a unit to become available; caller holds 'lock'
+    bool wait(std::unique_lock<std::mutex>& lk, TickType_t ticks) {
+        if (ticks == 0) {
+            return count > 0;
+        }
+        if (ticks == portMAX_DELAY) {
+            available.wait(lk, [this] { return count > 0; });
+            return true;
+        }
+        return available.wait_until(lk, deadlineFor(ticks), [this] { return count > 0; });
+    }
+};
+
+extern "C" {
+
+void vHostAssertFailed(const char* file, int line) {
+    fprintf(stderr, "configASSERT failed at %s:%d\n", file, line);
+    abort();
+}
+
+void vPortEnterCritical(portMUX_TYPE* mux) {
+    static thread_local char threadToken;
+    uintptr_t self = (uintptr_t)&threadToken;
+    if (__atomic_load_n(&mux->owner, __ATOMIC_RELAXED) == self) {
+        mux->count++;
+        return;
+    }
+    uintptr_t expected = 0;
+    while (!__atomic_compare_exchange_n(&mux->owner, &expected, self, true, __ATOMIC_ACQUIRE,
+                                        __ATOMIC_RELAXED)) {
+        expected = 0;
+        std::this_thread::yield();
+    }
+    mux->count = 1;
+}
+
+void vPortExitCritical(portMUX_TYPE* mux) {
+    if (--mux->count == 0) {
+        __atomic_store_n(&mux->owner, (uintptr_t)0, __ATOMIC_RELEASE);
+    }
+}
+
+BaseType_t xPortInIsrContext(void) {
+    return t_inIsr ? pdTRUE : pdFALSE;
+}
+
+void vHostSetIsrContext(BaseType_t inIsr) {
+    t_inIsr = (inIsr != pdFALSE);
+}
+
+BaseType_t xPortGetCoreID(void) {
+    int cpu = sched_getcpu();
+    return cpu < 0 ? 0 : (BaseType_t)(cpu % portNUM_PROCESSORS);
+}
+
+// ---------------------------------------------------------------------------
+// Tasks
+// ---------------------------------------------------------------------------
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char* pcName, uint32_t usStackDepth,
+                       void* pvParameters, UBaseType_t uxPriority, TaskHandle_t* pxCreatedTask) {
+    return xTaskCreatePinnedToCore(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority,
+                                   pxCreatedTask, tskNO_AFFINITY);
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char* pcName,
+                                   uint32_t usStackDepth, void* pvParameters,
+                                   UBaseType_t uxPriority, TaskHandle_t* pxCreatedTask,
+                                   BaseType_t xCoreID) {
+    (void)usStackDepth;
+    (void)xCoreID;
+
+    TaskHandle_t task = new tskTaskControlBlock();
+    task->name = pcName ? pcName : "";
+    task->priority = uxPriority;
+
+    std::thread([task, pxTaskCode, pvParameters] {
+        t_currentTask = task;
+        try {
+            pxTaskCode(pvParameters);
+        } catch (const TaskExit&) {
+            // vTaskDelete(NULL)
+        }
+        delete task;
+    }).detach();
+
+    if (pxCreatedTask != nullptr) {
+        *pxCreatedTask = task;
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete) {
+    configASSERT(xTaskToDelete == nullptr || xTaskToDelete == xTaskGetCurrentTaskHandle());
+    throw TaskExit();
+}
+
+void vTaskDelay(TickType_t xTicksToDelay) {
+    if (xTicksToDelay == 0) {
+        std::this_thread::yield();
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(xTicksToDelay * portTICK_PERIOD_MS));
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)(std::chrono::duration_cast<std::chrono::milliseconds>(
+        Clock::now() - kStartTime).count() / portTICK_PERIOD_MS);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    if (t_currentTask == nullptr) {
+        // Threads not created through xTaskCreate (e.g. main) are adopted
+        // as tasks on first use; their control block lives until exit.
+        static thread_local tskTaskControlBlock adopted;
+        adopted.name = "main";
+        adopted.priority = 1;
+        t_currentTask = &adopted;
+    }
+    return t_currentTask;
+}
+
+char* pcTaskGetName(TaskHandle_t xTaskToQuery) {
+    TaskHandle_t task = xTaskToQuery ? xTaskToQuery : xTaskGetCurrentTaskHandle();
+    return &task->name[0];
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask) {
+    TaskHandle_t task = xTask ? xTask : xTaskGetCurrentTaskHandle();
+    return task->priority;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify) {
+    configASSERT(xTaskToNotify != nullptr);
+    {
+        std::lock_guard<std::mutex> lk(xTaskToNotify->notifyLock);
+        xTaskToNotify->notifyValue++;
+    }
+    xTaskToNotify->notified.notify_one();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t* pxHigherPriorityTaskWoken) {
+    xTaskNotifyGive(xTaskToNotify);
+    if (pxHigherPriorityTaskWoken != nullptr) {
+        *pxHigherPriorityTaskWoken = pdFALSE;  // No priorities on the host
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lk(self->notifyLock);
+    auto pending = [self] { return self->notifyValue > 0; };
+    if (xTicksToWait == portMAX_DELAY) {
+        self->notified.wait(lk, pending);
+    } else if (xTicksToWait > 0) {
+        self->notified.wait_until(lk, deadlineFor(xTicksToWait), pending);
+    }
+
+    uint32_t value = self->notifyValue;
+    if (value > 0) {
+        self->notifyValue = xClearCountOnExit != pdFALSE ? 0 : value - 1;
+    }
+    return value;
+}
+
+void vHostYield(void) {
+    std::this_thread::yield();
+}
+
+// ---------------------------------------------------------------------------
+// Semaphores
+// ---------------------------------------------------------------------------
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return new QueueDefinition(kMutex, 1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void) {
+    return new QueueDefinition(kRecursiveMutex, 1, 1);
+}
+
+static_assert(sizeof(QueueDefinition) <= sizeof(StaticSemaphore_t),
+              "StaticSemaphore_t too small for the shim's semaphore");
+static_assert(alignof(QueueDefinition) <= alignof(StaticSemaphore_t),
+              "StaticSemaphore_t under-aligned for the shim's semaphore");
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* pxMutexBuffer) {
+    configASSERT(pxMutexBuffer != nullptr);
+    QueueDefinition* queue = new (pxMutexBuffer) QueueDefinition(kMutex, 1, 1);
+    queue->staticStorage = true;
+    return queue;
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutexStatic(StaticSemaphore_t* pxMutexBuffer) {
+    configASSERT(pxMutexBuffer != nullptr);
+    QueueDefinition* queue = new (pxMutexBuffer) QueueDefinition(kRecursiveMutex, 1, 1);
+    queue->staticStorage = true;
+    return queue;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    return new QueueDefinition(kBinary, 1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount) {
+    if (uxMaxCount == 0 || uxInitialCount > uxMaxCount) {
+        return nullptr;
+    }
+    return new QueueDefinition(kCounting, uxMaxCount, uxInitialCount);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore) {
+    if (xSemaphore != nullptr && xSemaphore->staticStorage) {
+        xSemaphore->~QueueDefinition();  // The caller owns the memory
+        return;
+    }
+    delete xSemaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime) {
+    configASSERT(xSemaphore != nullptr);
+    std::unique_lock<std::mutex> lk(xSemaphore->lock);
+    if (!xSemaphore->wait(lk, xBlockTime)) {
+        return pdFALSE;
+    }
+    xSemaphore->count--;
+    if (xSemaphore->isMutex()) {
+        xSemaphore->holder = xTaskGetCurrentTaskHandle();
+        xSemaphore->recursion = 1;
+    }
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) {
+    configASSERT(xSemaphore != nullptr);
+    {
+        std::lock_guard<std::mutex> lk(xSemaphore->lock);
+        if (xSemaphore->isMutex()) {
+            // Only the holder may give a mutex back
+            if (xSemaphore->holder != xTaskGetCurrentTaskHandle()) {
+                return pdFALSE;
+            }
+            xSemaphore->holder = nullptr;
+            xSemaphore->recursion = 0;
+        } else if (xSemaphore->count >= xSemaphore->maxCount) {
+            return pdFALSE;
+        }
+        xSemaphore->count++;
+    }
+    xSemaphore->available.notify_one();
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t xSemaphore, BaseType_t* pxHigherPriorityTaskWoken) {
+    // Mutexes cannot be given from an ISR
+    configASSERT(xSemaphore != nullptr && !xSemaphore->isMutex());
+    if (pxHigherPriorityTaskWoken != nullptr) {
+        *pxHigherPriorityTaskWoken = pdFALSE;  // No priorities on the host
+    }
+    return xSemaphoreGive(xSemaphore);
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t xMutex, TickType_t xBlockTime) {
+    configASSERT(xMutex != nullptr && xMutex->type == kRecursiveMutex);
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lk(xMutex->lock);
+    if (xMutex->holder == self) {
+        xMutex->recursion++;
+        return pdTRUE;
+    }
+    if (!xMutex->wait(lk, xBlockTime)) {
+        return pdFALSE;
+    }
+    xMutex->count--;
+    xMutex->holder = self;
+    xMutex->recursion = 1;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t xMutex) {
+    configASSERT(xMutex != nullptr && xMutex->type == kRecursiveMutex);
+    {
+        std::lock_guard<std::mutex> lk(xMutex->lock);
+        if (xMutex->holder != xTaskGetCurrentTaskHandle()) {
+            return pdFALSE;
+        }
+        if (--xMutex->recursion > 0) {
+            return pdTRUE;
+        }
+        xMutex->holder = nullptr;
+        xMutex->count++;
+    }
+    xMutex->available.notify_one();
+    return pdTRUE;
+}
+
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t xSemaphore) {
+    std::lock_guard<std::mutex> lk(xSemaphore->lock);
+    return xSemaphore->holder;
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t xSemaphore) {
+    std::lock_guard<std::mutex> lk(xSemaphore->lock);
+    return xSemaphore->count;
+}
+
+} // extern "C"
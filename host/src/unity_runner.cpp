@@ -0,0 +1,121 @@
+#include "unity.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void setup();
+
+namespace {
+
+// Thrown by a failed assertion or TEST_PASS() to end the current test
+struct TestAbort {
+    bool passed;
+};
+
+const char* g_file = "";
+const char* g_currentTest = "";
+int g_tests = 0;
+int g_failures = 0;
+int g_totalFailures = 0;
+bool g_currentFailed = false;
+
+void reportFailure(const char* message, int line) {
+    printf("%s:%d:%s:FAIL", g_file, line, g_currentTest);
+    if (message != nullptr && message[0] != '\0') {
+        printf(": %s", message);
+    }
+    printf("\n");
+    g_currentFailed = true;
+    throw TestAbort{false};
+}
+
+} // namespace
+
+__attribute__((weak)) void setUp(void) {}
+__attribute__((weak)) void tearDown(void) {}
+
+void UnityBegin(const char* filename) {
+    g_file = filename;
+    g_tests = 0;
+    g_failures = 0;
+}
+
+int UnityEnd(void) {
+    printf("\n-----------------------\n%d Tests %d Failures 0 Ignored\n%s\n",
+           g_tests, g_failures, g_failures == 0 ? "OK" : "FAIL");
+    fflush(stdout);
+    g_totalFailures += g_failures;
+    return g_failures;
+}
+
+void UnityDefaultTestRun(void (*func)(void), const char* name, int line) {
+    g_currentTest = name;
+    g_currentFailed = false;
+    g_tests++;
+    try {
+        setUp();
+        func();
+    } catch (const TestAbort&) {
+    }
+    try {
+        tearDown();
+    } catch (const TestAbort&) {
+    }
+    if (g_currentFailed) {
+        g_failures++;
+    } else {
+        printf("%s:%d:%s:PASS\n", g_file, line, name);
+    }
+    fflush(stdout);
+}
+
+void UnityFail(const char* message, int line) {
+    reportFailure(message, line);
+}
+
+void UnityPass(void) {
+    throw TestAbort{true};
+}
+
+void UnityAssertEqualNumber(int64_t expected, int64_t actual, const char* message, int line) {
+    if (expected != actual) {
+        char buf[128];
+        snprintf(buf, sizeof(buf), "Expected %lld Was %lld%s%s", (long long)expected,
+                 (long long)actual, message ? ". " : "", message ? message : "");
+        reportFailure(buf, line);
+    }
+}
+
+void UnityAssertCompare(int64_t threshold, int64_t actual, int wantGreater, int orEqual,
+                        const char* message, int line) {
+    bool ok = wantGreater ? (orEqual ? actual >= threshold : actual > threshold)
+                          : (orEqual ? actual <= threshold : actual < threshold);
+    if (!ok) {
+        char buf[128];
+        snprintf(buf, sizeof(buf), "Expected %s %s %lld Was %lld%s%s",
+                 wantGreater ? "greater" : "less", orEqual ? "or equal to" : "than",
+                 (long long)threshold, (long long)actual, message ? ". " : "",
+                 message ? message : "");
+        reportFailure(buf, line);
+    }
+}
+
+void UnityAssertEqualString(const char* expected, const char* actual, const char* message,
+                            int line) {
+    bool equal = (expected == nullptr || actual == nullptr) ? expected == actual
+                                                            : strcmp(expected, actual) == 0;
+    if (!equal) {
+        char buf[192];
+        snprintf(buf, sizeof(buf), "Expected '%s' Was '%s'%s%s", expected ? expected : "(null)",
+                 actual ? actual : "(null)", message ? ". " : "", message ? message : "");
+        reportFailure(buf, line);
+    }
+}
+
+// Host entry point for Arduino-style test sketches: run setup() once (which
+// drives UNITY_BEGIN/RUN_TEST/UNITY_END) and report the failures via the
+// exit code so ctest can pick them up.
+int main() {
+    setup();
+    return g_totalFailures == 0 ? 0 : 1;
+}
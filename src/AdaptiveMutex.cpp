@@ -0,0 +1,161 @@
+#include "AdaptiveMutex.h"
+
+#include "freertos/task.h"
+
+namespace {
+
+const uint32_t kUnlocked = 0;
+const uint32_t kLocked = 1;
+const uint32_t kContended = 2;  // Locked, and a task may be blocked on the semaphore
+
+const uint32_t kMaxBackoff = 16;  // Relax instructions between polls, at most
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#else
+    __asm__ __volatile__("nop");
+#endif
+}
+
+} // namespace
+
+AdaptiveMutex::AdaptiveMutex()
+    : m_state(kUnlocked), m_spinEstimate(0), m_wakeup(xSemaphoreCreateBinary()) {
+    if (m_wakeup == nullptr) {
+        MUTEXG_LOG_E("Failed to create AdaptiveMutex wake-up semaphore");
+    }
+}
+
+AdaptiveMutex::~AdaptiveMutex() {
+    if (m_wakeup != nullptr) {
+        vSemaphoreDelete(m_wakeup);
+    }
+}
+
+bool AdaptiveMutex::tryLock() {
+    uint32_t expected = kUnlocked;
+    return m_wakeup != nullptr &&
+           m_state.compare_exchange_strong(expected, kLocked, std::memory_order_acquire,
+                                           std::memory_order_relaxed);
+}
+
+bool AdaptiveMutex::lock(TickType_t timeout) {
+    if (tryLock()) {
+        return true;
+    }
+    if (m_wakeup == nullptr || timeout == 0) {
+        return false;
+    }
+    return spinLock() || blockLock(timeout);
+}
+
+bool AdaptiveMutex::spinLock() {
+    if (portNUM_PROCESSORS < 2) {
+        return false;  // The owner cannot run while we spin
+    }
+
+    uint32_t estimate = m_spinEstimate.load(std::memory_order_relaxed);
+    uint32_t limit = 2 * estimate + MUTEXGUARD_ADAPTIVE_MIN_SPIN;
+    if (limit > MUTEXGUARD_ADAPTIVE_MAX_SPIN) {
+        limit = MUTEXGUARD_ADAPTIVE_MAX_SPIN;
+    }
+
+    uint32_t backoff = 1;
+    for (uint32_t spins = 1; spins <= limit; spins++) {
+        for (uint32_t i = 0; i < backoff; i++) {
+            cpuRelax();
+        }
+        if (backoff < kMaxBackoff) {
+            backoff <<= 1;
+        }
+
+        // Only barge in when the word is free; waiters sleeping on a
+        // contended lock keep it in kContended.
+        if (m_state.load(std::memory_order_relaxed) == kUnlocked && tryLock()) {
+            // Move 1/8 of the way towards this acquisition's spin count
+            int32_t delta = (int32_t)spins - (int32_t)estimate;
+            m_spinEstimate.store((uint32_t)((int32_t)estimate + delta / 8), std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // The owner held on longer than the budget: spin less next time
+    m_spinEstimate.store(estimate - estimate / 8, std::memory_order_relaxed);
+    return false;
+}
+
+bool AdaptiveMutex::blockLock(TickType_t timeout) {
+    TickType_t start = xTaskGetTickCount();
+
+    // Announce a waiter so the next unlock() gives the semaphore. Acquires
+    // the lock if it was released in the meantime.
+    uint32_t state = m_state.exchange(kContended, std::memory_order_acquire);
+    while (state != kUnlocked) {
+        TickType_t wait = portMAX_DELAY;
+        if (timeout != portMAX_DELAY) {
+            TickType_t elapsed = xTaskGetTickCount() - start;
+            if (elapsed >= timeout) {
+                return false;
+            }
+            wait = timeout - elapsed;
+        }
+        // A wake-up may be stale; the exchange below decides
+        xSemaphoreTake(m_wakeup, wait);
+        state = m_state.exchange(kContended, std::memory_order_acquire);
+    }
+    return true;
+}
+
+void AdaptiveMutex::unlock() {
+    if (m_state.exchange(kUnlocked, std::memory_order_release) == kContended) {
+        xSemaphoreGive(m_wakeup);
+    }
+}
+
+AdaptiveMutexGuard::AdaptiveMutexGuard(AdaptiveMutex& mutex, TickType_t timeout)
+    : m_mutex(&mutex), m_taken(false) {
+
+    // Check for a mutex whose semaphore could not be created
+    if (!m_mutex->isValid()) {
+        MUTEXG_LOG_W("Attempted to create AdaptiveMutexGuard with invalid mutex");
+        m_mutex = nullptr;
+        return;
+    }
+
+    // Check if we're in ISR context
+    if (xPortInIsrContext()) {
+        MUTEXG_LOG_E("Cannot use AdaptiveMutexGuard from ISR context (mutex '%s')",
+                     MUTEXG_NAME(m_mutex->handle()));
+        m_mutex = nullptr;  // Invalidate to prevent unlock attempt
+        return;
+    }
+
+    m_taken = m_hooks.acquire(m_mutex->handle(), MUTEXGUARD_GUARD_SITE(), false,
+                              [&] { return m_mutex->lock(timeout); });
+
+    MUTEX_GUARD_LOG("Adaptive mutex '%s' %s", MUTEXG_NAME(m_mutex->handle()),
+                    m_taken ? "locked" : "failed to lock (timeout)");
+}
+
+AdaptiveMutexGuard::~AdaptiveMutexGuard() {
+    unlock();
+}
+
+void AdaptiveMutexGuard::unlock() noexcept {
+    if (m_taken && m_mutex != nullptr) {
+        // Double-check we're not in ISR context
+        if (xPortInIsrContext()) {
+            MUTEXG_LOG_E("Cannot unlock adaptive mutex '%s' from ISR context",
+                         MUTEXG_NAME(m_mutex->handle()));
+            return;
+        }
+
+        m_hooks.release(m_mutex->handle(), [&] { m_mutex->unlock(); });
+        m_taken = false;
+
+        MUTEX_GUARD_LOG("Adaptive mutex '%s' unlocked", MUTEXG_NAME(m_mutex->handle()));
+    }
+}
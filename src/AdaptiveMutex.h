@@ -0,0 +1,172 @@
+#ifndef _ADAPTIVEMUTEX_H_
+#define _ADAPTIVEMUTEX_H_
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "GuardHooks.h"
+#include "MutexGuardLogging.h"
+
+#ifndef MUTEXGUARD_ADAPTIVE_MAX_SPIN
+#define MUTEXGUARD_ADAPTIVE_MAX_SPIN 200  ///< Upper bound on polls before blocking
+#endif
+
+#ifndef MUTEXGUARD_ADAPTIVE_MIN_SPIN
+#define MUTEXGUARD_ADAPTIVE_MIN_SPIN 10  ///< Polls always allowed on multi-core targets
+#endif
+
+/**
+ * @brief Mutex that spins briefly on an atomic word before blocking
+ *
+ * On dual-core ESP32s a plain FreeRTOS mutex puts a task to sleep even when
+ * the owner on the other core releases a few hundred cycles later, paying
+ * for two context switches. AdaptiveMutex first tries a compare-and-swap on
+ * an atomic state word; if the lock is held it polls with exponential
+ * backoff for a bounded number of iterations, and only then blocks on a
+ * binary semaphore until the owner hands over.
+ *
+ * The spin budget tunes itself: it tracks a moving average of how many
+ * polls recent acquisitions needed before the owner released (a measure of
+ * the remaining hold time) and allows about twice that, between
+ * MUTEXGUARD_ADAPTIVE_MIN_SPIN and MUTEXGUARD_ADAPTIVE_MAX_SPIN. Spins that
+ * end in blocking shrink the budget, so long holds quickly stop wasting CPU.
+ * Single-core targets never spin.
+ *
+ * Trade-offs against a FreeRTOS mutex: there is no priority inheritance and
+ * no owner check, and unlock() must be called by the task that locked it.
+ * Not usable from ISR context.
+ *
+ * Usage:
+ * @code
+ * static AdaptiveMutex cacheLock;
+ * {
+ *     AdaptiveMutexGuard lock(cacheLock, pdMS_TO_TICKS(10));
+ *     if (lock) {
+ *         cache.update();
+ *     }
+ * }
+ * @endcode
+ */
+class AdaptiveMutex {
+public:
+    /**
+     * @brief Create the mutex and its wake-up semaphore
+     *
+     * Check isValid() if heap allocation may fail.
+     */
+    AdaptiveMutex();
+
+    /**
+     * @brief Delete the wake-up semaphore; the mutex must be unlocked
+     */
+    ~AdaptiveMutex();
+
+    // Not copyable or movable: waiters hold a reference to the state word
+    AdaptiveMutex(const AdaptiveMutex&) = delete;
+    AdaptiveMutex& operator=(const AdaptiveMutex&) = delete;
+
+    /**
+     * @brief Acquire the mutex
+     *
+     * @param timeout Ticks to wait, with the same meaning as for
+     *                xSemaphoreTake(): 0 tries once without spinning,
+     *                portMAX_DELAY waits forever
+     * @return true if the mutex is now held by the caller
+     */
+    bool lock(TickType_t timeout = portMAX_DELAY);
+
+    /**
+     * @brief Acquire the mutex only if it is free right now
+     */
+    bool tryLock();
+
+    /**
+     * @brief Release the mutex, waking one blocked waiter if there is one
+     */
+    void unlock();
+
+    /**
+     * @brief Check if the wake-up semaphore was created
+     */
+    bool isValid() const noexcept { return m_wakeup != nullptr; }
+
+    /**
+     * @brief Handle identifying this mutex in MutexRegistry, statistics and lockdep
+     */
+    SemaphoreHandle_t handle() const noexcept { return m_wakeup; }
+
+    /**
+     * @brief Current moving average of polls needed to acquire while spinning
+     */
+    uint32_t spinEstimate() const noexcept { return m_spinEstimate.load(std::memory_order_relaxed); }
+
+private:
+    bool spinLock();
+    bool blockLock(TickType_t timeout);
+
+    std::atomic<uint32_t> m_state;         ///< Unlocked, locked, or locked with waiters
+    std::atomic<uint32_t> m_spinEstimate;  ///< Moving average of polls per spin acquisition
+    SemaphoreHandle_t m_wakeup;            ///< Binary semaphore blocked waiters sleep on
+};
+
+/**
+ * @brief RAII guard for AdaptiveMutex
+ *
+ * Same API and timeout semantics as MutexGuard. Logging, statistics and
+ * lockdep identify the mutex by AdaptiveMutex::handle().
+ */
+class AdaptiveMutexGuard {
+public:
+    /**
+     * @brief Construct the guard and attempt to lock the mutex
+     *
+     * @param mutex The mutex to lock
+     * @param timeout Timeout in ticks to wait for the mutex (default: 100ms)
+     */
+    explicit AdaptiveMutexGuard(AdaptiveMutex& mutex, TickType_t timeout = pdMS_TO_TICKS(100));
+
+    /**
+     * @brief Destroy the guard and unlock the mutex if it was locked
+     */
+    ~AdaptiveMutexGuard();
+
+    // Delete copy constructor and assignment operator to prevent double-release
+    AdaptiveMutexGuard(const AdaptiveMutexGuard&) = delete;
+    AdaptiveMutexGuard& operator=(const AdaptiveMutexGuard&) = delete;
+
+    // Delete move semantics for safety
+    AdaptiveMutexGuard(AdaptiveMutexGuard&&) = delete;
+    AdaptiveMutexGuard& operator=(AdaptiveMutexGuard&&) = delete;
+
+    /**
+     * @brief Check if the mutex was successfully locked
+     */
+    bool hasLock() const noexcept { return m_taken; }
+
+    /**
+     * @brief Check if the guarded mutex is usable
+     */
+    bool isValid() const noexcept { return m_mutex != nullptr; }
+
+    /**
+     * @brief Manually unlock the mutex before the guard is destroyed
+     *
+     * Safe to call multiple times.
+     */
+    void unlock() noexcept;
+
+    /**
+     * @brief Convert to bool for convenient if-statement usage
+     */
+    explicit operator bool() const noexcept { return hasLock(); }
+
+private:
+    AdaptiveMutex* m_mutex;  ///< The mutex, nullptr if unusable
+    bool m_taken;            ///< Whether the mutex was successfully taken
+    GuardHooks m_hooks;      ///< Diagnostic hook state
+};
+
+#endif // _ADAPTIVEMUTEX_H_
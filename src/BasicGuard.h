@@ -0,0 +1,255 @@
+#ifndef _BASICGUARD_H_
+#define _BASICGUARD_H_
+
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "GuardHooks.h"
+
+/**
+ * @file BasicGuard.h
+ * @brief Policy-based RAII guard behind MutexGuard and RecursiveMutexGuard
+ *
+ * BasicGuard<LockPolicy, CheckPolicy, LogPolicy> holds the lifecycle shared by
+ * the semaphore guards: optional null and ISR checks, lock with timeout,
+ * lockdep, statistics, watchdog and trace hooks, unlock on destruction. The
+ * policies choose how the semaphore is taken, which checks run and where
+ * messages go; a check that is switched off is not compiled in at all.
+ *
+ * MutexGuard and RecursiveMutexGuard are instantiations with every check and
+ * logging enabled; they are compiled once inside the library. Other
+ * instantiations are compiled in the code that uses them and can be fully
+ * inlined, e.g. a hot-path guard without checks:
+ *
+ * @code
+ * typedef BasicGuard<MutexLockPolicy, NoGuardChecks, SilentGuardLog> FastMutexGuard;
+ *
+ * void onSample(uint32_t value) {
+ *     FastMutexGuard lock(sampleMutex, portMAX_DELAY);  // Valid handle, task context only
+ *     ring.push(value);
+ * }
+ * @endcode
+ *
+ * With MUTEXGUARD_HEADER_ONLY defined for the whole build, MutexGuard and
+ * RecursiveMutexGuard are inlined the same way. Their error and log messages
+ * stay in the library as cold, out-of-line functions, so the inlined path
+ * is the take/give plus the checks.
+ *
+ * Policy interfaces:
+ * - LockPolicy: `static bool take(SemaphoreHandle_t, TickType_t)`,
+ *   `static void give(SemaphoreHandle_t)` and `static const bool recursive`
+ * - CheckPolicy: `static const bool checkNull` and `static const bool checkIsr`
+ * - LogPolicy: `static void` functions `nullHandle()`, `isrLock(handle)`,
+ *   `isrUnlock(handle)`, `locked(handle, taken)` and `unlocked(handle)`;
+ *   the last two are only called if `static const bool verbose` is true
+ */
+
+/**
+ * @brief Marks a function as rarely called: kept out of line, away from hot code
+ */
+#if defined(__GNUC__)
+#define MUTEXGUARD_COLD __attribute__((cold, noinline))
+#else
+#define MUTEXGUARD_COLD
+#endif
+
+/**
+ * @brief Branch hint for conditions that are almost never true
+ *
+ * Use as `if (MUTEXGUARD_EXPECT_FALSE(cond)) MUTEXGUARD_UNLIKELY { ... }`.
+ * `[[unlikely]]` needs C++20; older standards rely on __builtin_expect.
+ */
+#if defined(__GNUC__)
+#define MUTEXGUARD_EXPECT_FALSE(cond) __builtin_expect(!!(cond), 0)
+#else
+#define MUTEXGUARD_EXPECT_FALSE(cond) (cond)
+#endif
+
+#if __cplusplus >= 202002L
+#define MUTEXGUARD_UNLIKELY [[unlikely]]
+#else
+#define MUTEXGUARD_UNLIKELY
+#endif
+
+// Out-of-class members: inline in header-only mode, otherwise left to the
+// extern template declarations of MutexGuard and RecursiveMutexGuard
+#ifdef MUTEXGUARD_HEADER_ONLY
+#define MUTEXGUARD_GUARD_INLINE inline
+#else
+#define MUTEXGUARD_GUARD_INLINE
+#endif
+
+/**
+ * @brief Lock policy for mutexes from xSemaphoreCreateMutex()
+ */
+struct MutexLockPolicy {
+    static const bool recursive = false;
+    static bool take(SemaphoreHandle_t handle, TickType_t timeout) {
+        return xSemaphoreTake(handle, timeout) == pdTRUE;
+    }
+    static void give(SemaphoreHandle_t handle) { xSemaphoreGive(handle); }
+};
+
+/**
+ * @brief Lock policy for mutexes from xSemaphoreCreateRecursiveMutex()
+ */
+struct RecursiveMutexLockPolicy {
+    static const bool recursive = true;
+    static bool take(SemaphoreHandle_t handle, TickType_t timeout) {
+        return xSemaphoreTakeRecursive(handle, timeout) == pdTRUE;
+    }
+    static void give(SemaphoreHandle_t handle) { xSemaphoreGiveRecursive(handle); }
+};
+
+/**
+ * @brief Check policy: reject null handles and ISR context (MutexGuard behaviour)
+ */
+struct DefaultGuardChecks {
+    static const bool checkNull = true;
+    static const bool checkIsr = true;
+};
+
+/**
+ * @brief Check policy: ISR check only, for handles that can never be null
+ */
+struct IsrOnlyGuardChecks {
+    static const bool checkNull = false;
+    static const bool checkIsr = true;
+};
+
+/**
+ * @brief Check policy: no checks; the caller guarantees a valid handle and task context
+ */
+struct NoGuardChecks {
+    static const bool checkNull = false;
+    static const bool checkIsr = false;
+};
+
+/**
+ * @brief Log policy that emits nothing
+ */
+struct SilentGuardLog {
+    static const bool verbose = false;
+    static void nullHandle() {}
+    static void isrLock(SemaphoreHandle_t) {}
+    static void isrUnlock(SemaphoreHandle_t) {}
+    static void locked(SemaphoreHandle_t, bool) {}
+    static void unlocked(SemaphoreHandle_t) {}
+};
+
+/**
+ * @brief RAII guard for a FreeRTOS semaphore, configured by policies
+ *
+ * @tparam LockPolicy How the semaphore is taken and given
+ * @tparam CheckPolicy Which argument and context checks are compiled in
+ * @tparam LogPolicy Where diagnostic messages go
+ */
+template <typename LockPolicy, typename CheckPolicy, typename LogPolicy>
+class BasicGuard {
+public:
+    /**
+     * @brief Construct the guard and attempt to lock the semaphore
+     *
+     * @param handle The FreeRTOS semaphore handle to lock
+     * @param timeout Timeout in ticks to wait for the semaphore (default: 100ms)
+     */
+    explicit BasicGuard(SemaphoreHandle_t handle, TickType_t timeout = pdMS_TO_TICKS(100));
+
+    /**
+     * @brief Destroy the guard and unlock the semaphore if it was locked
+     */
+    ~BasicGuard();
+
+    // Delete copy constructor and assignment operator to prevent double-release
+    BasicGuard(const BasicGuard&) = delete;
+    BasicGuard& operator=(const BasicGuard&) = delete;
+
+    // Delete move semantics for safety
+    BasicGuard(BasicGuard&&) = delete;
+    BasicGuard& operator=(BasicGuard&&) = delete;
+
+    /**
+     * @brief Check if the semaphore was successfully locked
+     * @return true if the semaphore is currently held by this guard
+     */
+    bool hasLock() const noexcept { return m_taken; }
+
+    /**
+     * @brief Check if the handle is valid
+     * @return true if the handle is not null
+     */
+    bool isValid() const noexcept { return m_handle != nullptr; }
+
+    /**
+     * @brief Manually unlock the semaphore before the guard is destroyed
+     *
+     * This method is safe to call multiple times. After calling unlock(),
+     * hasLock() will return false.
+     */
+    void unlock() noexcept;
+
+    /**
+     * @brief Convert to bool for convenient if-statement usage
+     * @return true if the semaphore is locked
+     */
+    explicit operator bool() const noexcept { return hasLock(); }
+
+private:
+    SemaphoreHandle_t m_handle;  ///< The semaphore handle
+    bool m_taken;                ///< Whether the semaphore was successfully taken
+    GuardHooks m_hooks;          ///< Diagnostic hook state
+};
+
+// Members are defined out of class so that `extern template` keeps the
+// MutexGuard and RecursiveMutexGuard instantiations inside the library.
+
+template <typename LockPolicy, typename CheckPolicy, typename LogPolicy>
+MUTEXGUARD_GUARD_INLINE MUTEXGUARD_SITE_NOINLINE BasicGuard<LockPolicy, CheckPolicy, LogPolicy>::BasicGuard(SemaphoreHandle_t handle, TickType_t timeout)
+    : m_handle(handle), m_taken(false) {
+
+    // Check for null handle
+    if (MUTEXGUARD_EXPECT_FALSE(CheckPolicy::checkNull && m_handle == nullptr)) MUTEXGUARD_UNLIKELY {
+        LogPolicy::nullHandle();
+        return;
+    }
+
+    // Check if we're in ISR context
+    if (MUTEXGUARD_EXPECT_FALSE(CheckPolicy::checkIsr && xPortInIsrContext())) MUTEXGUARD_UNLIKELY {
+        LogPolicy::isrLock(m_handle);
+        m_handle = nullptr;  // Invalidate to prevent unlock attempt
+        return;
+    }
+
+    m_taken = m_hooks.acquire(m_handle, MUTEXGUARD_GUARD_SITE(), LockPolicy::recursive,
+                              [&] { return LockPolicy::take(m_handle, timeout); });
+
+    if (LogPolicy::verbose) {
+        LogPolicy::locked(m_handle, m_taken);
+    }
+}
+
+template <typename LockPolicy, typename CheckPolicy, typename LogPolicy>
+MUTEXGUARD_GUARD_INLINE BasicGuard<LockPolicy, CheckPolicy, LogPolicy>::~BasicGuard() {
+    unlock();
+}
+
+template <typename LockPolicy, typename CheckPolicy, typename LogPolicy>
+MUTEXGUARD_GUARD_INLINE void BasicGuard<LockPolicy, CheckPolicy, LogPolicy>::unlock() noexcept {
+    if (m_taken) {
+        // Double-check we're not in ISR context
+        if (MUTEXGUARD_EXPECT_FALSE(CheckPolicy::checkIsr && xPortInIsrContext())) MUTEXGUARD_UNLIKELY {
+            LogPolicy::isrUnlock(m_handle);
+            return;
+        }
+
+        m_hooks.release(m_handle, [&] { LockPolicy::give(m_handle); });
+        m_taken = false;
+
+        if (LogPolicy::verbose) {
+            LogPolicy::unlocked(m_handle);
+        }
+    }
+}
+
+#endif // _BASICGUARD_H_
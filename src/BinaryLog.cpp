@@ -0,0 +1,135 @@
+#include "BinaryLog.h"
+
+#ifdef MUTEXGUARD_BINARY_LOG
+
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+
+static_assert(MUTEXGUARD_BINARY_LOG_FRAME >= 16, "MUTEXGUARD_BINARY_LOG_FRAME is too small");
+static_assert(MUTEXGUARD_BINARY_LOG_FRAME <= 254,
+              "MUTEXGUARD_BINARY_LOG_FRAME must keep a frame within one COBS block");
+
+namespace {
+
+std::atomic<BinaryLog::Sink> g_sink(nullptr);
+std::atomic<uint32_t> g_dropped(0);
+
+const uint8_t kEscape = 0x7D;  // Followed by the escaped byte XOR 0x20
+
+// Bytes a console may rewrite: the ESP-IDF UART turns LF into CR LF
+bool needsEscape(uint8_t value) {
+    return value == '\n' || value == '\r' || value == kEscape;
+}
+
+void defaultSink(const uint8_t* data, size_t length) {
+    fwrite(data, 1, length, stdout);
+}
+
+} // namespace
+
+BinaryLogFrame::BinaryLogFrame(uint32_t id, uint32_t timestampMs)
+    : m_length(2), m_codeAt(1), m_run(1), m_overflow(false) {
+    m_buffer[0] = 0;  // Delimiter: ends whatever text came before
+    putVarint(id);
+    putVarint(timestampMs);
+}
+
+void BinaryLogFrame::putByte(uint8_t value) {
+    // One byte for the value and one for the closing delimiter
+    if (m_length + 2 > sizeof(m_buffer)) {
+        m_overflow = true;
+        return;
+    }
+    if (value == 0) {
+        m_buffer[m_codeAt] = m_run;
+        m_codeAt = m_length++;
+        m_run = 1;
+    } else {
+        m_buffer[m_length++] = value;
+        m_run++;
+    }
+}
+
+void BinaryLogFrame::putVarint(unsigned long long value) {
+    while (value >= 0x80) {
+        putByte((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    putByte((uint8_t)value);
+}
+
+void BinaryLogFrame::putSigned(long long value) {
+    putVarint(((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63));
+}
+
+void BinaryLogFrame::putDouble(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; i++) {
+        putByte((uint8_t)(bits >> (8 * i)));
+    }
+}
+
+void BinaryLogFrame::putString(const char* value) {
+    if (value == nullptr) {
+        value = "(null)";
+    }
+    size_t length = strnlen(value, MUTEXGUARD_BINARY_LOG_STRING);
+    putVarint(length);
+    for (size_t i = 0; i < length; i++) {
+        putByte((uint8_t)value[i]);
+    }
+}
+
+size_t BinaryLogFrame::finish() {
+    if (m_overflow) {
+        return 0;
+    }
+    m_buffer[m_codeAt] = m_run;
+
+    // Escape in place from the back, after the code bytes are known
+    size_t escapes = 0;
+    for (size_t i = 1; i < m_length; i++) {
+        escapes += needsEscape(m_buffer[i]) ? 1 : 0;
+    }
+    size_t length = m_length + escapes + 1;  // And the closing delimiter
+    if (length > sizeof(m_buffer)) {
+        m_overflow = true;
+        return 0;
+    }
+    size_t to = length - 1;
+    m_buffer[to] = 0;
+    for (size_t from = m_length - 1; from >= 1; from--) {
+        uint8_t value = m_buffer[from];
+        if (needsEscape(value)) {
+            m_buffer[--to] = value ^ 0x20;
+            m_buffer[--to] = kEscape;
+        } else {
+            m_buffer[--to] = value;
+        }
+    }
+    m_length = length;
+    return m_length;
+}
+
+void BinaryLog::setSink(Sink sink) {
+    g_sink.store(sink, std::memory_order_release);
+}
+
+uint32_t BinaryLog::dropped() {
+    return g_dropped.load(std::memory_order_relaxed);
+}
+
+void BinaryLog::emit(BinaryLogFrame& frame) {
+    size_t length = frame.finish();
+    if (length == 0) {
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Sink sink = g_sink.load(std::memory_order_acquire);
+    (sink != nullptr ? sink : defaultSink)(frame.data(), length);
+}
+
+#endif // MUTEXGUARD_BINARY_LOG
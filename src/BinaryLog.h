@@ -0,0 +1,259 @@
+#ifndef _BINARYLOG_H_
+#define _BINARYLOG_H_
+
+/**
+ * @file BinaryLog.h
+ * @brief Opt-in backend that emits MUTEXG_LOG_* / RMUTEXG_LOG_* messages unformatted
+ *
+ * Compiled out unless MUTEXGUARD_BINARY_LOG is defined for the whole build
+ * (library and application), e.g. `build_flags = -DMUTEXGUARD_BINARY_LOG`.
+ */
+
+#ifdef MUTEXGUARD_BINARY_LOG
+
+#ifdef MUTEXGUARD_DEFERRED_LOG
+#error "MUTEXGUARD_BINARY_LOG and MUTEXGUARD_DEFERRED_LOG cannot be combined"
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <type_traits>
+
+#include <esp_log.h>
+#include "LogArgs.h"
+
+#ifndef MUTEXGUARD_BINARY_LOG_FRAME
+#define MUTEXGUARD_BINARY_LOG_FRAME 96  ///< Largest encoded frame in bytes
+#endif
+
+#ifndef MUTEXGUARD_BINARY_LOG_STRING
+#define MUTEXGUARD_BINARY_LOG_STRING 32  ///< Longest %s argument kept
+#endif
+
+#define MUTEXGUARD_BINARY_LOG_ID_BITS 21  ///< Message IDs fit a 3-byte varint
+
+/**
+ * @brief Encoder for one frame: COBS-stuffed, escaped varints between two zero bytes
+ */
+class BinaryLogFrame {
+public:
+    /// How an argument is encoded, decided by its conversion in the format
+    enum ArgClass : uint8_t {
+        kUnsigned = 0,  ///< varint (%u %x %o %c %p ...)
+        kSigned = 1,    ///< zigzag varint (%d %i)
+        kDouble = 2,    ///< 8 bytes, little-endian IEEE 754 (%f %e %g %a)
+        kString = 3     ///< varint length, then the bytes (%s)
+    };
+
+    BinaryLogFrame(uint32_t id, uint32_t timestampMs);
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    add(uint8_t argClass, T value) {
+        typedef typename LogArgs::Promoted<T>::type Promoted;
+        if (argClass == kSigned) {
+            putSigned((long long)(Promoted)value);
+        } else {
+            // Same bits printf would see, e.g. 0xffffffff for -1 with %x
+            putVarint((unsigned long long)(typename std::make_unsigned<Promoted>::type)value);
+        }
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type add(uint8_t argClass, T value) {
+        (void)argClass;
+        putDouble(value);
+    }
+
+    void add(uint8_t argClass, const char* value) {
+        if (argClass == kString) {
+            putString(value);
+        } else {
+            putVarint((uintptr_t)value);
+        }
+    }
+    void add(uint8_t argClass, char* value) { add(argClass, (const char*)value); }
+    void add(uint8_t argClass, const void* value) { (void)argClass; putVarint((uintptr_t)value); }
+    void add(uint8_t argClass, std::nullptr_t) { (void)argClass; putVarint(0); }
+
+    void addAll(uint32_t classes) { (void)classes; }
+
+    template <typename T, typename... Rest>
+    void addAll(uint32_t classes, T first, Rest... rest) {
+        add((uint8_t)(classes & 3), first);
+        addAll(classes >> 2, rest...);
+    }
+
+    /**
+     * @brief Close the frame
+     *
+     * @return Encoded length, or 0 if the record did not fit
+     */
+    size_t finish();
+
+    const uint8_t* data() const { return m_buffer; }
+
+    void putVarint(unsigned long long value);
+    void putSigned(long long value);
+    void putDouble(double value);
+    void putString(const char* value);
+
+private:
+    void putByte(uint8_t value);
+
+    uint8_t m_buffer[MUTEXGUARD_BINARY_LOG_FRAME];
+    size_t m_length;    ///< Bytes written, including the pending code byte
+    size_t m_codeAt;    ///< Position of the open COBS code byte
+    uint8_t m_run;      ///< Code value: bytes since the code byte + 1
+    bool m_overflow;
+};
+
+/**
+ * @brief Emits guard log messages as compact binary records
+ *
+ * With MUTEX_GUARD_DEBUG, every lock and unlock formats a text line with
+ * printf and sends it over the UART. With MUTEXGUARD_BINARY_LOG, the
+ * MUTEXG_LOG_* and RMUTEXG_LOG_* macros emit a record that holds only the
+ * message ID, the esp_log_timestamp() and the raw arguments:
+ *
+ * - The ID is computed at compile time from the level, the tag and the
+ *   format string (FNV-1a, MUTEXGUARD_BINARY_LOG_ID_BITS bits). It stands
+ *   for the message text, so identical messages share an ID.
+ * - Integers are varints (zigzag for %d and %i). Doubles take 8 bytes.
+ *   %s strings are sent with their length, at most
+ *   MUTEXGUARD_BINARY_LOG_STRING bytes.
+ * - Each record is COBS-encoded and placed between two zero bytes. A decoder
+ *   can find the records in a stream that also carries text output.
+ * - Inside the record, LF, CR and 0x7D are sent as 0x7D followed by the byte
+ *   XOR 0x20. Consoles rewrite line endings (the ESP-IDF UART turns LF into
+ *   CR LF), and a record without them passes through unchanged.
+ *
+ * A typical lock message takes about 10 bytes instead of 40 or more. The
+ * device never formats text. `tools/binary_log.py` rebuilds the text on the
+ * host. It builds the string table from the sources, using the same hash.
+ *
+ * Limits: format strings must be literals (all library call sites are) and
+ * `*` widths are not supported. A record that does not fit
+ * MUTEXGUARD_BINARY_LOG_FRAME bytes after escaping is dropped and counted.
+ *
+ * Usage:
+ * @code
+ * // build_flags = -DMUTEXGUARD_BINARY_LOG -DMUTEX_GUARD_DEBUG
+ * // Records go to stdout unless a sink is set, e.g. a second UART:
+ * BinaryLog::setSink([](const uint8_t* data, size_t length) {
+ *     Serial2.write(data, length);
+ * });
+ * @endcode
+ * @code
+ * python3 tools/binary_log.py decode --sources src capture.bin
+ * @endcode
+ */
+class BinaryLog {
+public:
+    /**
+     * @brief Receives each encoded frame, in one call per record
+     *
+     * Called on the logging task, so it must not block for long. The
+     * default writes the frame to stdout with a single fwrite().
+     */
+    typedef void (*Sink)(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Replace the output; nullptr restores the default
+     */
+    static void setSink(Sink sink);
+
+    /**
+     * @brief Records dropped because they did not fit a frame
+     */
+    static uint32_t dropped();
+
+    /**
+     * @brief Encode and emit one record; used by the logging macros
+     *
+     * Like ESP_LOGx, nothing is sent when the runtime level of tag, set
+     * with esp_log_level_set(), filters out level.
+     */
+    template <typename... Args>
+    static void write(esp_log_level_t level, const char* tag, uint32_t id, uint32_t classes,
+                      const char* format, Args... args) {
+        (void)format;  // Only its ID is sent
+        if (level > esp_log_level_get(tag)) {
+            return;
+        }
+        BinaryLogFrame frame(id, esp_log_timestamp());
+        frame.addAll(classes, args...);
+        emit(frame);
+    }
+
+    /**
+     * @brief Message ID of a log call, as tools/binary_log.py computes it
+     */
+    static constexpr uint32_t messageId(int level, const char* tag, const char* format) {
+        return hash(format, hash(tag, ((2166136261u ^ (uint8_t)level) * 16777619u)) * 16777619u) &
+               ((1u << MUTEXGUARD_BINARY_LOG_ID_BITS) - 1);
+    }
+
+    /**
+     * @brief ArgClass of the first 16 conversions of format, two bits each
+     */
+    static constexpr uint32_t argClasses(const char* format, unsigned shift = 0) {
+        return *format == '\0' || shift >= 32 ? 0
+               : *format != '%' ? argClasses(format + 1, shift)
+               : format[1] == '%' ? argClasses(format + 2, shift)
+               : ((uint32_t)classOf(*conversion(format + 1)) << shift) |
+                     argClasses(next(conversion(format + 1)), shift + 2);
+    }
+
+private:
+    static void emit(BinaryLogFrame& frame);
+
+    // FNV-1a; the '\0' separator is hashed by the caller
+    static constexpr uint32_t hash(const char* text, uint32_t value) {
+        return *text == '\0' ? value : hash(text + 1, (value ^ (uint8_t)*text) * 16777619u);
+    }
+
+    static constexpr bool isConversion(char c) {
+        return c == 'd' || c == 'i' || c == 'u' || c == 'o' || c == 'x' || c == 'X' || c == 'c' ||
+               c == 's' || c == 'p' || c == 'f' || c == 'F' || c == 'e' || c == 'E' || c == 'g' ||
+               c == 'G' || c == 'a' || c == 'A';
+    }
+
+    // First conversion character at or after spec, or the terminator
+    static constexpr const char* conversion(const char* spec) {
+        return *spec == '\0' || isConversion(*spec) ? spec : conversion(spec + 1);
+    }
+
+    static constexpr const char* next(const char* conversion) {
+        return *conversion == '\0' ? conversion : conversion + 1;
+    }
+
+    static constexpr uint8_t classOf(char c) {
+        return c == 'd' || c == 'i' ? BinaryLogFrame::kSigned
+               : c == 's' ? BinaryLogFrame::kString
+               : c == 'f' || c == 'F' || c == 'e' || c == 'E' || c == 'g' || c == 'G' ||
+                       c == 'a' || c == 'A'
+                   ? BinaryLogFrame::kDouble
+                   : BinaryLogFrame::kUnsigned;
+    }
+};
+
+#define MUTEXGUARD_BINARY_FORMAT(format, ...) format
+
+/**
+ * @brief Emit a log call as a binary record; the ID and the argument
+ *        encoding are computed at compile time
+ */
+#define MUTEXGUARD_BINARY_WRITE(level, tag, ...)                                                   \
+    (MUTEXGUARD_CHECK_FORMAT(__VA_ARGS__),                                                         \
+     BinaryLog::write(level, tag,                                                                  \
+                      std::integral_constant<uint32_t, BinaryLog::messageId(                       \
+                          level, tag, MUTEXGUARD_BINARY_FORMAT(__VA_ARGS__, 0))>::value,           \
+                      std::integral_constant<uint32_t, BinaryLog::argClasses(                      \
+                          MUTEXGUARD_BINARY_FORMAT(__VA_ARGS__, 0))>::value,                       \
+                      __VA_ARGS__))
+
+#endif // MUTEXGUARD_BINARY_LOG
+
+#endif // _BINARYLOG_H_
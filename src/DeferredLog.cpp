@@ -0,0 +1,255 @@
+#include "DeferredLog.h"
+
+#ifdef MUTEXGUARD_DEFERRED_LOG
+
+#include <stdio.h>
+
+#include <atomic>
+#include <new>
+
+#include "freertos/task.h"
+#include "MpmcQueue.h"
+
+#ifdef USE_CUSTOM_LOGGER
+#include <LogInterface.h>
+#endif
+
+static_assert(MUTEXGUARD_DEFERRED_LOG_TEXT <= 255, "MUTEXGUARD_DEFERRED_LOG_TEXT must fit in a uint8_t");
+
+namespace {
+
+typedef MpmcQueue<DeferredLogRecord, MUTEXGUARD_DEFERRED_LOG_DEPTH> RecordQueue;
+
+// Constructed in place by begin() and never destroyed: the logger task waits
+// on it for the rest of the program, also while static destructors run
+alignas(RecordQueue) unsigned char g_queueStorage[sizeof(RecordQueue)];
+RecordQueue* g_queue = nullptr;
+
+std::atomic<bool> g_running(false);
+std::atomic<DeferredLog::Sink> g_sink(nullptr);
+std::atomic<uint32_t> g_queued(0);   // Accepted by the queue
+std::atomic<uint32_t> g_emitted(0);  // Taken out and emitted by the task
+std::atomic<uint32_t> g_dropped(0);
+portMUX_TYPE g_startLock = portMUX_INITIALIZER_UNLOCKED;
+bool g_starting = false;
+
+void defaultSink(esp_log_level_t level, const char* tag, uint32_t timestampMs, const char* message) {
+#ifdef USE_CUSTOM_LOGGER
+    (void)timestampMs;
+    LOG_WRITE(level, tag, "%s", message);
+#else
+    static const char kLetters[] = "NEWIDV";
+    char letter = (unsigned)level < sizeof(kLetters) - 1 ? kLetters[level] : '?';
+    esp_log_write(level, tag, "%c (%u) %s: %s\n", letter, (unsigned)timestampMs, tag, message);
+#endif
+}
+
+void emit(const DeferredLogRecord& record) {
+    char line[MUTEXGUARD_DEFERRED_LOG_LINE];
+    record.formatTo(line, sizeof(line));
+    DeferredLog::Sink sink = g_sink.load(std::memory_order_acquire);
+    (sink != nullptr ? sink : defaultSink)((esp_log_level_t)record.level, record.tag,
+                                           record.timestampMs, line);
+}
+
+void loggerTask(void* parameter) {
+    (void)parameter;
+    uint32_t reportedDrops = 0;
+    DeferredLogRecord record;
+    for (;;) {
+        if (!g_queue->pop(record, portMAX_DELAY)) {
+            continue;
+        }
+
+        uint32_t drops = g_dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            char line[64];
+            snprintf(line, sizeof(line), "%u log messages dropped (queue full)",
+                     (unsigned)(drops - reportedDrops));
+            DeferredLog::Sink sink = g_sink.load(std::memory_order_acquire);
+            (sink != nullptr ? sink : defaultSink)(ESP_LOG_WARN, record.tag,
+                                                   record.timestampMs, line);
+            reportedDrops = drops;
+        }
+
+        emit(record);
+        g_emitted.fetch_add(1, std::memory_order_release);
+    }
+}
+
+// Append one printf conversion of arg to out; returns the new length
+size_t formatArg(char* out, size_t size, size_t length, const char* spec,
+                 const DeferredLogRecord::Arg* arg, uint8_t kind, const char* text) {
+    if (length >= size) {
+        return length;
+    }
+    char* at = out + length;
+    size_t room = size - length;
+    // A string conversion must get a copied string and vice versa (%p aside)
+    char conversion = spec[strlen(spec) - 1];
+    bool isString = kind == DeferredLogRecord::kString;
+    if (arg != nullptr && (conversion == 's') != isString && !(isString && conversion == 'p')) {
+        arg = nullptr;
+    }
+
+    int written;
+    if (arg == nullptr) {
+        written = snprintf(at, room, "?");
+    } else {
+        switch (kind) {
+            case DeferredLogRecord::kInt:       written = snprintf(at, room, spec, (int)arg->i); break;
+            case DeferredLogRecord::kUInt:      written = snprintf(at, room, spec, (unsigned)arg->u); break;
+            case DeferredLogRecord::kLong:      written = snprintf(at, room, spec, (long)arg->i); break;
+            case DeferredLogRecord::kULong:     written = snprintf(at, room, spec, (unsigned long)arg->u); break;
+            case DeferredLogRecord::kLongLong:  written = snprintf(at, room, spec, arg->i); break;
+            case DeferredLogRecord::kULongLong: written = snprintf(at, room, spec, arg->u); break;
+            case DeferredLogRecord::kDouble:    written = snprintf(at, room, spec, arg->d); break;
+            case DeferredLogRecord::kString:    written = snprintf(at, room, spec, text + arg->text); break;
+            default:                            written = snprintf(at, room, spec, arg->p); break;
+        }
+    }
+    return written > 0 ? length + (size_t)written : length;
+}
+
+} // namespace
+
+DeferredLogRecord::Arg& DeferredLogRecord::push(ArgKind kind) {
+    kinds[argCount] = kind;
+    return args[argCount++];
+}
+
+void DeferredLogRecord::addString(const char* value) {
+    if (full()) {
+        return;
+    }
+    if (value == nullptr) {
+        value = "(null)";
+    }
+    size_t room = sizeof(text) - textUsed;
+    if (room == 0) {
+        // No space left: point at the terminator of the previous copy
+        push(kString).text = sizeof(text) - 1;
+        return;
+    }
+    size_t length = strlen(value);
+    if (length >= room) {
+        length = room - 1;
+    }
+    memcpy(text + textUsed, value, length);
+    text[textUsed + length] = '\0';
+    push(kString).text = textUsed;
+    textUsed = (uint8_t)(textUsed + length + 1);
+}
+
+void DeferredLogRecord::formatTo(char* out, size_t size) const {
+    if (size == 0) {
+        return;
+    }
+    size_t length = 0;
+    size_t next = 0;
+    const char* p = format;
+    char spec[16];
+
+    while (*p != '\0' && length < size - 1) {
+        if (*p != '%') {
+            out[length++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[length++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // Copy "%[flags][width][.precision][length]conversion"
+        size_t specLength = 0;
+        spec[specLength++] = *p++;
+        while (*p != '\0' && strchr("diouxXcsfFeEgGaAp", *p) == nullptr) {
+            if (specLength < sizeof(spec) - 2) {
+                spec[specLength++] = *p;
+            }
+            p++;
+        }
+        if (*p == '\0') {
+            break;
+        }
+        spec[specLength++] = *p++;
+        spec[specLength] = '\0';
+
+        const Arg* arg = next < argCount ? &args[next] : nullptr;
+        uint8_t kind = next < argCount ? kinds[next] : 0;
+        next++;
+        length = formatArg(out, size, length, spec, arg, kind, text);
+    }
+    out[length < size ? length : size - 1] = '\0';
+}
+
+bool DeferredLog::begin(UBaseType_t priority, uint32_t stackSize) {
+    portENTER_CRITICAL(&g_startLock);
+    bool start = !g_running.load(std::memory_order_relaxed) && !g_starting;
+    g_starting = g_starting || start;
+    portEXIT_CRITICAL(&g_startLock);
+    if (!start) {
+        return g_running.load(std::memory_order_acquire);
+    }
+
+    if (g_queue == nullptr) {
+        g_queue = new (g_queueStorage) RecordQueue();
+    }
+    bool created = g_queue->isValid() &&
+                   xTaskCreate(loggerTask, "mutexg_log", stackSize, NULL, priority, NULL) == pdPASS;
+    g_running.store(created, std::memory_order_release);
+
+    portENTER_CRITICAL(&g_startLock);
+    g_starting = false;
+    portEXIT_CRITICAL(&g_startLock);
+    return created;
+}
+
+bool DeferredLog::isRunning() {
+    return g_running.load(std::memory_order_acquire);
+}
+
+void DeferredLog::setSink(Sink sink) {
+    g_sink.store(sink, std::memory_order_release);
+}
+
+bool DeferredLog::flush(TickType_t timeout) {
+    TickType_t start = xTaskGetTickCount();
+    while (g_emitted.load(std::memory_order_acquire) != g_queued.load(std::memory_order_acquire)) {
+        if (!isRunning() || xTaskGetTickCount() - start >= timeout) {
+            return false;
+        }
+        vTaskDelay(1);
+    }
+    return true;
+}
+
+uint32_t DeferredLog::dropped() {
+    return g_dropped.load(std::memory_order_relaxed);
+}
+
+void DeferredLog::submit(DeferredLogRecord& record) {
+    record.timestampMs = esp_log_timestamp();
+
+    if (!g_running.load(std::memory_order_acquire)) {
+        emit(record);
+        return;
+    }
+
+    bool queued;
+    if (xPortInIsrContext()) {
+        // The logger task has low priority; no need to switch to it from the ISR
+        queued = g_queue->pushFromISR(record, nullptr);
+    } else {
+        queued = g_queue->tryPush(record);
+    }
+
+    if (queued) {
+        g_queued.fetch_add(1, std::memory_order_release);
+    } else {
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+#endif // MUTEXGUARD_DEFERRED_LOG
@@ -0,0 +1,219 @@
+#ifndef _DEFERREDLOG_H_
+#define _DEFERREDLOG_H_
+
+/**
+ * @file DeferredLog.h
+ * @brief Opt-in backend that formats MUTEXG_LOG_* / RMUTEXG_LOG_* messages later
+ *
+ * Compiled out unless MUTEXGUARD_DEFERRED_LOG is defined for the whole build
+ * (library and application), e.g. `build_flags = -DMUTEXGUARD_DEFERRED_LOG`.
+ */
+
+#ifdef MUTEXGUARD_DEFERRED_LOG
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <type_traits>
+
+#include <esp_log.h>
+#include "freertos/FreeRTOS.h"
+#include "LogArgs.h"
+
+#ifndef MUTEXGUARD_DEFERRED_LOG_DEPTH
+#define MUTEXGUARD_DEFERRED_LOG_DEPTH 32  ///< Queued messages (power of two)
+#endif
+
+#ifndef MUTEXGUARD_DEFERRED_LOG_MAX_ARGS
+#define MUTEXGUARD_DEFERRED_LOG_MAX_ARGS 6  ///< Arguments kept per message
+#endif
+
+#ifndef MUTEXGUARD_DEFERRED_LOG_TEXT
+#define MUTEXGUARD_DEFERRED_LOG_TEXT 64  ///< Bytes for copies of the %s arguments
+#endif
+
+#ifndef MUTEXGUARD_DEFERRED_LOG_LINE
+#define MUTEXGUARD_DEFERRED_LOG_LINE 160  ///< Longest formatted message
+#endif
+
+/**
+ * @brief One captured log call: format pointer plus raw arguments
+ */
+struct DeferredLogRecord {
+    enum ArgKind : uint8_t {
+        kInt, kUInt, kLong, kULong, kLongLong, kULongLong, kDouble, kPointer, kString
+    };
+
+    union Arg {
+        long long i;
+        unsigned long long u;
+        double d;
+        const void* p;
+        uint32_t text;  ///< Offset into text for kString
+    };
+
+    const char* tag;
+    const char* format;        ///< Must be a string literal, it is read later
+    uint32_t timestampMs;      ///< esp_log_timestamp() of the call
+    uint8_t level;             ///< An esp_log_level_t
+    uint8_t argCount;
+    uint8_t textUsed;
+    uint8_t kinds[MUTEXGUARD_DEFERRED_LOG_MAX_ARGS];
+    Arg args[MUTEXGUARD_DEFERRED_LOG_MAX_ARGS];
+    char text[MUTEXGUARD_DEFERRED_LOG_TEXT];  ///< %s arguments, copied at the call
+
+    // Argument capture: integers keep their promoted type, so the later
+    // printf call sees exactly what the original one would have. Arguments
+    // beyond MUTEXGUARD_DEFERRED_LOG_MAX_ARGS are dropped without a write.
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    add(T value) {
+        typedef typename LogArgs::Promoted<T>::type Promoted;
+        if (full()) {
+            return;
+        }
+        if (std::is_signed<Promoted>::value) {
+            push(sizeof(Promoted) == sizeof(int) ? kInt
+                 : sizeof(Promoted) == sizeof(long) ? kLong : kLongLong).i = (long long)value;
+        } else {
+            push(sizeof(Promoted) == sizeof(unsigned) ? kUInt
+                 : sizeof(Promoted) == sizeof(unsigned long) ? kULong : kULongLong).u =
+                (unsigned long long)value;
+        }
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type add(T value) {
+        if (!full()) {
+            push(kDouble).d = value;
+        }
+    }
+
+    void add(const char* value) { addString(value); }
+    void add(char* value) { addString(value); }
+    void add(const void* value) {
+        if (!full()) {
+            push(kPointer).p = value;
+        }
+    }
+    void add(std::nullptr_t) { add((const void*)nullptr); }
+
+    void addAll() {}
+
+    template <typename T, typename... Rest>
+    void addAll(T first, Rest... rest) {
+        add(first);
+        addAll(rest...);
+    }
+
+    /**
+     * @brief Format the message into out (always terminated)
+     */
+    void formatTo(char* out, size_t size) const;
+
+private:
+    bool full() const { return argCount >= MUTEXGUARD_DEFERRED_LOG_MAX_ARGS; }
+
+    // Only called with room left, see full()
+    Arg& push(ArgKind kind);
+    void addString(const char* value);
+};
+
+/**
+ * @brief Moves the formatting and printing of guard log messages to a task
+ *
+ * With MUTEX_GUARD_DEBUG, every lock and unlock logs a line. Formatting and
+ * printing that line takes long enough to inflate the hold times being
+ * debugged. With MUTEXGUARD_DEFERRED_LOG, the MUTEXG_LOG_* and
+ * RMUTEXG_LOG_* macros only capture the call. The record keeps the format
+ * pointer, the raw arguments and a copy of every %s string, because names
+ * from MUTEXG_NAME() may live in a rotating buffer. The record is pushed
+ * into a lock-free MpmcQueue. A low-priority task started by begin()
+ * formats each record later and emits it. Records keep their original
+ * timestamp and tag, so the output reads like the synchronous log.
+ *
+ * A caller never waits: when the queue is full, the message is dropped and
+ * counted, and the task reports the count with its next message. Calls from
+ * an ISR are queued the same way. Until begin() has succeeded, messages are
+ * formatted and emitted at once.
+ *
+ * Limits: format strings must be literals (all library call sites are).
+ * `*` widths are not supported. At most MUTEXGUARD_DEFERRED_LOG_MAX_ARGS
+ * arguments are kept; the rest print as "?". %s copies share
+ * MUTEXGUARD_DEFERRED_LOG_TEXT bytes and are truncated beyond that.
+ *
+ * Usage:
+ * @code
+ * // build_flags = -DMUTEXGUARD_DEFERRED_LOG -DMUTEX_GUARD_DEBUG
+ * void setup() {
+ *     DeferredLog::begin();           // Priority 1, below the application tasks
+ *     ...
+ * }
+ * @endcode
+ */
+class DeferredLog {
+public:
+    /**
+     * @brief Receives every formatted message
+     *
+     * The default writes through esp_log_write() in the ESP-IDF layout, or
+     * through LOG_WRITE with USE_CUSTOM_LOGGER.
+     */
+    typedef void (*Sink)(esp_log_level_t level, const char* tag, uint32_t timestampMs,
+                         const char* message);
+
+    /**
+     * @brief Start the task that formats and emits queued messages
+     *
+     * @return true if the task runs (also when it already did)
+     */
+    static bool begin(UBaseType_t priority = 1, uint32_t stackSize = 3072);
+
+    static bool isRunning();
+
+    /**
+     * @brief Replace the output; nullptr restores the default
+     */
+    static void setSink(Sink sink);
+
+    /**
+     * @brief Wait until every queued message has been emitted
+     *
+     * @return false on timeout
+     */
+    static bool flush(TickType_t timeout = pdMS_TO_TICKS(1000));
+
+    /**
+     * @brief Messages dropped because the queue was full
+     */
+    static uint32_t dropped();
+
+    /**
+     * @brief Capture one message; used by the logging macros
+     */
+    template <typename... Args>
+    static void write(esp_log_level_t level, const char* tag, const char* format, Args... args) {
+        DeferredLogRecord record;
+        record.tag = tag;
+        record.format = format;
+        record.level = (uint8_t)level;
+        record.argCount = 0;
+        record.textUsed = 0;
+        record.addAll(args...);
+        submit(record);
+    }
+
+private:
+    static void submit(DeferredLogRecord& record);
+};
+
+/**
+ * @brief Capture a log call; the arguments are format-checked like printf
+ */
+#define MUTEXGUARD_DEFERRED_WRITE(level, tag, ...) \
+    (MUTEXGUARD_CHECK_FORMAT(__VA_ARGS__), DeferredLog::write(level, tag, __VA_ARGS__))
+
+#endif // MUTEXGUARD_DEFERRED_LOG
+
+#endif // _DEFERREDLOG_H_
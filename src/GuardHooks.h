@@ -0,0 +1,263 @@
+#ifndef _GUARDHOOKS_H_
+#define _GUARDHOOKS_H_
+
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "HoldWatchdog.h"
+#include "LockDep.h"
+#include "LockTrace.h"
+#include "MutexGuardStats.h"
+
+/**
+ * @brief Call site for GuardHooks, or nullptr when no enabled hook uses it
+ *
+ * Must be expanded in the function whose caller is the acquisition site:
+ * a guard constructor or lock method that is not inlined.
+ */
+#if defined(MUTEXGUARD_LOCKDEP) || defined(MUTEXGUARD_HOLD_WATCHDOG)
+#define MUTEXGUARD_GUARD_SITE() MUTEXGUARD_CALL_SITE()
+#else
+#define MUTEXGUARD_GUARD_SITE() nullptr
+#endif
+
+/**
+ * @brief Keeps a header-defined guard constructor out of line when it needs its call site
+ *
+ * Inlined, the constructor would read the return address of the function
+ * that constructs the guard, not the guard's own line. Builds without
+ * lockdep or the hold watchdog keep the constructor inlinable.
+ */
+#if (defined(MUTEXGUARD_LOCKDEP) || defined(MUTEXGUARD_HOLD_WATCHDOG)) && defined(__GNUC__)
+#define MUTEXGUARD_SITE_NOINLINE __attribute__((noinline))
+#else
+#define MUTEXGUARD_SITE_NOINLINE
+#endif
+
+/**
+ * @brief Diagnostic hooks every guard runs around its own take and give
+ *
+ * Lockdep, contention statistics, the hold-time watchdog and the lock trace
+ * need the same calls in the same order whatever the lock is: order check
+ * and wait event before blocking, wait time and ownership after the take,
+ * hold time and release event before the give and the release records
+ * after it. Each guard keeps one GuardHooks next to its lock state and
+ * supplies only the take and give; hooks whose feature flag is off compile
+ * to nothing, and the object is then empty.
+ *
+ * Guards usually call acquire() and release(). A guard that takes several
+ * locks as one (MultiMutexGuard) calls the acquisition phases per handle
+ * itself.
+ *
+ * Usage:
+ * @code
+ * m_taken = m_hooks.acquire(m_mutex->handle(), MUTEXGUARD_GUARD_SITE(), false,
+ *                           [&] { return m_mutex->lock(timeout); });
+ * ...
+ * m_hooks.release(m_mutex->handle(), [&] { m_mutex->unlock(); });
+ * @endcode
+ */
+class GuardHooks {
+public:
+    /**
+     * @brief Times taken just before a give, reported just after it
+     */
+    struct HoldTimes {
+#ifdef MUTEXGUARD_STATS
+        uint32_t holdUs;
+#endif
+#ifdef MUTEXGUARD_HOLD_WATCHDOG
+        uint32_t watchedUs;
+#endif
+    };
+
+    GuardHooks() noexcept {
+#ifdef MUTEXGUARD_STATS
+        m_acquiredAtUs = 0;
+#endif
+#ifdef MUTEXGUARD_HOLD_WATCHDOG
+        m_holdWatch.callSite = nullptr;
+        m_holdWatch.acquiredAtUs = 0;
+#endif
+    }
+
+    /**
+     * @brief Run take() between the acquisition hooks
+     *
+     * @param handle Identity of the lock for lockdep and statistics
+     * @param callSite MUTEXGUARD_GUARD_SITE() of the guard
+     * @param recursive Whether the lock may be re-taken by its owner
+     * @param take Callable returning true if the lock was taken
+     */
+    template <typename Take>
+    bool acquire(SemaphoreHandle_t handle, const void* callSite, bool recursive, Take take) {
+        uint32_t waitStartUs = beforeTake(handle, callSite, recursive);
+        bool taken = take();
+        afterTake(handle, callSite, taken, waitStartUs);
+        return taken;
+    }
+
+    /**
+     * @brief Run give() between the release hooks
+     */
+    template <typename Give>
+    void release(SemaphoreHandle_t handle, Give give) {
+        HoldTimes held = beforeGive(handle);
+        give();
+        afterGive(handle, held);
+    }
+
+    /**
+     * @brief Before blocking: lock-order check, wait start and wait event
+     * @return Wait start time to pass to afterTake()
+     */
+    uint32_t beforeTake(SemaphoreHandle_t handle, const void* callSite, bool recursive) {
+        (void)handle;
+        (void)callSite;
+        (void)recursive;
+#ifdef MUTEXGUARD_LOCKDEP
+        // Checked before blocking so a real deadlock is still reported
+        LockDep::beforeAcquire(handle, callSite, recursive);
+#endif
+#ifdef MUTEXGUARD_STATS
+        uint32_t waitStartUs = MutexGuardStats::nowUs();
+#else
+        uint32_t waitStartUs = 0;
+#endif
+#ifdef MUTEXGUARD_TRACE
+        LockTrace::record(LOCK_TRACE_WAIT, handle);
+#endif
+        return waitStartUs;
+    }
+
+    /**
+     * @brief After the take: outcome event, ownership, wait time and hold-budget start
+     */
+    void afterTake(SemaphoreHandle_t handle, const void* callSite, bool taken, uint32_t waitStartUs) {
+        (void)handle;
+        (void)callSite;
+        (void)taken;
+        (void)waitStartUs;
+#ifdef MUTEXGUARD_TRACE
+        LockTrace::record(taken ? LOCK_TRACE_ACQUIRED : LOCK_TRACE_TIMEOUT, handle);
+#endif
+#ifdef MUTEXGUARD_LOCKDEP
+        if (taken) {
+            LockDep::acquired(handle, callSite);
+        }
+#endif
+#ifdef MUTEXGUARD_STATS
+        m_acquiredAtUs = MutexGuardStats::nowUs();
+        MutexGuardStats::recordAcquire(handle, m_acquiredAtUs - waitStartUs, taken);
+#endif
+#ifdef MUTEXGUARD_HOLD_WATCHDOG
+        if (taken) {
+            m_holdWatch.start(callSite);
+        }
+#endif
+    }
+
+    /**
+     * @brief End a wait begun by beforeTake() whose lock will not be taken
+     *
+     * For a guard that gives up on a lock because another one timed out:
+     * the trace shows the wait ending, but no timeout is counted for it.
+     */
+    void abandonTake(SemaphoreHandle_t handle) {
+        (void)handle;
+#ifdef MUTEXGUARD_TRACE
+        LockTrace::record(LOCK_TRACE_TIMEOUT, handle);
+#endif
+    }
+
+    /**
+     * @brief Hold times, measured before the give so they exclude it, and the release event
+     *
+     * The event is recorded before the give, so the next owner's slice
+     * starts after this one ends.
+     */
+    HoldTimes beforeGive(SemaphoreHandle_t handle) const {
+        (void)handle;
+        HoldTimes held;
+#ifdef MUTEXGUARD_STATS
+        held.holdUs = MutexGuardStats::nowUs() - m_acquiredAtUs;
+#endif
+#ifdef MUTEXGUARD_HOLD_WATCHDOG
+        held.watchedUs = m_holdWatch.elapsedUs();
+#endif
+#ifdef MUTEXGUARD_TRACE
+        LockTrace::record(LOCK_TRACE_RELEASED, handle);
+#endif
+        return held;
+    }
+
+    /**
+     * @brief After the give: hold statistics, ownership and hold-budget check
+     *
+     * Runs after the give, so a report never lengthens the critical section.
+     */
+    void afterGive(SemaphoreHandle_t handle, const HoldTimes& held) const {
+        (void)handle;
+        (void)held;
+#ifdef MUTEXGUARD_STATS
+        MutexGuardStats::recordRelease(handle, held.holdUs);
+#endif
+#ifdef MUTEXGUARD_LOCKDEP
+        LockDep::released(handle);
+#endif
+#ifdef MUTEXGUARD_HOLD_WATCHDOG
+        HoldWatchdog::checkRelease(handle, m_holdWatch.callSite, held.watchedUs);
+#endif
+    }
+
+    /**
+     * @brief The guard takes over a lock the task already holds
+     *
+     * Hold time and budget restart here; no wait is recorded, and the
+     * trace starts a hold.
+     */
+    void adopted(SemaphoreHandle_t handle, const void* callSite) {
+        (void)handle;
+        (void)callSite;
+#ifdef MUTEXGUARD_TRACE
+        LockTrace::record(LOCK_TRACE_ACQUIRED, handle);
+#endif
+#ifdef MUTEXGUARD_LOCKDEP
+        LockDep::acquired(handle, callSite);
+#endif
+#ifdef MUTEXGUARD_STATS
+        m_acquiredAtUs = MutexGuardStats::nowUs();
+#endif
+#ifdef MUTEXGUARD_HOLD_WATCHDOG
+        m_holdWatch.start(callSite);
+#endif
+    }
+
+    /**
+     * @brief The guard hands a held lock to its caller without giving it
+     *
+     * The task still holds the lock, but no guard accounts for it any more;
+     * it leaves lockdep's held stack so the caller's own give (or a later
+     * adopted()) keeps the stack balanced. The trace ends the guard's hold.
+     */
+    void detached(SemaphoreHandle_t handle) {
+        (void)handle;
+#ifdef MUTEXGUARD_TRACE
+        LockTrace::record(LOCK_TRACE_RELEASED, handle);
+#endif
+#ifdef MUTEXGUARD_LOCKDEP
+        LockDep::released(handle);
+#endif
+    }
+
+private:
+#ifdef MUTEXGUARD_STATS
+    uint32_t m_acquiredAtUs;  ///< Acquisition time, for hold-time statistics
+#endif
+#ifdef MUTEXGUARD_HOLD_WATCHDOG
+    HoldWatch m_holdWatch;  ///< Acquisition site and time, for the hold budget
+#endif
+};
+
+#endif // _GUARDHOOKS_H_
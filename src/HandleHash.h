@@ -0,0 +1,23 @@
+#ifndef _HANDLEHASH_H_
+#define _HANDLEHASH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Home slot of a handle in an open-addressed table of tableSize slots
+ *
+ * Internal helper shared by the handle-keyed tables (MutexRegistry,
+ * MutexGuardStats). Handles are object addresses: heap pointers for
+ * xSemaphoreCreate*(), static storage for StaticMutex, and static or stack
+ * memory for NotifyMutex. All of them are word aligned, so the low bits
+ * carry little information; they are dropped and the rest is mixed with a
+ * Fibonacci multiplier.
+ */
+inline size_t mutexguardHomeSlot(const void* handle, size_t tableSize) {
+    uint32_t key = (uint32_t)((uintptr_t)handle >> 3);
+    key *= 0x9E3779B1u;
+    return (size_t)(key >> 16) % tableSize;
+}
+
+#endif // _HANDLEHASH_H_
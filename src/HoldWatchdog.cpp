@@ -0,0 +1,190 @@
+#include "HoldWatchdog.h"
+
+#ifdef MUTEXGUARD_HOLD_WATCHDOG
+
+#include <string.h>
+
+#include <atomic>
+
+#include "freertos/task.h"
+#include "MutexGuardLogging.h"
+#include "MutexRegistry.h"
+
+namespace {
+
+struct BudgetSlot {
+    std::atomic<SemaphoreHandle_t> handle;
+    std::atomic<uint32_t> budgetUs;
+};
+
+// Slots are appended under g_lock and only cleared by clearBudgets(), so a
+// lookup can scan the first g_budgetCount entries without locking
+BudgetSlot g_budgets[MUTEXGUARD_HOLD_WATCHDOG_MAX_BUDGETS];
+std::atomic<size_t> g_budgetCount(0);
+std::atomic<uint32_t> g_defaultBudgetUs(0);
+
+HoldViolation g_events[MUTEXGUARD_HOLD_WATCHDOG_EVENTS];
+uint32_t g_eventCount = 0;  // Total recorded since reset, guarded by g_lock
+portMUX_TYPE g_lock = portMUX_INITIALIZER_UNLOCKED;
+
+std::atomic<uint32_t> g_violations(0);
+std::atomic<HoldWatchdog::ReportHandler> g_handler(nullptr);
+
+// Rate limit of the default handler
+std::atomic<bool> g_hasLogged(false);
+std::atomic<uint32_t> g_lastLogUs(0);
+std::atomic<uint32_t> g_pendingSuppressed(0);
+std::atomic<uint32_t> g_suppressed(0);
+
+BudgetSlot* findBudget(SemaphoreHandle_t handle) {
+    size_t count = g_budgetCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        if (g_budgets[i].handle.load(std::memory_order_relaxed) == handle) {
+            return &g_budgets[i];
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+bool HoldWatchdog::setBudget(SemaphoreHandle_t handle, uint32_t budgetUs) {
+    if (handle == nullptr) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&g_lock);
+    BudgetSlot* slot = findBudget(handle);
+    size_t count = g_budgetCount.load(std::memory_order_relaxed);
+    if (slot == nullptr && count < MUTEXGUARD_HOLD_WATCHDOG_MAX_BUDGETS) {
+        slot = &g_budgets[count];
+        slot->handle.store(handle, std::memory_order_relaxed);
+        slot->budgetUs.store(budgetUs, std::memory_order_relaxed);
+        g_budgetCount.store(count + 1, std::memory_order_release);
+    } else if (slot != nullptr) {
+        slot->budgetUs.store(budgetUs, std::memory_order_relaxed);
+    }
+    portEXIT_CRITICAL(&g_lock);
+
+    if (slot == nullptr) {
+        MUTEXG_LOG_W("No room for a hold budget for mutex '%s' (max %d)", MUTEXG_NAME(handle),
+                     MUTEXGUARD_HOLD_WATCHDOG_MAX_BUDGETS);
+        return false;
+    }
+    return true;
+}
+
+void HoldWatchdog::setDefaultBudget(uint32_t budgetUs) {
+    g_defaultBudgetUs.store(budgetUs, std::memory_order_relaxed);
+}
+
+uint32_t HoldWatchdog::budget(SemaphoreHandle_t handle) {
+    BudgetSlot* slot = findBudget(handle);
+    uint32_t budgetUs = slot != nullptr ? slot->budgetUs.load(std::memory_order_relaxed) : 0;
+    MutexInfo info;
+    if (budgetUs == 0 && MutexRegistry::lookup(handle, info)) {
+        budgetUs = info.maxHoldUs;
+    }
+    return budgetUs != 0 ? budgetUs : g_defaultBudgetUs.load(std::memory_order_relaxed);
+}
+
+void HoldWatchdog::setReportHandler(ReportHandler handler) {
+    g_handler.store(handler, std::memory_order_release);
+}
+
+void HoldWatchdog::logViolation(const HoldViolation& violation) {
+    const uint32_t intervalUs = (uint32_t)MUTEXGUARD_HOLD_WATCHDOG_LOG_INTERVAL_MS * 1000u;
+    uint32_t last = g_lastLogUs.load(std::memory_order_relaxed);
+    bool due = !g_hasLogged.load(std::memory_order_relaxed) ||
+               violation.releasedAtUs - last >= intervalUs;
+
+    // One reporter per interval; the others only count
+    if (!due || !g_lastLogUs.compare_exchange_strong(last, violation.releasedAtUs,
+                                                     std::memory_order_relaxed)) {
+        g_pendingSuppressed.fetch_add(1, std::memory_order_relaxed);
+        g_suppressed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    g_hasLogged.store(true, std::memory_order_relaxed);
+
+    MUTEXG_LOG_W("Mutex '%s' held for %u us (budget %u us) by task '%s', acquired at %p",
+                 MUTEXG_NAME(violation.handle), (unsigned)violation.holdUs,
+                 (unsigned)violation.budgetUs, violation.taskName, violation.callSite);
+
+    uint32_t suppressed = g_pendingSuppressed.exchange(0, std::memory_order_relaxed);
+    if (suppressed > 0) {
+        MUTEXG_LOG_W("  %u more hold-time violations since the last report", (unsigned)suppressed);
+    }
+}
+
+uint32_t HoldWatchdog::violations() {
+    return g_violations.load(std::memory_order_relaxed);
+}
+
+uint32_t HoldWatchdog::suppressedReports() {
+    return g_suppressed.load(std::memory_order_relaxed);
+}
+
+size_t HoldWatchdog::recentViolations(HoldViolation* out, size_t capacity) {
+    portENTER_CRITICAL(&g_lock);
+    uint32_t stored = g_eventCount < MUTEXGUARD_HOLD_WATCHDOG_EVENTS ? g_eventCount
+                                                                     : MUTEXGUARD_HOLD_WATCHDOG_EVENTS;
+    size_t count = stored < capacity ? stored : capacity;
+    // Newest `count` events, oldest first
+    uint32_t first = g_eventCount - (uint32_t)count;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = g_events[(first + i) % MUTEXGUARD_HOLD_WATCHDOG_EVENTS];
+    }
+    portEXIT_CRITICAL(&g_lock);
+    return count;
+}
+
+void HoldWatchdog::reset() {
+    portENTER_CRITICAL(&g_lock);
+    g_eventCount = 0;
+    portEXIT_CRITICAL(&g_lock);
+    g_violations.store(0, std::memory_order_relaxed);
+    g_hasLogged.store(false, std::memory_order_relaxed);
+    g_pendingSuppressed.store(0, std::memory_order_relaxed);
+    g_suppressed.store(0, std::memory_order_relaxed);
+}
+
+void HoldWatchdog::clearBudgets() {
+    portENTER_CRITICAL(&g_lock);
+    size_t count = g_budgetCount.load(std::memory_order_relaxed);
+    g_budgetCount.store(0, std::memory_order_release);
+    for (size_t i = 0; i < count; i++) {
+        g_budgets[i].handle.store(nullptr, std::memory_order_relaxed);
+        g_budgets[i].budgetUs.store(0, std::memory_order_relaxed);
+    }
+    portEXIT_CRITICAL(&g_lock);
+    g_defaultBudgetUs.store(0, std::memory_order_relaxed);
+}
+
+void HoldWatchdog::checkRelease(SemaphoreHandle_t handle, const void* callSite, uint32_t holdUs) {
+    uint32_t budgetUs = budget(handle);
+    if (budgetUs == 0 || holdUs <= budgetUs) {
+        return;
+    }
+
+    HoldViolation violation;
+    violation.handle = handle;
+    violation.callSite = callSite;
+    const char* taskName = pcTaskGetName(NULL);
+    strncpy(violation.taskName, taskName != nullptr ? taskName : "?", sizeof(violation.taskName) - 1);
+    violation.taskName[sizeof(violation.taskName) - 1] = '\0';
+    violation.holdUs = holdUs;
+    violation.budgetUs = budgetUs;
+    violation.releasedAtUs = nowUs();
+
+    portENTER_CRITICAL(&g_lock);
+    g_events[g_eventCount % MUTEXGUARD_HOLD_WATCHDOG_EVENTS] = violation;
+    g_eventCount++;
+    portEXIT_CRITICAL(&g_lock);
+    g_violations.fetch_add(1, std::memory_order_relaxed);
+
+    ReportHandler handler = g_handler.load(std::memory_order_acquire);
+    (handler != nullptr ? handler : logViolation)(violation);
+}
+
+#endif // MUTEXGUARD_HOLD_WATCHDOG
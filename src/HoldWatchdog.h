@@ -0,0 +1,178 @@
+#ifndef _HOLDWATCHDOG_H_
+#define _HOLDWATCHDOG_H_
+
+/**
+ * @file HoldWatchdog.h
+ * @brief Opt-in hold-time budgets checked by the guards on release
+ *
+ * Compiled out unless MUTEXGUARD_HOLD_WATCHDOG is defined for the whole
+ * build (library and application), e.g.
+ * `build_flags = -DMUTEXGUARD_HOLD_WATCHDOG`.
+ */
+
+#ifdef MUTEXGUARD_HOLD_WATCHDOG
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "LockDep.h"
+
+#ifndef MUTEXGUARD_HOLD_WATCHDOG_MAX_BUDGETS
+#define MUTEXGUARD_HOLD_WATCHDOG_MAX_BUDGETS 16  ///< Mutexes with their own budget
+#endif
+
+#ifndef MUTEXGUARD_HOLD_WATCHDOG_EVENTS
+#define MUTEXGUARD_HOLD_WATCHDOG_EVENTS 16  ///< Most recent violations kept for recentViolations()
+#endif
+
+#ifndef MUTEXGUARD_HOLD_WATCHDOG_LOG_INTERVAL_MS
+#define MUTEXGUARD_HOLD_WATCHDOG_LOG_INTERVAL_MS 1000  ///< Minimum time between two logged violations
+#endif
+
+#ifndef MUTEXGUARD_HOLD_WATCHDOG_TASK_NAME_LEN
+#ifdef configMAX_TASK_NAME_LEN
+#define MUTEXGUARD_HOLD_WATCHDOG_TASK_NAME_LEN configMAX_TASK_NAME_LEN  ///< Bytes kept of the task name
+#else
+#define MUTEXGUARD_HOLD_WATCHDOG_TASK_NAME_LEN 16
+#endif
+#endif
+
+/**
+ * @brief A critical section that took longer than its budget
+ */
+struct HoldViolation {
+    SemaphoreHandle_t handle;  ///< The mutex that was held
+    const void* callSite;      ///< Where the guard acquired it (see LockDep for addr2line)
+    char taskName[MUTEXGUARD_HOLD_WATCHDOG_TASK_NAME_LEN];  ///< Task that held it (a copy; the task may be gone)
+    uint32_t holdUs;           ///< How long it was held
+    uint32_t budgetUs;         ///< The budget it exceeded
+    uint32_t releasedAtUs;     ///< esp_timer time of the release
+};
+
+/**
+ * @brief Flags critical sections that hold a mutex longer than a budget
+ *
+ * A slow critical section (a vTaskDelay(), a flash write, a log call under
+ * the lock) usually goes unnoticed until every other task on that mutex
+ * misses its deadline. With MUTEXGUARD_HOLD_WATCHDOG, every guard notes
+ * when and where it acquired its lock. On unlock() or destruction, it
+ * compares the hold time against the mutex's budget. An overrun becomes a
+ * HoldViolation with the call site and the duration. The event is kept in a
+ * small ring and passed to the report handler.
+ *
+ * The default handler logs through MUTEXG_LOG_W, at most once per
+ * MUTEXGUARD_HOLD_WATCHDOG_LOG_INTERVAL_MS. The next logged line gives the
+ * number of violations suppressed since the previous one, so a section that
+ * overruns on every call cannot flood the log.
+ *
+ * A mutex's budget is, in this order: the one given to setBudget(), the
+ * maxHoldUs it was registered with in MutexRegistry, or the global
+ * setDefaultBudget(). All start at 0, which means no budget. The check
+ * runs after the mutex is released, so reporting never lengthens the
+ * critical section.
+ *
+ * Usage:
+ * @code
+ * // build_flags = -DMUTEXGUARD_HOLD_WATCHDOG
+ * HoldWatchdog::setDefaultBudget(1000);       // 1 ms for every mutex
+ * HoldWatchdog::setBudget(flashMutex, 50000); // Flash writes may take 50 ms
+ *
+ * {
+ *     MutexGuard lock(sensorMutex);
+ *     vTaskDelay(1);  // Logged: "Mutex 'sensor' held for 1000+ us (budget 1000 us) ..."
+ * }
+ * @endcode
+ */
+class HoldWatchdog {
+public:
+    typedef void (*ReportHandler)(const HoldViolation& violation);
+
+    /**
+     * @brief Set the hold budget of one mutex, overriding the default
+     *
+     * @param budgetUs Longest allowed hold in microseconds; 0 removes the
+     *        override, UINT32_MAX exempts the mutex
+     * @return false if MUTEXGUARD_HOLD_WATCHDOG_MAX_BUDGETS mutexes already have one
+     */
+    static bool setBudget(SemaphoreHandle_t handle, uint32_t budgetUs);
+
+    /**
+     * @brief Set the budget of every mutex without its own; 0 disables it
+     */
+    static void setDefaultBudget(uint32_t budgetUs);
+
+    /**
+     * @brief The budget that applies to a mutex, 0 if none
+     *
+     * setBudget() first, then the MutexRegistry maxHoldUs, then the default.
+     */
+    static uint32_t budget(SemaphoreHandle_t handle);
+
+    /**
+     * @brief Replace the report handler
+     * @param handler Called after the release for every violation;
+     *                nullptr restores the default (logViolation)
+     */
+    static void setReportHandler(ReportHandler handler);
+
+    /**
+     * @brief Default handler: rate-limited warning through MUTEXG_LOG_W
+     */
+    static void logViolation(const HoldViolation& violation);
+
+    /**
+     * @brief Number of violations since the last reset()
+     */
+    static uint32_t violations();
+
+    /**
+     * @brief Violations the default handler did not log because of the rate limit
+     */
+    static uint32_t suppressedReports();
+
+    /**
+     * @brief Copy the most recent violations, oldest first
+     * @return Number of entries written (at most MUTEXGUARD_HOLD_WATCHDOG_EVENTS)
+     */
+    static size_t recentViolations(HoldViolation* out, size_t capacity);
+
+    /**
+     * @brief Clear the recorded violations, counters and rate limit; budgets stay
+     */
+    static void reset();
+
+    /**
+     * @brief Remove every per-mutex budget and the default budget
+     *
+     * Call this when no guards are active, e.g. after deleting mutexes.
+     */
+    static void clearBudgets();
+
+    /// @name Hooks used by the guards
+    /// @{
+    static uint32_t nowUs() { return (uint32_t)esp_timer_get_time(); }
+    static void checkRelease(SemaphoreHandle_t handle, const void* callSite, uint32_t holdUs);
+    /// @}
+};
+
+/**
+ * @brief Per-guard record of where and when the lock was taken
+ */
+struct HoldWatch {
+    const void* callSite;
+    uint32_t acquiredAtUs;
+
+    void start(const void* site) {
+        callSite = site;
+        acquiredAtUs = HoldWatchdog::nowUs();
+    }
+
+    uint32_t elapsedUs() const { return HoldWatchdog::nowUs() - acquiredAtUs; }
+};
+
+#endif // MUTEXGUARD_HOLD_WATCHDOG
+
+#endif // _HOLDWATCHDOG_H_
@@ -0,0 +1,146 @@
+#ifndef _LATENCYHISTOGRAM_H_
+#define _LATENCYHISTOGRAM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#ifndef MUTEXGUARD_HISTOGRAM_SUB_BUCKET_BITS
+#define MUTEXGUARD_HISTOGRAM_SUB_BUCKET_BITS 2  ///< 4 sub-buckets per power of two (<= 25% error)
+#endif
+
+#ifndef MUTEXGUARD_HISTOGRAM_MAX_BITS
+#define MUTEXGUARD_HISTOGRAM_MAX_BITS 24  ///< Values from 2^24 (~16.7 s in us) share one overflow bucket
+#endif
+
+/**
+ * @brief Fixed-memory, log-bucketed latency histogram (HDR-style)
+ *
+ * Values below 2^SUB_BUCKET_BITS get exact buckets. Above that, every power
+ * of two is split into 2^SUB_BUCKET_BITS linear sub-buckets, so the relative
+ * error is bounded by 1 / 2^SUB_BUCKET_BITS across the whole range. Values
+ * of 2^MAX_BITS and above land in a single overflow bucket.
+ *
+ * record() is one relaxed atomic increment: it never blocks and needs no
+ * heap. Reads go through a Snapshot copy, which may straddle concurrent
+ * records but never sees torn counters. Instances with static storage
+ * start zeroed; call reset() before using any other instance.
+ *
+ * Usage:
+ * @code
+ * static LatencyHistogram hist;
+ * hist.record(elapsedUs);
+ *
+ * LatencyHistogram::Snapshot snap;
+ * hist.snapshot(snap);
+ * uint32_t p99 = snap.percentile(0.99);  // upper bound of the p99 bucket
+ * @endcode
+ */
+class LatencyHistogram {
+public:
+    static const uint32_t kSubBucketBits = MUTEXGUARD_HISTOGRAM_SUB_BUCKET_BITS;
+    static const uint32_t kSubBuckets = 1u << kSubBucketBits;
+    static const uint32_t kMaxBits = MUTEXGUARD_HISTOGRAM_MAX_BITS;
+    static const size_t kBucketCount = kSubBuckets + (kMaxBits - kSubBucketBits) * kSubBuckets + 1;
+
+    /**
+     * @brief Plain copy of the bucket counters
+     */
+    struct Snapshot {
+        uint32_t counts[kBucketCount];  ///< Per-bucket counts
+        uint32_t total;                 ///< Sum of all counts
+
+        /**
+         * @brief Value at or below which the fraction p of samples fall
+         *
+         * @param p Quantile in [0, 1], e.g. 0.99 for p99
+         * @return Upper bound of the bucket holding that sample, the lower
+         *         bound 2^MAX_BITS for the overflow bucket, or 0 when empty
+         */
+        uint32_t percentile(double p) const {
+            if (total == 0) {
+                return 0;
+            }
+            double exact = p * (double)total;
+            uint32_t rank = (uint32_t)exact;
+            if ((double)rank < exact) {
+                rank++;
+            }
+            if (rank == 0) {
+                rank = 1;
+            }
+            uint32_t seen = 0;
+            for (size_t i = 0; i < kBucketCount; i++) {
+                seen += counts[i];
+                if (seen >= rank) {
+                    return bucketUpperBound(i);
+                }
+            }
+            return bucketUpperBound(kBucketCount - 1);
+        }
+    };
+
+    /**
+     * @brief Add one sample
+     */
+    void record(uint32_t value) {
+        m_counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copy the current counters
+     */
+    void snapshot(Snapshot& out) const {
+        out.total = 0;
+        for (size_t i = 0; i < kBucketCount; i++) {
+            out.counts[i] = m_counts[i].load(std::memory_order_relaxed);
+            out.total += out.counts[i];
+        }
+    }
+
+    /**
+     * @brief Zero all buckets
+     */
+    void reset() {
+        for (size_t i = 0; i < kBucketCount; i++) {
+            m_counts[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Bucket that a value is counted in
+     */
+    static size_t bucketIndex(uint32_t value) {
+        if (value < kSubBuckets) {
+            return value;
+        }
+        uint32_t msb = 31u - (uint32_t)__builtin_clz(value);
+        if (msb >= kMaxBits) {
+            return kBucketCount - 1;
+        }
+        uint32_t shift = msb - kSubBucketBits;
+        return kSubBuckets + shift * kSubBuckets + ((value >> shift) & (kSubBuckets - 1));
+    }
+
+    /**
+     * @brief Largest value counted in a bucket (lower bound for the overflow bucket)
+     */
+    static uint32_t bucketUpperBound(size_t index) {
+        if (index < kSubBuckets) {
+            return (uint32_t)index;
+        }
+        if (index >= kBucketCount - 1) {
+            return 1u << kMaxBits;
+        }
+        uint32_t shift = (uint32_t)(index - kSubBuckets) / kSubBuckets;
+        uint32_t sub = (uint32_t)(index - kSubBuckets) % kSubBuckets;
+        uint32_t lower = (kSubBuckets + sub) << shift;
+        return lower + (1u << shift) - 1;
+    }
+
+private:
+    std::atomic<uint32_t> m_counts[kBucketCount];
+};
+
+#endif // _LATENCYHISTOGRAM_H_
@@ -0,0 +1,335 @@
+#include "LockDep.h"
+
+#ifdef MUTEXGUARD_LOCKDEP
+
+#include <atomic>
+
+#include "freertos/task.h"
+#include "MutexGuardLogging.h"
+#include "MutexRegistry.h"
+
+static_assert(MUTEXGUARD_LOCKDEP_MAX_LOCKS <= 64, "The lock-order graph uses 64-bit adjacency masks");
+
+namespace {
+
+struct HeldLock {
+    SemaphoreHandle_t handle;
+    const void* site;
+};
+
+/**
+ * Locks held by one task through the guards, oldest first. Unlocking out
+ * of order is allowed, so release searches from the top.
+ */
+struct HeldStack {
+    HeldLock locks[MUTEXGUARD_LOCKDEP_MAX_HELD];
+    size_t depth;
+    size_t untracked;  // Acquisitions past MUTEXGUARD_LOCKDEP_MAX_HELD
+};
+
+thread_local HeldStack t_held;
+
+struct EdgeRecord {
+    uint8_t from;
+    uint8_t to;
+    const void* fromSite;
+    const void* toSite;
+};
+
+// Lock-order graph, all guarded by g_graphLock. Node i is g_nodes[i]; bit j
+// of g_successors[i] means lock j has been acquired while lock i was held.
+SemaphoreHandle_t g_nodes[MUTEXGUARD_LOCKDEP_MAX_LOCKS];
+uint64_t g_successors[MUTEXGUARD_LOCKDEP_MAX_LOCKS];
+uint64_t g_reported[MUTEXGUARD_LOCKDEP_MAX_LOCKS];  // Pairs already reported
+EdgeRecord g_edges[MUTEXGUARD_LOCKDEP_MAX_EDGES];
+size_t g_edgeCount = 0;
+portMUX_TYPE g_graphLock = portMUX_INITIALIZER_UNLOCKED;
+
+std::atomic<uint32_t> g_violations(0);
+std::atomic<uint32_t> g_droppedRecords(0);
+std::atomic<LockDep::ReportHandler> g_handler(nullptr);
+
+inline uint64_t bit(int index) {
+    return (uint64_t)1 << index;
+}
+
+int nodeFor(SemaphoreHandle_t handle, bool create) {
+    int freeIndex = -1;
+    for (int i = 0; i < MUTEXGUARD_LOCKDEP_MAX_LOCKS; i++) {
+        if (g_nodes[i] == handle) {
+            return i;
+        }
+        if (g_nodes[i] == nullptr && freeIndex < 0) {
+            freeIndex = i;
+        }
+    }
+    if (create && freeIndex >= 0) {
+        g_nodes[freeIndex] = handle;
+        return freeIndex;
+    }
+    return -1;
+}
+
+const EdgeRecord* findEdge(int from, int to) {
+    for (size_t i = 0; i < g_edgeCount; i++) {
+        if (g_edges[i].from == from && g_edges[i].to == to) {
+            return &g_edges[i];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Breadth-first search for a path from -> ... -> target. If report is
+ * given, the shortest such path is copied into its chain.
+ */
+bool findPath(int from, int target, LockDepReport* report) {
+    int8_t parent[MUTEXGUARD_LOCKDEP_MAX_LOCKS];
+    int8_t queue[MUTEXGUARD_LOCKDEP_MAX_LOCKS];
+    size_t head = 0;
+    size_t tail = 0;
+    uint64_t visited = bit(from);
+    queue[tail++] = (int8_t)from;
+    while (head < tail && !(visited & bit(target))) {
+        int node = queue[head++];
+        uint64_t next = g_successors[node] & ~visited;
+        while (next != 0) {
+            int j = __builtin_ctzll(next);
+            next &= next - 1;
+            visited |= bit(j);
+            parent[j] = (int8_t)node;
+            queue[tail++] = (int8_t)j;
+        }
+    }
+    if (!(visited & bit(target))) {
+        return false;
+    }
+    if (report == nullptr) {
+        return true;
+    }
+
+    // Walk back from the target; path[len - 1] is `from`
+    int8_t path[MUTEXGUARD_LOCKDEP_MAX_LOCKS];
+    size_t len = 0;
+    for (int node = target; node != from; node = parent[node]) {
+        path[len++] = (int8_t)node;
+    }
+    path[len++] = (int8_t)from;
+
+    size_t edges = len - 1;
+    report->chainTruncated = edges > MUTEXGUARD_LOCKDEP_MAX_CHAIN;
+    report->chainLength = report->chainTruncated ? MUTEXGUARD_LOCKDEP_MAX_CHAIN : edges;
+    for (size_t i = 0; i < report->chainLength; i++) {
+        int a = path[len - 1 - i];
+        int b = path[len - 2 - i];
+        const EdgeRecord* record = findEdge(a, b);
+        report->chain[i].from = g_nodes[a];
+        report->chain[i].to = g_nodes[b];
+        report->chain[i].fromSite = record != nullptr ? record->fromSite : nullptr;
+        report->chain[i].toSite = record != nullptr ? record->toSite : nullptr;
+    }
+    return true;
+}
+
+const HeldLock* findHeld(const HeldStack& held, SemaphoreHandle_t handle) {
+    for (size_t i = held.depth; i > 0; i--) {
+        if (held.locks[i - 1].handle == handle) {
+            return &held.locks[i - 1];
+        }
+    }
+    return nullptr;
+}
+
+void emit(LockDepReport& report, SemaphoreHandle_t handle, const void* callSite) {
+    report.taskName = pcTaskGetName(nullptr);
+    report.acquiring = handle;
+    report.acquireSite = callSite;
+    g_violations.fetch_add(1, std::memory_order_relaxed);
+    LockDep::ReportHandler handler = g_handler.load(std::memory_order_acquire);
+    (handler != nullptr ? handler : LockDep::logReport)(report);
+}
+
+} // namespace
+
+void LockDep::beforeAcquire(SemaphoreHandle_t handle, const void* callSite, bool recursive) {
+    const HeldStack& held = t_held;
+    if (held.depth == 0) {
+        return;  // Nothing held: no ordering to learn
+    }
+
+    LockDepReport report;
+    bool found = false;
+
+    const HeldLock* self = findHeld(held, handle);
+    if (self != nullptr) {
+        if (recursive) {
+            return;  // Re-entering a held recursive mutex never blocks
+        }
+        portENTER_CRITICAL(&g_graphLock);
+        int node = nodeFor(handle, true);
+        found = node < 0 || !(g_reported[node] & bit(node));
+        if (node >= 0) {
+            g_reported[node] |= bit(node);
+        }
+        portEXIT_CRITICAL(&g_graphLock);
+        if (found) {
+            report.held = handle;
+            report.heldSite = self->site;
+            report.chainLength = 0;
+            report.chainTruncated = false;
+            emit(report, handle, callSite);
+        }
+        return;
+    }
+
+    uint32_t dropped = 0;
+    portENTER_CRITICAL(&g_graphLock);
+    int to = nodeFor(handle, true);
+    for (size_t i = 0; to >= 0 && i < held.depth; i++) {
+        int from = nodeFor(held.locks[i].handle, true);
+        if (from < 0) {
+            dropped++;
+            continue;
+        }
+        if (g_successors[from] & bit(to)) {
+            continue;  // Known ordering
+        }
+        bool reportThis = !found && !(g_reported[from] & bit(to));
+        if (findPath(to, from, reportThis ? &report : nullptr)) {
+            // The opposite order already exists: this edge would close a cycle
+            if (reportThis) {
+                g_reported[from] |= bit(to);
+                report.held = held.locks[i].handle;
+                report.heldSite = held.locks[i].site;
+                found = true;
+            }
+            continue;
+        }
+        g_successors[from] |= bit(to);
+        if (g_edgeCount < MUTEXGUARD_LOCKDEP_MAX_EDGES) {
+            EdgeRecord& record = g_edges[g_edgeCount++];
+            record.from = (uint8_t)from;
+            record.to = (uint8_t)to;
+            record.fromSite = held.locks[i].site;
+            record.toSite = callSite;
+        } else {
+            dropped++;
+        }
+    }
+    if (to < 0) {
+        dropped++;
+    }
+    portEXIT_CRITICAL(&g_graphLock);
+
+    if (dropped != 0) {
+        g_droppedRecords.fetch_add(dropped, std::memory_order_relaxed);
+    }
+    if (found) {
+        emit(report, handle, callSite);
+    }
+}
+
+void LockDep::acquired(SemaphoreHandle_t handle, const void* callSite) {
+    HeldStack& held = t_held;
+    if (held.depth < MUTEXGUARD_LOCKDEP_MAX_HELD) {
+        held.locks[held.depth].handle = handle;
+        held.locks[held.depth].site = callSite;
+        held.depth++;
+    } else {
+        held.untracked++;
+        g_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void LockDep::released(SemaphoreHandle_t handle) {
+    HeldStack& held = t_held;
+    for (size_t i = held.depth; i > 0; i--) {
+        if (held.locks[i - 1].handle == handle) {
+            for (size_t j = i; j < held.depth; j++) {
+                held.locks[j - 1] = held.locks[j];
+            }
+            held.depth--;
+            return;
+        }
+    }
+    if (held.untracked > 0) {
+        held.untracked--;
+    }
+}
+
+size_t LockDep::heldCount() {
+    return t_held.depth + t_held.untracked;
+}
+
+void LockDep::setReportHandler(ReportHandler handler) {
+    g_handler.store(handler, std::memory_order_release);
+}
+
+void LockDep::logReport(const LockDepReport& report) {
+    MUTEXG_LOG_E("Lock order violation in task '%s': acquiring '%s' at %p while holding '%s' (acquired at %p)",
+                 report.taskName != nullptr ? report.taskName : "?",
+                 MUTEXG_NAME(report.acquiring), report.acquireSite,
+                 MUTEXG_NAME(report.held), report.heldSite);
+    if (report.chainLength == 0) {
+        MUTEXG_LOG_E("  '%s' is not recursive: this acquisition deadlocks the task",
+                     MUTEXG_NAME(report.acquiring));
+        return;
+    }
+    MUTEXG_LOG_E("  Opposite order seen earlier:");
+    for (size_t i = 0; i < report.chainLength; i++) {
+        const LockDepEdge& edge = report.chain[i];
+        MUTEXG_LOG_E("    '%s' (acquired at %p) -> '%s' (acquired at %p)",
+                     MUTEXG_NAME(edge.from), edge.fromSite, MUTEXG_NAME(edge.to), edge.toSite);
+    }
+    if (report.chainTruncated) {
+        MUTEXG_LOG_E("    ...");
+    }
+}
+
+uint32_t LockDep::violations() {
+    return g_violations.load(std::memory_order_relaxed);
+}
+
+uint32_t LockDep::droppedRecords() {
+    return g_droppedRecords.load(std::memory_order_relaxed);
+}
+
+void LockDep::forget(SemaphoreHandle_t handle) {
+    if (handle == nullptr) {
+        return;
+    }
+    portENTER_CRITICAL(&g_graphLock);
+    int node = nodeFor(handle, false);
+    if (node >= 0) {
+        g_nodes[node] = nullptr;
+        g_successors[node] = 0;
+        g_reported[node] = 0;
+        for (int i = 0; i < MUTEXGUARD_LOCKDEP_MAX_LOCKS; i++) {
+            g_successors[i] &= ~bit(node);
+            g_reported[i] &= ~bit(node);
+        }
+        size_t kept = 0;
+        for (size_t i = 0; i < g_edgeCount; i++) {
+            if (g_edges[i].from != node && g_edges[i].to != node) {
+                g_edges[kept++] = g_edges[i];
+            }
+        }
+        g_edgeCount = kept;
+    }
+    portEXIT_CRITICAL(&g_graphLock);
+}
+
+void LockDep::reset() {
+    portENTER_CRITICAL(&g_graphLock);
+    for (int i = 0; i < MUTEXGUARD_LOCKDEP_MAX_LOCKS; i++) {
+        g_nodes[i] = nullptr;
+        g_successors[i] = 0;
+        g_reported[i] = 0;
+    }
+    g_edgeCount = 0;
+    portEXIT_CRITICAL(&g_graphLock);
+    g_violations.store(0, std::memory_order_relaxed);
+    g_droppedRecords.store(0, std::memory_order_relaxed);
+}
+
+#endif // MUTEXGUARD_LOCKDEP
@@ -0,0 +1,165 @@
+#ifndef _LOCKDEP_H_
+#define _LOCKDEP_H_
+
+/**
+ * @file LockDep.h
+ * @brief Debug-build lock-order validator for the guards
+ *
+ * Compiled out unless MUTEXGUARD_LOCKDEP is defined for the whole build
+ * (library and application), e.g. `build_flags = -DMUTEXGUARD_LOCKDEP`.
+ */
+
+#include <stdint.h>
+
+/**
+ * @brief Code address of the caller of the current function
+ *
+ * Used as the call site of a guard. On Xtensa the return address carries
+ * the window size in its top bits and points after the call instruction,
+ * so it is mapped back into the instruction bus range for addr2line.
+ * Defined in every build; the hold-time watchdog uses it too.
+ */
+#if defined(__XTENSA__)
+#define MUTEXGUARD_CALL_SITE() \
+    ((const void*)((((uintptr_t)__builtin_return_address(0) & 0x3fffffffu) | 0x40000000u) - 3))
+#else
+#define MUTEXGUARD_CALL_SITE() ((const void*)__builtin_return_address(0))
+#endif
+
+#ifdef MUTEXGUARD_LOCKDEP
+
+#include <stddef.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#ifndef MUTEXGUARD_LOCKDEP_MAX_LOCKS
+#define MUTEXGUARD_LOCKDEP_MAX_LOCKS 32  ///< Distinct handles in the lock-order graph (max 64)
+#endif
+
+#ifndef MUTEXGUARD_LOCKDEP_MAX_EDGES
+#define MUTEXGUARD_LOCKDEP_MAX_EDGES 128  ///< Ordering edges whose call sites are kept
+#endif
+
+#ifndef MUTEXGUARD_LOCKDEP_MAX_HELD
+#define MUTEXGUARD_LOCKDEP_MAX_HELD 8  ///< Locks tracked per task at once
+#endif
+
+#ifndef MUTEXGUARD_LOCKDEP_MAX_CHAIN
+#define MUTEXGUARD_LOCKDEP_MAX_CHAIN 8  ///< Edges of the existing order kept in a report
+#endif
+
+/**
+ * @brief One observed ordering: `to` was acquired while `from` was held
+ */
+struct LockDepEdge {
+    SemaphoreHandle_t from;
+    SemaphoreHandle_t to;
+    const void* fromSite;  ///< Where `from` was acquired, nullptr if not recorded
+    const void* toSite;    ///< Where `to` was acquired while holding `from`
+};
+
+/**
+ * @brief Description of an acquisition that closes a cycle in the lock order
+ *
+ * The task holds `held` and is about to acquire `acquiring`, while the
+ * existing order (possibly through other locks) says `acquiring` comes
+ * before `held`. Two tasks taking these paths concurrently can deadlock.
+ *
+ * A chainLength of 0 means the task is re-acquiring a non-recursive mutex
+ * it already holds (`held == acquiring`), which deadlocks on its own.
+ */
+struct LockDepReport {
+    const char* taskName;          ///< Task making the offending acquisition
+    SemaphoreHandle_t acquiring;   ///< Lock being acquired
+    const void* acquireSite;       ///< Call site of that acquisition
+    SemaphoreHandle_t held;        ///< Lock already held by the task
+    const void* heldSite;          ///< Call site where `held` was acquired
+    size_t chainLength;            ///< Number of valid entries in chain
+    bool chainTruncated;           ///< The existing path had more edges than fit
+    LockDepEdge chain[MUTEXGUARD_LOCKDEP_MAX_CHAIN];  ///< Existing path acquiring -> ... -> held
+};
+
+/**
+ * @brief Runtime lock-order validator in the spirit of the Linux lockdep
+ *
+ * Every MutexGuard and RecursiveMutexGuard acquisition records, for the
+ * calling task, the locks it already holds. Each (held -> acquiring) pair
+ * becomes an edge of a global lock-order graph. An acquisition whose edge
+ * would close a cycle is reported before the task blocks, with the call
+ * sites of both orders, even if the deadlock never actually happens in
+ * that run. Each offending pair is reported once.
+ *
+ * Call sites are code addresses; resolve them with
+ * `xtensa-esp32-elf-addr2line -pfiaC -e firmware.elf <addr>` (or the
+ * host `addr2line`). Name mutexes with MutexRegistry to get readable
+ * reports.
+ *
+ * Only acquisitions through the guards are seen. The graph is static
+ * (MUTEXGUARD_LOCKDEP_MAX_LOCKS nodes) and updated under a short critical
+ * section, so this is a debugging aid and not meant for release builds.
+ *
+ * Usage:
+ * @code
+ * // build_flags = -DMUTEXGUARD_LOCKDEP
+ * // Task 1:                         Task 2:
+ * MutexGuard a(mutexA);              MutexGuard b(mutexB);
+ * MutexGuard b(mutexB);              MutexGuard a(mutexA);  // Reported here
+ * @endcode
+ */
+class LockDep {
+public:
+    typedef void (*ReportHandler)(const LockDepReport& report);
+
+    /**
+     * @brief Replace the report handler
+     * @param handler Called outside any lock for each new violation;
+     *                nullptr restores the default (logReport)
+     */
+    static void setReportHandler(ReportHandler handler);
+
+    /**
+     * @brief Default handler: log the report at error level
+     */
+    static void logReport(const LockDepReport& report);
+
+    /**
+     * @brief Number of violations reported since the last reset()
+     */
+    static uint32_t violations();
+
+    /**
+     * @brief Acquisitions not fully tracked because a table was full
+     */
+    static uint32_t droppedRecords();
+
+    /**
+     * @brief Number of guard-held locks of the calling task
+     */
+    static size_t heldCount();
+
+    /**
+     * @brief Drop a handle and all its edges from the graph
+     *
+     * Call before deleting a mutex whose handle may be reused by a new one.
+     */
+    static void forget(SemaphoreHandle_t handle);
+
+    /**
+     * @brief Clear the graph and the counters
+     *
+     * Locks currently held by tasks stay tracked.
+     */
+    static void reset();
+
+    /// @name Hooks used by the guards
+    /// @{
+    static void beforeAcquire(SemaphoreHandle_t handle, const void* callSite, bool recursive);
+    static void acquired(SemaphoreHandle_t handle, const void* callSite);
+    static void released(SemaphoreHandle_t handle);
+    /// @}
+};
+
+#endif // MUTEXGUARD_LOCKDEP
+
+#endif // _LOCKDEP_H_
@@ -0,0 +1,299 @@
+#include "LockTrace.h"
+
+#ifdef MUTEXGUARD_TRACE
+
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+
+#include "MutexGuardConfig.h"
+#include "MutexGuardLogging.h"
+
+static_assert((MUTEXGUARD_TRACE_EVENTS & (MUTEXGUARD_TRACE_EVENTS - 1)) == 0,
+              "MUTEXGUARD_TRACE_EVENTS must be a power of two");
+
+namespace {
+
+#ifdef configMAX_TASK_NAME_LEN
+const size_t kTaskNameLength = configMAX_TASK_NAME_LEN;
+#else
+const size_t kTaskNameLength = 16;
+#endif
+
+const size_t kMaxNamedMutexes = 32;  // Distinct "LT M" lines per dump
+
+const size_t kEventWords = (sizeof(LockTraceEvent) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+// A seqlock per slot, as in SeqLock.h: the event is stored as relaxed word
+// atomics so that a reader racing a writer that wrapped around copies torn
+// words, which the sequence re-check rejects, instead of racing on the data
+struct TraceSlot {
+    std::atomic<uint32_t> sequence;            ///< Event index + 1 once written, 0 while writing
+    std::atomic<uint32_t> words[kEventWords];  ///< The LockTraceEvent
+};
+
+// One ring per core; the write position is the only word writers share
+struct alignas(MUTEXGUARD_CACHE_LINE_SIZE) TraceRing {
+    std::atomic<uint32_t> head;            ///< Events claimed since clear()
+    std::atomic<TaskHandle_t> lastTask;    ///< Last task seen, to skip the name lookup
+    TraceSlot slots[MUTEXGUARD_TRACE_EVENTS];
+};
+
+struct TaskName {
+    TaskHandle_t task;
+    char name[kTaskNameLength];
+};
+
+TraceRing g_rings[portNUM_PROCESSORS];
+std::atomic<bool> g_recording(false);
+uint32_t g_baseUs = 0;  // Sort origin, so timestamps order correctly across a wrap
+
+// Appended under g_lock and only cleared by clear(), so lookups scan the
+// first g_taskCount entries without locking
+TaskName g_tasks[MUTEXGUARD_TRACE_MAX_TASKS];
+std::atomic<size_t> g_taskCount(0);
+portMUX_TYPE g_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void rememberTask(TaskHandle_t task) {
+    size_t count = g_taskCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        if (g_tasks[i].task == task) {
+            return;
+        }
+    }
+
+    // Another task on the other core may have added it meanwhile
+    portENTER_CRITICAL(&g_lock);
+    size_t known = count;
+    count = g_taskCount.load(std::memory_order_relaxed);
+    while (known < count && g_tasks[known].task != task) {
+        known++;
+    }
+    if (known == count && count < MUTEXGUARD_TRACE_MAX_TASKS) {
+        const char* name = pcTaskGetName(task);
+        g_tasks[count].task = task;
+        strncpy(g_tasks[count].name, name != nullptr ? name : "?", kTaskNameLength - 1);
+        g_tasks[count].name[kTaskNameLength - 1] = '\0';
+        g_taskCount.store(count + 1, std::memory_order_release);
+    }
+    portEXIT_CRITICAL(&g_lock);
+}
+
+// Copy one slot; false if it is being rewritten or holds another index
+bool readSlot(const TraceRing& ring, uint32_t index, LockTraceEvent& out) {
+    const TraceSlot& slot = ring.slots[index & (MUTEXGUARD_TRACE_EVENTS - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != index + 1) {
+        return false;
+    }
+    uint32_t words[kEventWords];
+    for (size_t i = 0; i < kEventWords; i++) {
+        words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != index + 1) {
+        return false;
+    }
+    memcpy(&out, words, sizeof(LockTraceEvent));
+    return true;
+}
+
+struct RingCursor {
+    uint32_t next;
+    uint32_t end;
+    bool hasEvent;
+    LockTraceEvent event;
+
+    void advance(const TraceRing& ring) {
+        hasEvent = false;
+        while (!hasEvent && next != end) {
+            hasEvent = readSlot(ring, next++, event);
+        }
+    }
+};
+
+// Merge the per-core rings by timestamp and pass each event to emit() until
+// it returns false. Each ring is in claim order, which matches timestamp
+// order unless a writer was preempted between the two.
+template <typename Emit>
+size_t mergeRings(Emit emit) {
+    RingCursor cursors[portNUM_PROCESSORS];
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        uint32_t head = g_rings[core].head.load(std::memory_order_acquire);
+        cursors[core].next = head > MUTEXGUARD_TRACE_EVENTS ? head - MUTEXGUARD_TRACE_EVENTS : 0;
+        cursors[core].end = head;
+        cursors[core].advance(g_rings[core]);
+    }
+
+    size_t count = 0;
+    for (;;) {
+        int oldest = -1;
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            if (cursors[core].hasEvent &&
+                (oldest < 0 || cursors[core].event.timestampUs - g_baseUs <
+                                   cursors[oldest].event.timestampUs - g_baseUs)) {
+                oldest = core;
+            }
+        }
+        if (oldest < 0 || !emit(cursors[oldest].event)) {
+            return count;
+        }
+        count++;
+        cursors[oldest].advance(g_rings[oldest]);
+    }
+}
+
+void logLine(const char* line, void* context) {
+    (void)context;
+    MUTEXG_LOG_I("%s", line);
+}
+
+} // namespace
+
+void LockTrace::start() {
+    bool empty = true;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        empty = empty && g_rings[core].head.load(std::memory_order_relaxed) == 0;
+    }
+    if (empty) {
+        g_baseUs = (uint32_t)esp_timer_get_time();
+    }
+    g_recording.store(true, std::memory_order_release);
+}
+
+void LockTrace::stop() {
+    g_recording.store(false, std::memory_order_release);
+}
+
+bool LockTrace::isRecording() {
+    return g_recording.load(std::memory_order_relaxed);
+}
+
+void LockTrace::clear() {
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        g_rings[core].head.store(0, std::memory_order_relaxed);
+        g_rings[core].lastTask.store(nullptr, std::memory_order_relaxed);
+        for (size_t i = 0; i < MUTEXGUARD_TRACE_EVENTS; i++) {
+            g_rings[core].slots[i].sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+    portENTER_CRITICAL(&g_lock);
+    g_taskCount.store(0, std::memory_order_release);
+    portEXIT_CRITICAL(&g_lock);
+}
+
+size_t LockTrace::snapshot(LockTraceEvent* out, size_t capacity) {
+    size_t count = 0;
+    mergeRings([&](const LockTraceEvent& event) {
+        if (count >= capacity) {
+            return false;
+        }
+        out[count++] = event;
+        return true;
+    });
+
+    // Fix up the few events a preempted writer left out of order
+    for (size_t i = 1; i < count; i++) {
+        LockTraceEvent event = out[i];
+        size_t j = i;
+        while (j > 0 && out[j - 1].timestampUs - g_baseUs > event.timestampUs - g_baseUs) {
+            out[j] = out[j - 1];
+            j--;
+        }
+        out[j] = event;
+    }
+    return count;
+}
+
+uint32_t LockTrace::overwritten() {
+    uint32_t total = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        uint32_t head = g_rings[core].head.load(std::memory_order_relaxed);
+        total += head > MUTEXGUARD_TRACE_EVENTS ? head - MUTEXGUARD_TRACE_EVENTS : 0;
+    }
+    return total;
+}
+
+void LockTrace::dump(LineWriter writer, void* context) {
+    if (writer == nullptr) {
+        writer = logLine;
+    }
+    char line[96];
+
+    snprintf(line, sizeof(line), "LT begin cores=%d overwritten=%u", portNUM_PROCESSORS,
+             (unsigned)overwritten());
+    writer(line, context);
+
+    size_t taskCount = g_taskCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < taskCount; i++) {
+        snprintf(line, sizeof(line), "LT T %p %s", (void*)g_tasks[i].task, g_tasks[i].name);
+        writer(line, context);
+    }
+
+    // Names of the registered mutexes that appear in the trace
+    SemaphoreHandle_t named[kMaxNamedMutexes];
+    size_t namedCount = 0;
+    mergeRings([&](const LockTraceEvent& event) {
+        const char* name = MutexRegistry::nameOf(event.handle);
+        if (name == nullptr) {
+            return true;
+        }
+        for (size_t i = 0; i < namedCount; i++) {
+            if (named[i] == event.handle) {
+                return true;
+            }
+        }
+        named[namedCount++] = event.handle;
+        snprintf(line, sizeof(line), "LT M %p %s", (void*)event.handle, name);
+        writer(line, context);
+        return namedCount < kMaxNamedMutexes;
+    });
+
+    size_t eventCount = mergeRings([&](const LockTraceEvent& event) {
+        snprintf(line, sizeof(line), "LT E %u %u %c %p %p", (unsigned)event.timestampUs,
+                 (unsigned)event.core, (char)event.type, (void*)event.task, (void*)event.handle);
+        writer(line, context);
+        return true;
+    });
+
+    snprintf(line, sizeof(line), "LT end events=%u", (unsigned)eventCount);
+    writer(line, context);
+}
+
+void LockTrace::record(LockTraceEventType type, SemaphoreHandle_t handle) {
+    if (!g_recording.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    uint32_t timestampUs = (uint32_t)esp_timer_get_time();
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    BaseType_t core = xPortGetCoreID();
+    TraceRing& ring = g_rings[core];
+
+    // Name lookups only when the core switched tasks since its last event
+    if (ring.lastTask.load(std::memory_order_relaxed) != task) {
+        rememberTask(task);
+        ring.lastTask.store(task, std::memory_order_relaxed);
+    }
+
+    LockTraceEvent event;
+    event.timestampUs = timestampUs;
+    event.handle = handle;
+    event.task = task;
+    event.type = type;
+    event.core = (uint8_t)core;
+    event.reserved = 0;
+    uint32_t words[kEventWords] = {};
+    memcpy(words, &event, sizeof(LockTraceEvent));
+
+    uint32_t index = ring.head.fetch_add(1, std::memory_order_relaxed);
+    TraceSlot& slot = ring.slots[index & (MUTEXGUARD_TRACE_EVENTS - 1)];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kEventWords; i++) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+#endif // MUTEXGUARD_TRACE
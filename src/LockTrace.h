@@ -0,0 +1,141 @@
+#ifndef _LOCKTRACE_H_
+#define _LOCKTRACE_H_
+
+/**
+ * @file LockTrace.h
+ * @brief Opt-in timeline of guard lock events for Chrome/Perfetto traces
+ *
+ * Compiled out unless MUTEXGUARD_TRACE is defined for the whole build
+ * (library and application), e.g. `build_flags = -DMUTEXGUARD_TRACE`.
+ */
+
+#ifdef MUTEXGUARD_TRACE
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+
+#ifndef MUTEXGUARD_TRACE_EVENTS
+#define MUTEXGUARD_TRACE_EVENTS 256  ///< Events kept per core (power of two)
+#endif
+
+#ifndef MUTEXGUARD_TRACE_MAX_TASKS
+#define MUTEXGUARD_TRACE_MAX_TASKS 16  ///< Task names remembered for the dump
+#endif
+
+/**
+ * @brief What happened to a lock
+ */
+enum LockTraceEventType : uint8_t {
+    LOCK_TRACE_WAIT = 'W',      ///< The task starts to take the mutex
+    LOCK_TRACE_ACQUIRED = 'A',  ///< The take succeeded
+    LOCK_TRACE_TIMEOUT = 'T',   ///< The take failed
+    LOCK_TRACE_RELEASED = 'R'   ///< The task is about to give the mutex back
+};
+
+/**
+ * @brief One recorded lock event; 16 bytes on the ESP32
+ */
+struct LockTraceEvent {
+    uint32_t timestampUs;      ///< esp_timer time, wraps after about 71 minutes
+    SemaphoreHandle_t handle;  ///< The mutex
+    TaskHandle_t task;         ///< The task that waited, took or gave it
+    uint8_t type;              ///< A LockTraceEventType
+    uint8_t core;              ///< Core that recorded the event
+    uint16_t reserved;
+};
+
+/**
+ * @brief Records what the guards do, as a timeline
+ *
+ * Statistics say that a mutex is contended; a trace shows who waited for
+ * whom and for how long, which is what a lock convoy looks like. With
+ * MUTEXGUARD_TRACE, every guard except SpinlockGuard records a wait event
+ * before each take, through GuardHooks. Then comes an acquired or timeout
+ * event, and a released event before the give. MultiMutexGuard records the
+ * events once per mutex of its set. UniqueMutexGuard::release() and
+ * adoption end and start a hold. Events go into one ring per core. A writer
+ * claims its slot with a single atomic increment and never takes a lock, so
+ * tasks on both cores and tasks preempting each other can record
+ * concurrently. When a ring is full, the oldest events are overwritten, so
+ * the buffer always holds the most recent MUTEXGUARD_TRACE_EVENTS per core.
+ *
+ * Recording is off until start(). To look at a trace, stop(), then dump()
+ * the buffer as text lines. Convert the captured output with
+ * `tools/lock_trace_to_chrome.py` and open the JSON in Perfetto
+ * (ui.perfetto.dev) or chrome://tracing. Each task gets a row showing its
+ * wait and hold slices per mutex.
+ *
+ * Usage:
+ * @code
+ * // build_flags = -DMUTEXGUARD_TRACE
+ * LockTrace::start();
+ * vTaskDelay(pdMS_TO_TICKS(2000));  // Run the workload
+ * LockTrace::stop();
+ * LockTrace::dump();                // "LT ..." lines through MUTEXG_LOG_I
+ * @endcode
+ * @code
+ * pio device monitor | tee trace.log
+ * python3 tools/lock_trace_to_chrome.py trace.log -o trace.json
+ * @endcode
+ */
+class LockTrace {
+public:
+    typedef void (*LineWriter)(const char* line, void* context);
+
+    /**
+     * @brief Start recording; events already in the buffer are kept
+     */
+    static void start();
+
+    /**
+     * @brief Stop recording; events recorded so far stay in the buffer
+     */
+    static void stop();
+
+    static bool isRecording();
+
+    /**
+     * @brief Drop all recorded events and remembered task names
+     *
+     * Call while stopped.
+     */
+    static void clear();
+
+    /**
+     * @brief Copy the buffered events of all cores, oldest first
+     *
+     * Events still being written when called are skipped.
+     *
+     * @return Number of events written; the newest are dropped if capacity is short
+     */
+    static size_t snapshot(LockTraceEvent* out, size_t capacity);
+
+    /**
+     * @brief Events overwritten because a ring was full
+     */
+    static uint32_t overwritten();
+
+    /**
+     * @brief Write the buffer as text lines for tools/lock_trace_to_chrome.py
+     *
+     * One "LT T" line per known task and "LT M" line per mutex with its
+     * name, then one "LT E" line per event, oldest first, and a final
+     * "LT end" line. Lines go to writer, or to MUTEXG_LOG_I if it is null.
+     * Call while stopped.
+     */
+    static void dump(LineWriter writer = nullptr, void* context = nullptr);
+
+    /// @name Hook used by the guards
+    /// @{
+    static void record(LockTraceEventType type, SemaphoreHandle_t handle);
+    /// @}
+};
+
+#endif // MUTEXGUARD_TRACE
+
+#endif // _LOCKTRACE_H_
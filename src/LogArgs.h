@@ -0,0 +1,45 @@
+#ifndef _LOGARGS_H_
+#define _LOGARGS_H_
+
+/**
+ * @file LogArgs.h
+ * @brief Argument helpers shared by the deferred and binary log backends
+ */
+
+#include <type_traits>
+
+/**
+ * @brief What a logging backend needs to capture printf arguments by value
+ */
+struct LogArgs {
+    /**
+     * @brief Type an integer or enum argument has after default promotion
+     *
+     * Capturing in this type keeps exactly what printf would have seen,
+     * e.g. int for a char and unsigned long for an unsigned long.
+     */
+    template <typename T>
+    struct Promoted {
+        typedef typename std::conditional<std::is_enum<T>::value, int, T>::type Integral;
+        typedef decltype(+Integral()) type;
+    };
+
+#if defined(__GNUC__)
+    /**
+     * @brief Never defined; only named inside sizeof() so that the compiler
+     *        still checks the arguments against the format string
+     */
+    static int checkFormat(const char* format, ...) __attribute__((format(printf, 1, 2)));
+#endif
+};
+
+/**
+ * @brief Format-check a log call like printf, without evaluating it
+ */
+#if defined(__GNUC__)
+#define MUTEXGUARD_CHECK_FORMAT(...) ((void)sizeof(LogArgs::checkFormat(__VA_ARGS__)))
+#else
+#define MUTEXGUARD_CHECK_FORMAT(...) ((void)0)
+#endif
+
+#endif // _LOGARGS_H_
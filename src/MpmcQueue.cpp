@@ -0,0 +1,75 @@
+#include "MpmcQueue.h"
+#include "MutexGuardLogging.h"
+
+#include "freertos/task.h"
+
+namespace {
+
+TickType_t remainingTicks(TickType_t start, TickType_t timeout) {
+    if (timeout == portMAX_DELAY) {
+        return portMAX_DELAY;
+    }
+    TickType_t elapsed = xTaskGetTickCount() - start;
+    return elapsed >= timeout ? 0 : timeout - elapsed;
+}
+
+} // namespace
+
+MpmcWaitGate::MpmcWaitGate(UBaseType_t maxTokens)
+    : m_gate(xSemaphoreCreateCounting(maxTokens, 0)), m_waiters(0) {
+    if (m_gate == nullptr) {
+        MUTEXG_LOG_E("Failed to create MpmcQueue wake-up semaphore");
+    }
+}
+
+MpmcWaitGate::~MpmcWaitGate() {
+    if (m_gate != nullptr) {
+        vSemaphoreDelete(m_gate);
+    }
+}
+
+bool MpmcWaitGate::waitUntil(bool (*attempt)(void*), void* context, TickType_t timeout) {
+    // Check if we're in ISR context
+    if (xPortInIsrContext()) {
+        MUTEXG_LOG_E("Cannot wait on MpmcQueue from ISR context");
+        return false;
+    }
+
+    TickType_t start = xTaskGetTickCount();
+    for (int i = 0; i < MUTEXGUARD_MPMC_SPIN_RETRIES; i++) {
+        taskYIELD();
+        if (attempt(context)) {
+            return true;
+        }
+    }
+    if (m_gate == nullptr) {
+        MUTEXG_LOG_W("MpmcQueue has no wake-up semaphore, not waiting");
+        return false;
+    }
+
+    m_waiters.fetch_add(1, std::memory_order_relaxed);
+    // Pairs with the fence in wakeOne(); the attempt below is the re-check
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    bool done = false;
+    for (;;) {
+        if (attempt(context)) {
+            done = true;
+            break;
+        }
+        TickType_t remaining = remainingTicks(start, timeout);
+        if (remaining == 0) {
+            break;
+        }
+        xSemaphoreTake(m_gate, remaining);
+    }
+
+    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+    return done;
+}
+
+void MpmcWaitGate::give() {
+    if (m_gate != nullptr) {
+        xSemaphoreGive(m_gate);  // Fails harmlessly once maxTokens are pending
+    }
+}
@@ -0,0 +1,336 @@
+#ifndef _MPMCQUEUE_H_
+#define _MPMCQUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "MutexGuardConfig.h"
+
+#ifndef MUTEXGUARD_MPMC_SPIN_RETRIES
+#define MUTEXGUARD_MPMC_SPIN_RETRIES 16  ///< Yielding retries before a blocking call sleeps
+#endif
+
+/**
+ * @brief Sleep/wake-up helper behind the blocking calls of MpmcQueue
+ *
+ * A counting semaphore that is only touched when some task is actually
+ * waiting: waiters register in a counter before their last re-check, and
+ * wakeOne() gives the semaphore only if that counter is non-zero. Tokens
+ * left over from a waiter that succeeded on its own only cause one extra
+ * re-check later.
+ *
+ * Before sleeping, a waiter retries up to MUTEXGUARD_MPMC_SPIN_RETRIES
+ * times with taskYIELD() in between. A queue kept full by fast producers is
+ * usually freed again within a few yields, and sleeping for every element
+ * would turn each transfer into a semaphore hand-off.
+ */
+class MpmcWaitGate {
+public:
+    /**
+     * @brief Create the wake-up semaphore; check isValid() if heap allocation may fail
+     */
+    explicit MpmcWaitGate(UBaseType_t maxTokens);
+    ~MpmcWaitGate();
+
+    MpmcWaitGate(const MpmcWaitGate&) = delete;
+    MpmcWaitGate& operator=(const MpmcWaitGate&) = delete;
+
+    bool isValid() const noexcept { return m_gate != nullptr; }
+
+    /**
+     * @brief Retry attempt(context) until it returns true or the timeout expires
+     *
+     * Yields between the first attempts, then sleeps on the semaphore. Fails
+     * at once from an ISR; without a semaphore it stops after the yielding
+     * attempts.
+     *
+     * @return true if an attempt succeeded
+     */
+    bool waitUntil(bool (*attempt)(void*), void* context, TickType_t timeout);
+
+    /**
+     * @brief Wake one waiting task, if there is one
+     *
+     * Called after every successful transfer, so the check for waiters is inline.
+     */
+    void wakeOne() {
+        // Pairs with the fence in waitUntil(): either the waiter's re-check sees
+        // this transfer or this load sees the waiter
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiters.load(std::memory_order_relaxed) != 0) {
+            give();
+        }
+    }
+
+    /**
+     * @brief wakeOne() for ISR context
+     */
+    void wakeOneFromISR(BaseType_t* higherPriorityTaskWoken) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiters.load(std::memory_order_relaxed) != 0 && m_gate != nullptr) {
+            xSemaphoreGiveFromISR(m_gate, higherPriorityTaskWoken);
+        }
+    }
+
+private:
+    void give();
+
+    SemaphoreHandle_t m_gate;          ///< Counting semaphore waiters sleep on
+    std::atomic<uint32_t> m_waiters;   ///< Tasks currently inside waitUntil()
+};
+
+/**
+ * @brief Bounded multi-producer/multi-consumer queue without a lock
+ *
+ * Fan-in from several tasks through a MutexGuard-protected buffer makes the
+ * mutex the hotspot: every producer and the consumer serialize on it, and a
+ * task preempted while holding it stalls all others. This queue follows
+ * Dmitry Vyukov's bounded MPMC design instead. Every slot carries a sequence
+ * number that says whether it is ready to be written or read in the current
+ * lap, so producers only compete on one compare-and-swap of the enqueue
+ * position and consumers on one of the dequeue position; the two positions
+ * are on separate cache lines and producers and consumers never touch the
+ * same word unless they meet at the same slot.
+ *
+ * tryPush() and tryPop() never block and are safe from an ISR through
+ * pushFromISR()/popFromISR(). push() and pop() take a timeout in ticks with
+ * the same meaning as for MutexGuard: 0 never waits, portMAX_DELAY waits
+ * forever, the default is 100ms. They sleep on a semaphore only while the
+ * queue is full or empty.
+ *
+ * Constraints:
+ * - Capacity must be a power of two; all Capacity slots are usable.
+ * - T must be default-constructible and copy-assignable.
+ * - Not strictly lock-free: a producer preempted between claiming a slot and
+ *   filling it makes consumers see the queue as empty at that slot until it
+ *   runs again (and likewise for a preempted consumer and full producers).
+ *   No data is lost and blocking calls keep waiting, but tryPop() can fail
+ *   while later elements are already written.
+ * - Allocate statically, see MUTEXGUARD_CACHE_LINE_SIZE.
+ *
+ * Usage:
+ * @code
+ * static MpmcQueue<LogRecord, 128> logQueue;
+ *
+ * void sensorTask(void*) {                // Any number of producers
+ *     logQueue.push(makeRecord(), pdMS_TO_TICKS(10));
+ * }
+ *
+ * void loggerTask(void*) {                // Any number of consumers
+ *     LogRecord record;
+ *     if (logQueue.pop(record, portMAX_DELAY)) {
+ *         write(record);
+ *     }
+ * }
+ * @endcode
+ */
+template <typename T, size_t Capacity>
+class MpmcQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "MpmcQueue capacity must be a power of two");
+
+public:
+    MpmcQueue()
+        : m_enqueuePos(0), m_dequeuePos(0), m_notEmpty(Capacity), m_notFull(Capacity) {
+        for (size_t i = 0; i < Capacity; i++) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * @brief Check if the blocking calls can wait
+     *
+     * The non-blocking calls work either way.
+     */
+    bool isValid() const noexcept { return m_notEmpty.isValid() && m_notFull.isValid(); }
+
+    /**
+     * @brief Append one element without waiting
+     *
+     * @return false if the queue is full
+     */
+    bool tryPush(const T& value) {
+        if (!enqueue(value)) {
+            return false;
+        }
+        m_notEmpty.wakeOne();
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element without waiting
+     *
+     * @return false if the queue is empty
+     */
+    bool tryPop(T& out) {
+        if (!dequeue(out)) {
+            return false;
+        }
+        m_notFull.wakeOne();
+        return true;
+    }
+
+    /**
+     * @brief Append one element, waiting while the queue is full
+     *
+     * @param timeout Timeout in ticks to wait for space (default: 100ms)
+     * @return false on timeout or when called from an ISR with the queue full
+     */
+    bool push(const T& value, TickType_t timeout = pdMS_TO_TICKS(100)) {
+        if (tryPush(value)) {
+            return true;
+        }
+        if (timeout == 0) {
+            return false;
+        }
+        Attempt<const T> attempt = {this, &value};
+        if (!m_notFull.waitUntil(&Attempt<const T>::push, &attempt, timeout)) {
+            return false;
+        }
+        m_notEmpty.wakeOne();
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element, waiting while the queue is empty
+     *
+     * @param timeout Timeout in ticks to wait for data (default: 100ms)
+     * @return false on timeout or when called from an ISR with the queue empty
+     */
+    bool pop(T& out, TickType_t timeout = pdMS_TO_TICKS(100)) {
+        if (tryPop(out)) {
+            return true;
+        }
+        if (timeout == 0) {
+            return false;
+        }
+        Attempt<T> attempt = {this, &out};
+        if (!m_notEmpty.waitUntil(&Attempt<T>::pop, &attempt, timeout)) {
+            return false;
+        }
+        m_notFull.wakeOne();
+        return true;
+    }
+
+    /**
+     * @brief tryPush() from an ISR
+     *
+     * @param higherPriorityTaskWoken Set to pdTRUE if a woken consumer should
+     *        run next; pass it to portYIELD_FROM_ISR()
+     */
+    bool pushFromISR(const T& value, BaseType_t* higherPriorityTaskWoken) {
+        if (!enqueue(value)) {
+            return false;
+        }
+        m_notEmpty.wakeOneFromISR(higherPriorityTaskWoken);
+        return true;
+    }
+
+    /**
+     * @brief tryPop() from an ISR
+     */
+    bool popFromISR(T& out, BaseType_t* higherPriorityTaskWoken) {
+        if (!dequeue(out)) {
+            return false;
+        }
+        m_notFull.wakeOneFromISR(higherPriorityTaskWoken);
+        return true;
+    }
+
+    /**
+     * @brief Approximate number of stored elements while others push or pop
+     */
+    size_t size() const {
+        size_t dequeuePos = m_dequeuePos.load(std::memory_order_acquire);
+        size_t enqueuePos = m_enqueuePos.load(std::memory_order_acquire);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static const size_t kMask = Capacity - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence;  ///< pos: free for the producer of pos; pos + 1: full
+        T data;
+    };
+
+    // Type-erased retry for MpmcWaitGate::waitUntil()
+    template <typename U>
+    struct Attempt {
+        MpmcQueue* queue;
+        U* value;
+        static bool push(void* self) {
+            Attempt* a = static_cast<Attempt*>(self);
+            return a->queue->enqueue(*a->value);
+        }
+        static bool pop(void* self) {
+            Attempt* a = static_cast<Attempt*>(self);
+            return a->queue->dequeue(*a->value);
+        }
+    };
+
+    bool enqueue(const T& value) {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &m_cells[pos & kMask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+            if (diff == 0) {
+                // Slot is free in this lap; claim it
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Still holds last lap's element: full
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);  // Another producer took it
+            }
+        }
+        cell->data = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool dequeue(T& out) {
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &m_cells[pos & kMask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Not written yet in this lap: empty
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        out = cell->data;
+        // Free the slot for the producer one lap ahead
+        cell->sequence.store(pos + Capacity, std::memory_order_release);
+        return true;
+    }
+
+    alignas(MUTEXGUARD_CACHE_LINE_SIZE) std::atomic<size_t> m_enqueuePos;  ///< Next position to claim for writing
+    alignas(MUTEXGUARD_CACHE_LINE_SIZE) std::atomic<size_t> m_dequeuePos;  ///< Next position to claim for reading
+    alignas(MUTEXGUARD_CACHE_LINE_SIZE) Cell m_cells[Capacity];
+    MpmcWaitGate m_notEmpty;  ///< Consumers waiting for data
+    MpmcWaitGate m_notFull;   ///< Producers waiting for space
+};
+
+#endif // _MPMCQUEUE_H_
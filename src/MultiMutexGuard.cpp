@@ -0,0 +1,162 @@
+#include "MultiMutexGuard.h"
+
+#include "freertos/task.h"
+
+namespace {
+
+TickType_t remainingTicks(TickType_t start, TickType_t timeout) {
+    if (timeout == portMAX_DELAY) {
+        return portMAX_DELAY;
+    }
+    TickType_t elapsed = xTaskGetTickCount() - start;
+    return elapsed >= timeout ? 0 : timeout - elapsed;
+}
+
+} // namespace
+
+MultiMutexGuard::MultiMutexGuard(std::initializer_list<SemaphoreHandle_t> handles, TickType_t timeout)
+    : m_count(0), m_failedHandle(nullptr), m_failedIndex(-1), m_retries(0),
+      m_valid(false), m_taken(false) {
+    init(handles.begin(), handles.size(), timeout, MUTEXGUARD_GUARD_SITE());
+}
+
+MultiMutexGuard::MultiMutexGuard(const SemaphoreHandle_t* handles, size_t count, TickType_t timeout)
+    : m_count(0), m_failedHandle(nullptr), m_failedIndex(-1), m_retries(0),
+      m_valid(false), m_taken(false) {
+    init(handles, count, timeout, MUTEXGUARD_GUARD_SITE());
+}
+
+void MultiMutexGuard::fail(size_t index, SemaphoreHandle_t handle) {
+    m_failedIndex = (int)index;
+    m_failedHandle = handle;
+}
+
+void MultiMutexGuard::init(const SemaphoreHandle_t* handles, size_t count, TickType_t timeout,
+                           const void* callSite) {
+    // Check the handle set
+    if (count == 0 || handles == nullptr) {
+        MUTEXG_LOG_W("Attempted to create MultiMutexGuard with no handles");
+        return;
+    }
+    if (count > MUTEXGUARD_MULTI_MAX_LOCKS) {
+        MUTEXG_LOG_E("MultiMutexGuard holds at most %d mutexes, got %u",
+                     MUTEXGUARD_MULTI_MAX_LOCKS, (unsigned)count);
+        fail(MUTEXGUARD_MULTI_MAX_LOCKS, handles[MUTEXGUARD_MULTI_MAX_LOCKS]);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (handles[i] == nullptr) {
+            MUTEXG_LOG_W("Attempted to create MultiMutexGuard with null handle at index %u",
+                         (unsigned)i);
+            fail(i, nullptr);
+            return;
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (handles[j] == handles[i]) {
+                // Taking a non-recursive mutex twice would deadlock
+                MUTEXG_LOG_E("MultiMutexGuard got mutex '%s' twice", MUTEXG_NAME(handles[i]));
+                fail(i, handles[i]);
+                return;
+            }
+        }
+        m_handles[i] = handles[i];
+    }
+    m_count = count;
+
+    // Check if we're in ISR context
+    if (xPortInIsrContext()) {
+        MUTEXG_LOG_E("Cannot use MultiMutexGuard from ISR context (mutex '%s')",
+                     MUTEXG_NAME(m_handles[0]));
+        return;
+    }
+    m_valid = true;
+
+    // The set is ordered against locks already held, not within itself:
+    // the back-off makes any order among its members safe.
+    uint32_t waitStartUs = 0;
+    for (size_t i = 0; i < m_count; i++) {
+        waitStartUs = m_hooks.beforeTake(m_handles[i], callSite, false);
+    }
+
+    TickType_t start = xTaskGetTickCount();
+    size_t first = 0;
+    for (;;) {
+        // Block on one mutex only, while holding none
+        if (xSemaphoreTake(m_handles[first], remainingTicks(start, timeout)) != pdTRUE) {
+            fail(first, m_handles[first]);
+            break;
+        }
+
+        size_t taken = 1;
+        while (taken < m_count &&
+               xSemaphoreTake(m_handles[(first + taken) % m_count], 0) == pdTRUE) {
+            taken++;
+        }
+        if (taken == m_count) {
+            m_taken = true;
+            break;
+        }
+
+        // Back off and wait on the busy one next time round
+        size_t busy = (first + taken) % m_count;
+        giveFrom(first, taken);
+        m_retries++;
+        if (remainingTicks(start, timeout) == 0) {
+            fail(busy, m_handles[busy]);
+            break;
+        }
+        first = busy;
+        taskYIELD();
+    }
+
+    // Every member counts as taken after the whole wait; a timeout is
+    // charged to the mutex that could not be taken
+    if (m_taken) {
+        for (size_t i = 0; i < m_count; i++) {
+            m_hooks.afterTake(m_handles[i], callSite, true, waitStartUs);
+        }
+    } else {
+        m_hooks.afterTake(m_failedHandle, callSite, false, waitStartUs);
+        for (size_t i = 0; i < m_count; i++) {
+            if (m_handles[i] != m_failedHandle) {
+                m_hooks.abandonTake(m_handles[i]);
+            }
+        }
+    }
+
+    if (m_taken) {
+        MUTEX_GUARD_LOG("Locked %u mutexes after %u retries", (unsigned)m_count, (unsigned)m_retries);
+    } else {
+        MUTEX_GUARD_LOG("Mutex '%s' failed to lock (timeout), %u mutexes not taken",
+                        MUTEXG_NAME(m_failedHandle), (unsigned)m_count);
+    }
+}
+
+void MultiMutexGuard::giveFrom(size_t first, size_t taken) {
+    // Release in reverse order of acquisition
+    for (size_t i = taken; i > 0; i--) {
+        xSemaphoreGive(m_handles[(first + i - 1) % m_count]);
+    }
+}
+
+MultiMutexGuard::~MultiMutexGuard() {
+    unlock();
+}
+
+void MultiMutexGuard::unlock() noexcept {
+    if (m_taken) {
+        // Double-check we're not in ISR context
+        if (xPortInIsrContext()) {
+            MUTEXG_LOG_E("Cannot unlock %u mutexes from ISR context", (unsigned)m_count);
+            return;
+        }
+
+        for (size_t i = m_count; i > 0; i--) {
+            SemaphoreHandle_t handle = m_handles[i - 1];
+            m_hooks.release(handle, [&] { xSemaphoreGive(handle); });
+        }
+        m_taken = false;
+
+        MUTEX_GUARD_LOG("Unlocked %u mutexes", (unsigned)m_count);
+    }
+}
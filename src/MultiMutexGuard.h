@@ -0,0 +1,139 @@
+#ifndef _MULTIMUTEXGUARD_H_
+#define _MULTIMUTEXGUARD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <initializer_list>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "GuardHooks.h"
+#include "MutexGuardLogging.h"
+
+#ifndef MUTEXGUARD_MULTI_MAX_LOCKS
+#define MUTEXGUARD_MULTI_MAX_LOCKS 4  ///< Mutexes one MultiMutexGuard can hold
+#endif
+
+/**
+ * @brief RAII guard that locks several mutexes without risking lock-order deadlock
+ *
+ * Nested MutexGuards take their mutexes in the order the code is written, so
+ * two tasks locking the same pair in opposite orders can deadlock. This
+ * guard blocks on only one mutex at a time: it waits for one, then tries the
+ * others without waiting. If one of them is busy it releases everything it
+ * took, yields, and starts over by waiting on the busy one. A task never
+ * waits while holding part of the set, so the order of the handles does not
+ * matter.
+ *
+ * The timeout is one budget for the whole set. On failure nothing is held,
+ * and failedHandle()/failedIndex() tell which mutex could not be taken.
+ *
+ * Usage:
+ * @code
+ * {
+ *     MultiMutexGuard lock({accountA, accountB}, pdMS_TO_TICKS(100));
+ *     if (lock) {
+ *         transfer(a, b);
+ *     } else {
+ *         ESP_LOGW(TAG, "Mutex %d busy", lock.failedIndex());
+ *     }
+ * }
+ * @endcode
+ */
+class MultiMutexGuard {
+public:
+    /**
+     * @brief Construct the guard and attempt to lock all mutexes
+     *
+     * @param handles FreeRTOS mutex handles, at most MUTEXGUARD_MULTI_MAX_LOCKS
+     * @param timeout Timeout in ticks for the whole set (default: 100ms)
+     */
+    explicit MultiMutexGuard(std::initializer_list<SemaphoreHandle_t> handles,
+                             TickType_t timeout = pdMS_TO_TICKS(100));
+
+    /**
+     * @brief Construct the guard from an array of handles
+     *
+     * @param handles Array of FreeRTOS mutex handles
+     * @param count Number of handles, at most MUTEXGUARD_MULTI_MAX_LOCKS
+     * @param timeout Timeout in ticks for the whole set (default: 100ms)
+     */
+    MultiMutexGuard(const SemaphoreHandle_t* handles, size_t count,
+                    TickType_t timeout = pdMS_TO_TICKS(100));
+
+    /**
+     * @brief Destroy the guard and unlock all mutexes if they are held
+     */
+    ~MultiMutexGuard();
+
+    // Delete copy constructor and assignment operator to prevent double-release
+    MultiMutexGuard(const MultiMutexGuard&) = delete;
+    MultiMutexGuard& operator=(const MultiMutexGuard&) = delete;
+
+    // Delete move semantics for safety
+    MultiMutexGuard(MultiMutexGuard&&) = delete;
+    MultiMutexGuard& operator=(MultiMutexGuard&&) = delete;
+
+    /**
+     * @brief Check if every mutex was successfully locked
+     */
+    bool hasLock() const noexcept { return m_taken; }
+
+    /**
+     * @brief Check if the handle set is usable
+     *
+     * False for an empty set, a null or repeated handle, more than
+     * MUTEXGUARD_MULTI_MAX_LOCKS handles, or construction in ISR context.
+     */
+    bool isValid() const noexcept { return m_valid; }
+
+    /**
+     * @brief Unlock all mutexes before the guard is destroyed
+     *
+     * Safe to call multiple times.
+     */
+    void unlock() noexcept;
+
+    /**
+     * @brief Convert to bool for convenient if-statement usage
+     */
+    explicit operator bool() const noexcept { return hasLock(); }
+
+    /**
+     * @brief Number of handles in the set
+     */
+    size_t count() const noexcept { return m_count; }
+
+    /**
+     * @brief Position of the handle that could not be locked or was invalid
+     * @return Index into the handles passed in, -1 if nothing failed
+     */
+    int failedIndex() const noexcept { return m_failedIndex; }
+
+    /**
+     * @brief Handle that could not be locked or was invalid, nullptr if none
+     */
+    SemaphoreHandle_t failedHandle() const noexcept { return m_failedHandle; }
+
+    /**
+     * @brief Times the guard released a partial set and started over
+     */
+    uint32_t retries() const noexcept { return m_retries; }
+
+private:
+    void init(const SemaphoreHandle_t* handles, size_t count, TickType_t timeout, const void* callSite);
+    void fail(size_t index, SemaphoreHandle_t handle);
+    void giveFrom(size_t first, size_t taken);
+
+    SemaphoreHandle_t m_handles[MUTEXGUARD_MULTI_MAX_LOCKS];  ///< The mutexes, in caller order
+    size_t m_count;                   ///< Number of valid entries in m_handles
+    SemaphoreHandle_t m_failedHandle; ///< Handle that failed, nullptr if none
+    int m_failedIndex;                ///< Index of m_failedHandle, -1 if none
+    uint32_t m_retries;               ///< Back-offs during acquisition
+    bool m_valid;                     ///< The handle set is usable
+    bool m_taken;                     ///< Whether all mutexes are held
+    GuardHooks m_hooks;               ///< Diagnostic hook state
+};
+
+#endif // _MULTIMUTEXGUARD_H_
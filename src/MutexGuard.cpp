@@ -1,42 +1,29 @@
 #include "MutexGuard.h"
 
-MutexGuard::MutexGuard(SemaphoreHandle_t handle, TickType_t timeout)
-    : m_handle(handle), m_taken(false) {
-    
-    // Check for null handle
-    if (m_handle == nullptr) {
-        MUTEXG_LOG_W("Attempted to create MutexGuard with null handle");
-        return;
-    }
-    
-    // Check if we're in ISR context
-    if (xPortInIsrContext()) {
-        MUTEXG_LOG_E("Cannot use MutexGuard from ISR context");
-        m_handle = nullptr;  // Invalidate to prevent unlock attempt
-        return;
-    }
-    
-    // Attempt to take the mutex
-    m_taken = (xSemaphoreTake(m_handle, timeout) == pdTRUE);
-    
-    MUTEX_GUARD_LOG("Mutex %s", m_taken ? "locked" : "failed to lock (timeout)");
+#ifndef MUTEXGUARD_HEADER_ONLY
+template class BasicGuard<MutexLockPolicy, DefaultGuardChecks, MutexGuardLog>;
+#endif
+
+void MutexGuardLog::nullHandle() {
+    MUTEXG_LOG_W("Attempted to create MutexGuard with null handle");
 }
 
-MutexGuard::~MutexGuard() {
-    unlock();
+void MutexGuardLog::isrLock(SemaphoreHandle_t handle) {
+    MUTEXG_LOG_E("Cannot use MutexGuard from ISR context (mutex '%s')", MUTEXG_NAME(handle));
 }
 
-void MutexGuard::unlock() noexcept {
-    if (m_taken && m_handle != nullptr) {
-        // Double-check we're not in ISR context
-        if (xPortInIsrContext()) {
-            MUTEXG_LOG_E("Cannot unlock mutex from ISR context");
-            return;
-        }
+void MutexGuardLog::isrUnlock(SemaphoreHandle_t handle) {
+    MUTEXG_LOG_E("Cannot unlock mutex '%s' from ISR context", MUTEXG_NAME(handle));
+}
 
-        xSemaphoreGive(m_handle);
-        m_taken = false;
+void MutexGuardLog::locked(SemaphoreHandle_t handle, bool taken) {
+    (void)handle;
+    (void)taken;
+    MUTEX_GUARD_LOG("Mutex '%s' %s", MUTEXG_NAME(handle),
+                    taken ? "locked" : "failed to lock (timeout)");
+}
 
-        MUTEX_GUARD_LOG("Mutex unlocked");
-    }
-}
\ No newline at end of file
+void MutexGuardLog::unlocked(SemaphoreHandle_t handle) {
+    (void)handle;
+    MUTEX_GUARD_LOG("Mutex '%s' unlocked", MUTEXG_NAME(handle));
+}
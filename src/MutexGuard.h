@@ -3,7 +3,27 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include "BasicGuard.h"
 #include "MutexGuardLogging.h"
+#include "MutexGuardStats.h"
+
+/**
+ * @brief Log policy for MutexGuard: MUTEXG_LOG_* and MUTEX_GUARD_LOG
+ *
+ * Defined in MutexGuard.cpp, so the library's debug flags decide what is logged.
+ */
+struct MutexGuardLog {
+#ifdef MUTEX_GUARD_DEBUG
+    static const bool verbose = true;
+#else
+    static const bool verbose = false;  ///< Lock/unlock messages compiled out
+#endif
+    MUTEXGUARD_COLD static void nullHandle();
+    MUTEXGUARD_COLD static void isrLock(SemaphoreHandle_t handle);
+    MUTEXGUARD_COLD static void isrUnlock(SemaphoreHandle_t handle);
+    MUTEXGUARD_COLD static void locked(SemaphoreHandle_t handle, bool taken);
+    MUTEXGUARD_COLD static void unlocked(SemaphoreHandle_t handle);
+};
 
 /**
  * @brief RAII mutex guard for automatic mutex management
@@ -31,59 +51,14 @@
  *     }
  * }
  * @endcode
+ *
+ * An instantiation of BasicGuard with all checks enabled, compiled once in
+ * MutexGuard.cpp, or inlined at each use when MUTEXGUARD_HEADER_ONLY is defined.
  */
-class MutexGuard {
-public:
-    /**
-     * @brief Construct a new Mutex Guard and attempt to lock the mutex
-     * 
-     * @param handle The FreeRTOS mutex handle to lock
-     * @param timeout Timeout in ticks to wait for the mutex (default: 100ms)
-     */
-    explicit MutexGuard(SemaphoreHandle_t handle, TickType_t timeout = pdMS_TO_TICKS(100));
-    
-    /**
-     * @brief Destroy the Mutex Guard and unlock the mutex if it was locked
-     */
-    ~MutexGuard();
-    
-    // Delete copy constructor and assignment operator to prevent double-release
-    MutexGuard(const MutexGuard&) = delete;
-    MutexGuard& operator=(const MutexGuard&) = delete;
-    
-    // Delete move semantics for safety
-    MutexGuard(MutexGuard&&) = delete;
-    MutexGuard& operator=(MutexGuard&&) = delete;
-    
-    /**
-     * @brief Check if the mutex was successfully locked
-     * @return true if the mutex is currently held by this guard
-     */
-    bool hasLock() const noexcept { return m_taken; }
+typedef BasicGuard<MutexLockPolicy, DefaultGuardChecks, MutexGuardLog> MutexGuard;
 
-    /**
-     * @brief Check if the mutex handle is valid
-     * @return true if the mutex handle is not null
-     */
-    bool isValid() const noexcept { return m_handle != nullptr; }
-
-    /**
-     * @brief Manually unlock the mutex before the guard is destroyed
-     *
-     * This method is safe to call multiple times. After calling unlock(),
-     * hasLock() will return false.
-     */
-    void unlock() noexcept;
-
-    /**
-     * @brief Convert to bool for convenient if-statement usage
-     * @return true if the mutex is locked
-     */
-    explicit operator bool() const noexcept { return hasLock(); }
-
-private:
-    SemaphoreHandle_t m_handle;  ///< The mutex handle
-    bool m_taken;                ///< Whether the mutex was successfully taken
-};
+#ifndef MUTEXGUARD_HEADER_ONLY
+extern template class BasicGuard<MutexLockPolicy, DefaultGuardChecks, MutexGuardLog>;
+#endif
 
-#endif // _MUTEXGUARD_H_
\ No newline at end of file
+#endif // _MUTEXGUARD_H_
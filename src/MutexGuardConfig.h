@@ -0,0 +1,27 @@
+#ifndef _MUTEXGUARDCONFIG_H_
+#define _MUTEXGUARDCONFIG_H_
+
+/**
+ * @file MutexGuardConfig.h
+ * @brief Build settings shared by several MutexGuard components
+ *
+ * Each setting can be overridden for the whole build, e.g.
+ * `build_flags = -DMUTEXGUARD_CACHE_LINE_SIZE=4`.
+ */
+
+/**
+ * @brief Padding between data written by different cores
+ *
+ * SpscRing, MpmcQueue, ShardedCounter and the LockTrace rings align their
+ * per-core or per-side data to this size so that two cores never write the
+ * same cache line. Internal SRAM on the original ESP32 is not cached; define
+ * it as 4 there to save the padding.
+ *
+ * The alignment is only honoured by `new` from C++17 on, so prefer static
+ * instances or members of statically allocated objects for these types.
+ */
+#ifndef MUTEXGUARD_CACHE_LINE_SIZE
+#define MUTEXGUARD_CACHE_LINE_SIZE 64
+#endif
+
+#endif // _MUTEXGUARDCONFIG_H_
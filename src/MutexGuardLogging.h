@@ -4,6 +4,7 @@
 #define MUTEXG_LOG_TAG "MutexGuard"
 
 #include <esp_log.h>  // Required for ESP_LOG_* constants
+#include "MutexRegistry.h"
 
 // Define log levels based on debug flag
 #ifdef MUTEXGUARD_DEBUG
@@ -22,8 +23,34 @@
     #define MUTEXG_LOG_LEVEL_V ESP_LOG_NONE  // Suppress
 #endif
 
-// Route to custom logger or ESP-IDF
-#ifdef USE_CUSTOM_LOGGER
+// Route to the binary or deferred backend, custom logger or ESP-IDF
+#if defined(MUTEXGUARD_BINARY_LOG)
+    // Unformatted records, decoded on the host by tools/binary_log.py
+    #include "BinaryLog.h"
+    #define MUTEXG_LOG_E(...) MUTEXGUARD_BINARY_WRITE(MUTEXG_LOG_LEVEL_E, MUTEXG_LOG_TAG, __VA_ARGS__)
+    #define MUTEXG_LOG_W(...) MUTEXGUARD_BINARY_WRITE(MUTEXG_LOG_LEVEL_W, MUTEXG_LOG_TAG, __VA_ARGS__)
+    #define MUTEXG_LOG_I(...) MUTEXGUARD_BINARY_WRITE(MUTEXG_LOG_LEVEL_I, MUTEXG_LOG_TAG, __VA_ARGS__)
+    #ifdef MUTEXGUARD_DEBUG
+        #define MUTEXG_LOG_D(...) MUTEXGUARD_BINARY_WRITE(MUTEXG_LOG_LEVEL_D, MUTEXG_LOG_TAG, __VA_ARGS__)
+        #define MUTEXG_LOG_V(...) MUTEXGUARD_BINARY_WRITE(MUTEXG_LOG_LEVEL_V, MUTEXG_LOG_TAG, __VA_ARGS__)
+    #else
+        #define MUTEXG_LOG_D(...) ((void)0)
+        #define MUTEXG_LOG_V(...) ((void)0)
+    #endif
+#elif defined(MUTEXGUARD_DEFERRED_LOG)
+    // Capture now, format and print later in the DeferredLog task
+    #include "DeferredLog.h"
+    #define MUTEXG_LOG_E(...) MUTEXGUARD_DEFERRED_WRITE(MUTEXG_LOG_LEVEL_E, MUTEXG_LOG_TAG, __VA_ARGS__)
+    #define MUTEXG_LOG_W(...) MUTEXGUARD_DEFERRED_WRITE(MUTEXG_LOG_LEVEL_W, MUTEXG_LOG_TAG, __VA_ARGS__)
+    #define MUTEXG_LOG_I(...) MUTEXGUARD_DEFERRED_WRITE(MUTEXG_LOG_LEVEL_I, MUTEXG_LOG_TAG, __VA_ARGS__)
+    #ifdef MUTEXGUARD_DEBUG
+        #define MUTEXG_LOG_D(...) MUTEXGUARD_DEFERRED_WRITE(MUTEXG_LOG_LEVEL_D, MUTEXG_LOG_TAG, __VA_ARGS__)
+        #define MUTEXG_LOG_V(...) MUTEXGUARD_DEFERRED_WRITE(MUTEXG_LOG_LEVEL_V, MUTEXG_LOG_TAG, __VA_ARGS__)
+    #else
+        #define MUTEXG_LOG_D(...) ((void)0)
+        #define MUTEXG_LOG_V(...) ((void)0)
+    #endif
+#elif defined(USE_CUSTOM_LOGGER)
     #include <LogInterface.h>
     #define MUTEXG_LOG_E(...) LOG_WRITE(MUTEXG_LOG_LEVEL_E, MUTEXG_LOG_TAG, __VA_ARGS__)
     #define MUTEXG_LOG_W(...) LOG_WRITE(MUTEXG_LOG_LEVEL_W, MUTEXG_LOG_TAG, __VA_ARGS__)
@@ -45,6 +72,9 @@
     #endif
 #endif
 
+// Printable mutex identity: the name from MutexRegistry, else the address
+#define MUTEXG_NAME(handle) MutexRegistry::displayName(handle)
+
 // Keep backward compatibility with old debug macro
 #ifdef MUTEX_GUARD_DEBUG
     #define MUTEX_GUARD_LOG(...) MUTEXG_LOG_I(__VA_ARGS__)
@@ -0,0 +1,249 @@
+#include "MutexGuardStats.h"
+
+#ifdef MUTEXGUARD_STATS
+
+#include <atomic>
+
+#include "HandleHash.h"
+
+namespace {
+
+/**
+ * 64-bit sum kept as two 32-bit words. std::atomic<uint64_t> is not
+ * lock-free on 32-bit Xtensa (it falls back to a libatomic lock), so the
+ * carry is propagated by hand instead: the writer that wraps the low word
+ * bumps the high word, and readers retry until the high word is stable. A
+ * read that lands between the wrap and the carry is short by 2^32 for that
+ * one snapshot, which is within the "may mix updates" caveat of snapshot().
+ */
+struct SplitCounter {
+    std::atomic<uint32_t> low;
+    std::atomic<uint32_t> high;
+
+    void add(uint32_t value) {
+        uint32_t previous = low.fetch_add(value, std::memory_order_relaxed);
+        if ((uint32_t)(previous + value) < previous) {
+            high.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t load() const {
+        uint32_t hi, lo;
+        do {
+            hi = high.load(std::memory_order_acquire);
+            lo = low.load(std::memory_order_acquire);
+        } while (hi != high.load(std::memory_order_acquire));
+        return ((uint64_t)hi << 32) | lo;
+    }
+
+    void clear() {
+        low.store(0, std::memory_order_relaxed);
+        high.store(0, std::memory_order_relaxed);
+    }
+};
+
+struct StatsSlot {
+    std::atomic<SemaphoreHandle_t> handle;
+    std::atomic<uint32_t> acquisitions;
+    std::atomic<uint32_t> failedAcquisitions;
+    SplitCounter totalWaitUs;
+    std::atomic<uint32_t> maxWaitUs;
+    SplitCounter totalHoldUs;
+    std::atomic<uint32_t> maxHoldUs;
+#ifdef MUTEXGUARD_STATS_HISTOGRAM
+    LatencyHistogram waitHistogram;
+    LatencyHistogram holdHistogram;
+#endif
+};
+
+// Zero-initialized static storage: every slot starts empty
+StatsSlot g_slots[MUTEXGUARD_STATS_MAX_MUTEXES];
+std::atomic<uint32_t> g_droppedRecords(0);
+
+size_t homeSlot(SemaphoreHandle_t handle) {
+    return mutexguardHomeSlot(handle, MUTEXGUARD_STATS_MAX_MUTEXES);
+}
+
+/**
+ * Open-addressed lookup with linear probing. Slots are claimed with a CAS
+ * and never released individually, so a probe can stop at the first empty
+ * slot.
+ */
+StatsSlot* findSlot(SemaphoreHandle_t handle, bool claim) {
+    size_t index = homeSlot(handle);
+    for (size_t probe = 0; probe < MUTEXGUARD_STATS_MAX_MUTEXES; probe++) {
+        StatsSlot& slot = g_slots[index];
+        SemaphoreHandle_t current = slot.handle.load(std::memory_order_acquire);
+        if (current == handle) {
+            return &slot;
+        }
+        if (current == nullptr) {
+            if (!claim) {
+                return nullptr;
+            }
+            if (slot.handle.compare_exchange_strong(current, handle, std::memory_order_acq_rel) ||
+                current == handle) {
+                return &slot;
+            }
+        }
+        index = (index + 1) % MUTEXGUARD_STATS_MAX_MUTEXES;
+    }
+    if (claim) {
+        g_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+    }
+    return nullptr;
+}
+
+void updateMax(std::atomic<uint32_t>& target, uint32_t value) {
+    uint32_t current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void clearCounters(StatsSlot& slot) {
+    slot.acquisitions.store(0, std::memory_order_relaxed);
+    slot.failedAcquisitions.store(0, std::memory_order_relaxed);
+    slot.totalWaitUs.clear();
+    slot.maxWaitUs.store(0, std::memory_order_relaxed);
+    slot.totalHoldUs.clear();
+    slot.maxHoldUs.store(0, std::memory_order_relaxed);
+#ifdef MUTEXGUARD_STATS_HISTOGRAM
+    slot.waitHistogram.reset();
+    slot.holdHistogram.reset();
+#endif
+}
+
+void copySlot(const StatsSlot& slot, SemaphoreHandle_t handle, MutexStatsSnapshot& out) {
+    out.handle = handle;
+    out.acquisitions = slot.acquisitions.load(std::memory_order_relaxed);
+    out.failedAcquisitions = slot.failedAcquisitions.load(std::memory_order_relaxed);
+    out.totalWaitUs = slot.totalWaitUs.load();
+    out.maxWaitUs = slot.maxWaitUs.load(std::memory_order_relaxed);
+    out.totalHoldUs = slot.totalHoldUs.load();
+    out.maxHoldUs = slot.maxHoldUs.load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+void MutexGuardStats::recordAcquire(SemaphoreHandle_t handle, uint32_t waitUs, bool acquired) {
+    StatsSlot* slot = findSlot(handle, true);
+    if (slot == nullptr) {
+        return;
+    }
+    if (acquired) {
+        slot->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        slot->failedAcquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+    slot->totalWaitUs.add(waitUs);
+    updateMax(slot->maxWaitUs, waitUs);
+#ifdef MUTEXGUARD_STATS_HISTOGRAM
+    slot->waitHistogram.record(waitUs);
+#endif
+}
+
+void MutexGuardStats::recordRelease(SemaphoreHandle_t handle, uint32_t holdUs) {
+    StatsSlot* slot = findSlot(handle, true);
+    if (slot == nullptr) {
+        return;
+    }
+    slot->totalHoldUs.add(holdUs);
+    updateMax(slot->maxHoldUs, holdUs);
+#ifdef MUTEXGUARD_STATS_HISTOGRAM
+    slot->holdHistogram.record(holdUs);
+#endif
+}
+
+bool MutexGuardStats::snapshot(SemaphoreHandle_t handle, MutexStatsSnapshot& out) {
+    if (handle == nullptr) {
+        return false;
+    }
+    const StatsSlot* slot = findSlot(handle, false);
+    if (slot == nullptr) {
+        return false;
+    }
+    copySlot(*slot, handle, out);
+    return true;
+}
+
+size_t MutexGuardStats::snapshotAll(MutexStatsSnapshot* out, size_t capacity) {
+    size_t count = 0;
+    for (size_t i = 0; i < MUTEXGUARD_STATS_MAX_MUTEXES && count < capacity; i++) {
+        SemaphoreHandle_t handle = g_slots[i].handle.load(std::memory_order_acquire);
+        if (handle != nullptr) {
+            copySlot(g_slots[i], handle, out[count++]);
+        }
+    }
+    return count;
+}
+
+#ifdef MUTEXGUARD_STATS_HISTOGRAM
+namespace {
+
+void fillPercentiles(const LatencyHistogram::Snapshot& snap, MutexPercentiles& out) {
+    out.samples = snap.total;
+    out.p50Us = snap.percentile(0.50);
+    out.p90Us = snap.percentile(0.90);
+    out.p99Us = snap.percentile(0.99);
+    out.p999Us = snap.percentile(0.999);
+}
+
+} // namespace
+
+bool MutexGuardStats::percentiles(SemaphoreHandle_t handle, MutexPercentiles& wait,
+                                  MutexPercentiles& hold) {
+    if (handle == nullptr) {
+        return false;
+    }
+    const StatsSlot* slot = findSlot(handle, false);
+    if (slot == nullptr) {
+        return false;
+    }
+    // One histogram copy at a time keeps the stack cost to ~380 bytes
+    LatencyHistogram::Snapshot snap;
+    slot->waitHistogram.snapshot(snap);
+    fillPercentiles(snap, wait);
+    slot->holdHistogram.snapshot(snap);
+    fillPercentiles(snap, hold);
+    return true;
+}
+
+bool MutexGuardStats::histograms(SemaphoreHandle_t handle, MutexHistogramSnapshot& out) {
+    if (handle == nullptr) {
+        return false;
+    }
+    const StatsSlot* slot = findSlot(handle, false);
+    if (slot == nullptr) {
+        return false;
+    }
+    out.handle = handle;
+    slot->waitHistogram.snapshot(out.waitUs);
+    slot->holdHistogram.snapshot(out.holdUs);
+    return true;
+}
+#endif // MUTEXGUARD_STATS_HISTOGRAM
+
+void MutexGuardStats::reset(SemaphoreHandle_t handle) {
+    if (handle == nullptr) {
+        return;
+    }
+    StatsSlot* slot = findSlot(handle, false);
+    if (slot != nullptr) {
+        clearCounters(*slot);
+    }
+}
+
+void MutexGuardStats::resetAll() {
+    for (size_t i = 0; i < MUTEXGUARD_STATS_MAX_MUTEXES; i++) {
+        clearCounters(g_slots[i]);
+        g_slots[i].handle.store(nullptr, std::memory_order_release);
+    }
+    g_droppedRecords.store(0, std::memory_order_relaxed);
+}
+
+uint32_t MutexGuardStats::droppedRecords() {
+    return g_droppedRecords.load(std::memory_order_relaxed);
+}
+
+#endif // MUTEXGUARD_STATS
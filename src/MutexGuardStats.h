@@ -0,0 +1,162 @@
+#ifndef _MUTEXGUARDSTATS_H_
+#define _MUTEXGUARDSTATS_H_
+
+/**
+ * @file MutexGuardStats.h
+ * @brief Opt-in per-mutex contention statistics recorded by the guards
+ *
+ * Compiled out unless MUTEXGUARD_STATS is defined for the whole build
+ * (library and application), e.g. `build_flags = -DMUTEXGUARD_STATS`.
+ * MUTEXGUARD_STATS_HISTOGRAM additionally keeps wait- and hold-time
+ * histograms per handle (and implies MUTEXGUARD_STATS).
+ */
+
+// Histograms are an extension of the statistics layer
+#if defined(MUTEXGUARD_STATS_HISTOGRAM) && !defined(MUTEXGUARD_STATS)
+#define MUTEXGUARD_STATS
+#endif
+
+#ifdef MUTEXGUARD_STATS
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+
+#ifdef MUTEXGUARD_STATS_HISTOGRAM
+#include "LatencyHistogram.h"
+#endif
+
+#ifndef MUTEXGUARD_STATS_MAX_MUTEXES
+#define MUTEXGUARD_STATS_MAX_MUTEXES 32  ///< Number of distinct handles tracked
+#endif
+
+/**
+ * @brief Point-in-time copy of the counters for one mutex handle
+ */
+struct MutexStatsSnapshot {
+    SemaphoreHandle_t handle;     ///< The mutex these counters belong to
+    uint32_t acquisitions;        ///< Successful lock acquisitions
+    uint32_t failedAcquisitions;  ///< Acquisitions that timed out
+    uint64_t totalWaitUs;         ///< Time spent waiting, successful or not
+    uint32_t maxWaitUs;           ///< Longest single wait
+    uint64_t totalHoldUs;         ///< Time the mutex was held through a guard
+    uint32_t maxHoldUs;           ///< Longest single hold
+};
+
+#ifdef MUTEXGUARD_STATS_HISTOGRAM
+/**
+ * @brief Latency percentiles for one mutex, in microseconds
+ *
+ * Each value is the upper bound of the histogram bucket holding that
+ * percentile (see LatencyHistogram), so it overestimates by at most the
+ * bucket width.
+ */
+struct MutexPercentiles {
+    uint32_t samples;  ///< Number of recorded samples
+    uint32_t p50Us;
+    uint32_t p90Us;
+    uint32_t p99Us;
+    uint32_t p999Us;
+};
+
+/**
+ * @brief Full wait- and hold-time histograms for one mutex
+ *
+ * About 750 bytes with the default bucket layout: prefer a static or
+ * heap-allocated instance over a task stack.
+ */
+struct MutexHistogramSnapshot {
+    SemaphoreHandle_t handle;
+    LatencyHistogram::Snapshot waitUs;  ///< Every wait, including timeouts
+    LatencyHistogram::Snapshot holdUs;  ///< Every hold through a guard
+};
+#endif // MUTEXGUARD_STATS_HISTOGRAM
+
+/**
+ * @brief Fixed-capacity statistics table keyed by mutex handle
+ *
+ * MutexGuard and RecursiveMutexGuard record into this table from their
+ * constructor (wait time, success or timeout) and from unlock() (hold time).
+ * Each handle claims a slot on first use; once all
+ * MUTEXGUARD_STATS_MAX_MUTEXES slots are taken, events for further handles
+ * are only counted in droppedRecords().
+ *
+ * Recording uses lock-free 32-bit atomics only and never blocks, so it does
+ * not add contention to the mutex being measured (the 64-bit totals are
+ * kept as two words, since 64-bit atomics take a lock on 32-bit Xtensa).
+ * All storage is static; nothing is allocated at runtime. Snapshots taken
+ * while guards are active may mix counters from before and after a
+ * concurrent update.
+ *
+ * MUTEXGUARD_STATS_HISTOGRAM adds two histograms to every slot, about
+ * 750 bytes with the default bucket layout. With the default 32 slots
+ * that is roughly 24 KB of static RAM; lower MUTEXGUARD_STATS_MAX_MUTEXES
+ * or MUTEXGUARD_HISTOGRAM_MAX_BITS if that is too much.
+ *
+ * Usage:
+ * @code
+ * MutexStatsSnapshot stats;
+ * if (MutexGuardStats::snapshot(myMutex, stats)) {
+ *     ESP_LOGI(TAG, "waits: %u failed, max %u us", stats.failedAcquisitions, stats.maxWaitUs);
+ * }
+ * @endcode
+ */
+class MutexGuardStats {
+public:
+    /**
+     * @brief Copy the counters of one handle
+     * @return false if the handle has never been recorded
+     */
+    static bool snapshot(SemaphoreHandle_t handle, MutexStatsSnapshot& out);
+
+    /**
+     * @brief Copy the counters of every tracked handle
+     * @return Number of entries written to out (at most capacity)
+     */
+    static size_t snapshotAll(MutexStatsSnapshot* out, size_t capacity);
+
+#ifdef MUTEXGUARD_STATS_HISTOGRAM
+    /**
+     * @brief Wait- and hold-time percentiles of one handle
+     * @return false if the handle has never been recorded
+     */
+    static bool percentiles(SemaphoreHandle_t handle, MutexPercentiles& wait, MutexPercentiles& hold);
+
+    /**
+     * @brief Copy the full wait- and hold-time histograms of one handle
+     * @return false if the handle has never been recorded
+     */
+    static bool histograms(SemaphoreHandle_t handle, MutexHistogramSnapshot& out);
+#endif
+
+    /**
+     * @brief Zero the counters of one handle, keeping its slot
+     */
+    static void reset(SemaphoreHandle_t handle);
+
+    /**
+     * @brief Zero all counters and release all slots
+     *
+     * Call this when no guards are active, e.g. after deleting mutexes.
+     */
+    static void resetAll();
+
+    /**
+     * @brief Number of events not recorded because the table was full
+     */
+    static uint32_t droppedRecords();
+
+    /// @name Recording interface used by the guards
+    /// @{
+    static uint32_t nowUs() { return (uint32_t)esp_timer_get_time(); }
+    static void recordAcquire(SemaphoreHandle_t handle, uint32_t waitUs, bool acquired);
+    static void recordRelease(SemaphoreHandle_t handle, uint32_t holdUs);
+    /// @}
+};
+
+#endif // MUTEXGUARD_STATS
+
+#endif // _MUTEXGUARDSTATS_H_
@@ -0,0 +1,212 @@
+#include "MutexRegistry.h"
+
+#include <stdio.h>
+
+#include <atomic>
+
+#include "HandleHash.h"
+
+namespace {
+
+struct RegistrySlot {
+    std::atomic<SemaphoreHandle_t> handle;
+    std::atomic<const char*> name;
+    std::atomic<const char*> module;
+    std::atomic<uint32_t> maxHoldUs;
+};
+
+// Zero-initialized static storage: every slot starts empty
+RegistrySlot g_slots[MUTEXGUARD_REGISTRY_CAPACITY];
+std::atomic<size_t> g_size(0);
+
+// Serializes writers; readers never take it
+portMUX_TYPE g_writeLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Odd while unregisterMutex() moves entries; readers retry if it changed
+std::atomic<uint32_t> g_moveSequence(0);
+
+const size_t kDisplayBuffers = 4;
+const size_t kDisplayBufferSize = 2 + 2 * sizeof(void*) + 1;  // "0x" + hex digits + NUL
+char g_displayBuffers[kDisplayBuffers][kDisplayBufferSize];
+std::atomic<uint32_t> g_nextDisplayBuffer(0);
+
+size_t homeSlot(SemaphoreHandle_t handle) {
+    return mutexguardHomeSlot(handle, MUTEXGUARD_REGISTRY_CAPACITY);
+}
+
+size_t nextSlot(size_t index) {
+    return (index + 1) % MUTEXGUARD_REGISTRY_CAPACITY;
+}
+
+RegistrySlot* findSlot(SemaphoreHandle_t handle) {
+    size_t index = homeSlot(handle);
+    for (size_t probe = 0; probe < MUTEXGUARD_REGISTRY_CAPACITY; probe++) {
+        RegistrySlot& slot = g_slots[index];
+        SemaphoreHandle_t current = slot.handle.load(std::memory_order_acquire);
+        if (current == handle) {
+            return &slot;
+        }
+        if (current == nullptr) {
+            return nullptr;
+        }
+        index = nextSlot(index);
+    }
+    return nullptr;
+}
+
+/**
+ * Lock-free lookup for readers. A removal can move an entry behind a reader
+ * that is still probing, or over the slot it is copying, so the copy only
+ * counts if no removal ran meanwhile (a seqlock read, as in SeqLocked).
+ */
+bool readEntry(SemaphoreHandle_t handle, MutexInfo& out) {
+    for (;;) {
+        uint32_t before = g_moveSequence.load(std::memory_order_acquire);
+        if (before & 1u) {
+            continue;  // Removals are a few slot copies; the writer is nearly done
+        }
+        const RegistrySlot* slot = findSlot(handle);
+        if (slot != nullptr) {
+            out.handle = handle;
+            out.name = slot->name.load(std::memory_order_relaxed);
+            out.module = slot->module.load(std::memory_order_relaxed);
+            out.maxHoldUs = slot->maxHoldUs.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (g_moveSequence.load(std::memory_order_relaxed) == before) {
+            return slot != nullptr;
+        }
+    }
+}
+
+void copySlot(RegistrySlot& to, const RegistrySlot& from) {
+    to.name.store(from.name.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    to.module.store(from.module.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    to.maxHoldUs.store(from.maxHoldUs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    to.handle.store(from.handle.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+} // namespace
+
+bool MutexRegistry::registerMutex(SemaphoreHandle_t handle, const char* name, const char* module,
+                                  uint32_t maxHoldUs) {
+    if (handle == nullptr) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&g_writeLock);
+
+    // Update in place if present, otherwise take the first free slot on the
+    // probe chain.
+    RegistrySlot* target = findSlot(handle);
+    bool isNew = (target == nullptr);
+    if (isNew) {
+        size_t index = homeSlot(handle);
+        for (size_t probe = 0; probe < MUTEXGUARD_REGISTRY_CAPACITY; probe++) {
+            SemaphoreHandle_t current = g_slots[index].handle.load(std::memory_order_relaxed);
+            if (current == nullptr) {
+                target = &g_slots[index];
+                break;
+            }
+            index = nextSlot(index);
+        }
+    }
+
+    if (target != nullptr) {
+        // Metadata first, handle last: a reader that matches the handle
+        // sees the complete entry.
+        target->name.store(name, std::memory_order_relaxed);
+        target->module.store(module, std::memory_order_relaxed);
+        target->maxHoldUs.store(maxHoldUs, std::memory_order_relaxed);
+        target->handle.store(handle, std::memory_order_release);
+        if (isNew) {
+            g_size.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    portEXIT_CRITICAL(&g_writeLock);
+    return target != nullptr;
+}
+
+bool MutexRegistry::unregisterMutex(SemaphoreHandle_t handle) {
+    if (handle == nullptr) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&g_writeLock);
+    RegistrySlot* slot = findSlot(handle);
+    if (slot != nullptr) {
+        uint32_t sequence = g_moveSequence.load(std::memory_order_relaxed);
+        g_moveSequence.store(sequence + 1, std::memory_order_relaxed);
+        // Orders the odd sequence before the slot stores
+        std::atomic_thread_fence(std::memory_order_release);
+
+        // Backward-shift deletion: pull later entries of the probe chain
+        // into the hole unless that would move them before their home slot,
+        // so chains never contain dead slots and misses stay short.
+        size_t hole = (size_t)(slot - g_slots);
+        size_t index = nextSlot(hole);
+        for (size_t probe = 1; probe < MUTEXGUARD_REGISTRY_CAPACITY; probe++) {
+            SemaphoreHandle_t current = g_slots[index].handle.load(std::memory_order_relaxed);
+            if (current == nullptr) {
+                break;
+            }
+            size_t home = homeSlot(current);
+            bool homeInGap = (hole <= index) ? (hole < home && home <= index)
+                                             : (hole < home || home <= index);
+            if (!homeInGap) {
+                copySlot(g_slots[hole], g_slots[index]);
+                hole = index;
+            }
+            index = nextSlot(index);
+        }
+        g_slots[hole].handle.store(nullptr, std::memory_order_release);
+        g_size.fetch_sub(1, std::memory_order_relaxed);
+
+        g_moveSequence.store(sequence + 2, std::memory_order_release);
+    }
+    portEXIT_CRITICAL(&g_writeLock);
+    return slot != nullptr;
+}
+
+bool MutexRegistry::lookup(SemaphoreHandle_t handle, MutexInfo& out) {
+    if (handle == nullptr) {
+        return false;
+    }
+    return readEntry(handle, out);
+}
+
+const char* MutexRegistry::nameOf(SemaphoreHandle_t handle) {
+    MutexInfo info;
+    if (handle == nullptr || !readEntry(handle, info)) {
+        return nullptr;
+    }
+    return info.name;
+}
+
+const char* MutexRegistry::displayName(SemaphoreHandle_t handle) {
+    const char* name = nameOf(handle);
+    if (name != nullptr) {
+        return name;
+    }
+    uint32_t index = g_nextDisplayBuffer.fetch_add(1, std::memory_order_relaxed) % kDisplayBuffers;
+    snprintf(g_displayBuffers[index], kDisplayBufferSize, "%p", (void*)handle);
+    return g_displayBuffers[index];
+}
+
+size_t MutexRegistry::size() {
+    return g_size.load(std::memory_order_relaxed);
+}
+
+void MutexRegistry::clear() {
+    portENTER_CRITICAL(&g_writeLock);
+    uint32_t sequence = g_moveSequence.load(std::memory_order_relaxed);
+    g_moveSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < MUTEXGUARD_REGISTRY_CAPACITY; i++) {
+        g_slots[i].handle.store(nullptr, std::memory_order_release);
+    }
+    g_size.store(0, std::memory_order_relaxed);
+    g_moveSequence.store(sequence + 2, std::memory_order_release);
+    portEXIT_CRITICAL(&g_writeLock);
+}
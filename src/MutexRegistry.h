@@ -0,0 +1,102 @@
+#ifndef _MUTEXREGISTRY_H_
+#define _MUTEXREGISTRY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#ifndef MUTEXGUARD_REGISTRY_CAPACITY
+#define MUTEXGUARD_REGISTRY_CAPACITY 32  ///< Maximum number of named mutexes
+#endif
+
+/**
+ * @brief Diagnostic metadata attached to a mutex handle
+ */
+struct MutexInfo {
+    SemaphoreHandle_t handle;  ///< The registered mutex
+    const char* name;          ///< Human-readable name, e.g. "i2c_bus"
+    const char* module;        ///< Owning module, or nullptr
+    uint32_t maxHoldUs;        ///< Expected maximum hold time, 0 if unspecified
+};
+
+/**
+ * @brief Fixed-capacity registry mapping mutex handles to names
+ *
+ * SemaphoreHandle_t values are opaque, so logs and statistics can otherwise
+ * only show addresses. Register each long-lived mutex once after creating it;
+ * the guard log messages then print its name.
+ *
+ * Lookups are lock-free and O(1) on average (open addressing keyed by the
+ * handle), so they are cheap enough for the guard hot path. Registration
+ * and removal take a short critical section. Removal shifts the rest of the
+ * probe chain back instead of leaving a tombstone, so lookups stay short
+ * after any amount of register/unregister churn.
+ *
+ * The name and module strings are stored by pointer and must outlive the
+ * registration (string literals are the usual choice).
+ *
+ * Usage:
+ * @code
+ * i2cMutex = xSemaphoreCreateMutex();
+ * MutexRegistry::registerMutex(i2cMutex, "i2c_bus", "sensors", 500);
+ *
+ * MutexGuard lock(i2cMutex);  // Debug logs now read "Mutex 'i2c_bus' locked"
+ * @endcode
+ */
+class MutexRegistry {
+public:
+    /**
+     * @brief Attach a name and metadata to a handle
+     *
+     * Registering an already registered handle replaces its metadata.
+     *
+     * @param handle The mutex handle
+     * @param name Human-readable name (must outlive the registration)
+     * @param module Owning module, or nullptr
+     * @param maxHoldUs Expected maximum hold time in microseconds, 0 if unspecified
+     * @return false if the handle is null or the registry is full
+     */
+    static bool registerMutex(SemaphoreHandle_t handle, const char* name,
+                              const char* module = nullptr, uint32_t maxHoldUs = 0);
+
+    /**
+     * @brief Remove a handle, e.g. before deleting the mutex
+     * @return false if the handle was not registered
+     */
+    static bool unregisterMutex(SemaphoreHandle_t handle);
+
+    /**
+     * @brief Copy the metadata of a handle
+     * @return false if the handle is not registered
+     */
+    static bool lookup(SemaphoreHandle_t handle, MutexInfo& out);
+
+    /**
+     * @brief Registered name of a handle
+     * @return The name, or nullptr if the handle is not registered
+     */
+    static const char* nameOf(SemaphoreHandle_t handle);
+
+    /**
+     * @brief Printable identity of a handle for log messages
+     *
+     * @return The registered name, or the handle address formatted into one
+     *         of a few rotating static buffers (valid until several further
+     *         calls, which is enough for a log statement)
+     */
+    static const char* displayName(SemaphoreHandle_t handle);
+
+    /**
+     * @brief Number of registered handles
+     */
+    static size_t size();
+
+    /**
+     * @brief Remove all registrations
+     */
+    static void clear();
+};
+
+#endif // _MUTEXREGISTRY_H_
@@ -0,0 +1,148 @@
+#include "NotifyMutex.h"
+
+NotifyMutex::NotifyMutex() : m_state(kUnlocked), m_waiters(nullptr) {
+    portMUX_INITIALIZE(&m_waitLock);
+}
+
+void NotifyMutex::enqueue(Waiter* waiter) {
+    // Behind every waiter of the same or higher priority
+    Waiter** link = &m_waiters;
+    while (*link != nullptr && (*link)->priority >= waiter->priority) {
+        link = &(*link)->next;
+    }
+    waiter->next = *link;
+    *link = waiter;
+}
+
+void NotifyMutex::remove(Waiter* waiter) {
+    for (Waiter** link = &m_waiters; *link != nullptr; link = &(*link)->next) {
+        if (*link == waiter) {
+            *link = waiter->next;
+            return;
+        }
+    }
+}
+
+bool NotifyMutex::lockSlow(TickType_t timeout) {
+    if (timeout == 0 || xPortInIsrContext()) {
+        return false;
+    }
+
+    TickType_t start = xTaskGetTickCount();
+    Waiter self;
+    self.task = xTaskGetCurrentTaskHandle();
+    self.priority = uxTaskPriorityGet(nullptr);
+    self.next = nullptr;
+    self.granted = false;
+
+    // Take the lock if it was released in the meantime; otherwise mark it
+    // contended so the owner's unlock() takes the slow path and finds us.
+    portENTER_CRITICAL(&m_waitLock);
+    uint32_t state = m_state.load(std::memory_order_relaxed);
+    for (;;) {
+        if (state == kUnlocked) {
+            if (m_state.compare_exchange_weak(state, kLocked, std::memory_order_acquire,
+                                              std::memory_order_relaxed)) {
+                portEXIT_CRITICAL(&m_waitLock);
+                return true;
+            }
+        } else if (state == kLocked) {
+            m_state.compare_exchange_weak(state, kContended, std::memory_order_relaxed,
+                                          std::memory_order_relaxed);
+        } else {
+            break;
+        }
+    }
+    enqueue(&self);
+    portEXIT_CRITICAL(&m_waitLock);
+
+    for (;;) {
+        TickType_t wait = portMAX_DELAY;
+        if (timeout != portMAX_DELAY) {
+            TickType_t elapsed = xTaskGetTickCount() - start;
+            wait = elapsed >= timeout ? 0 : timeout - elapsed;
+        }
+        uint32_t notified = wait > 0 ? ulTaskNotifyTake(pdFALSE, wait) : 0;
+
+        portENTER_CRITICAL(&m_waitLock);
+        if (self.granted) {
+            portEXIT_CRITICAL(&m_waitLock);
+            if (notified == 0) {
+                // Handed over just as the wait timed out; the wake-up is on
+                // its way and must not be left for the task's next wait
+                ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+            }
+            return true;  // Ownership was transferred by unlock()
+        }
+        if (wait == 0) {
+            remove(&self);
+            if (m_waiters == nullptr) {
+                m_state.store(kLocked, std::memory_order_relaxed);
+            }
+            portEXIT_CRITICAL(&m_waitLock);
+            return false;
+        }
+        portEXIT_CRITICAL(&m_waitLock);
+        // Woken without a hand-over (or the wait returned early): wait again
+    }
+}
+
+void NotifyMutex::unlockSlow() {
+    TaskHandle_t next = nullptr;
+
+    portENTER_CRITICAL(&m_waitLock);
+    Waiter* waiter = m_waiters;
+    if (waiter != nullptr) {
+        // Hand over without unlocking, so no other task can barge in
+        m_waiters = waiter->next;
+        m_state.store(m_waiters != nullptr ? kContended : kLocked, std::memory_order_relaxed);
+        next = waiter->task;
+        waiter->granted = true;  // The waiter's frame may be gone after this
+    } else {
+        // The last waiter timed out
+        m_state.store(kUnlocked, std::memory_order_release);
+    }
+    portEXIT_CRITICAL(&m_waitLock);
+
+    if (next != nullptr) {
+        xTaskNotifyGive(next);
+    }
+}
+
+NotifyMutexGuard::NotifyMutexGuard(NotifyMutex& mutex, TickType_t timeout)
+    : m_mutex(&mutex), m_taken(false) {
+
+    // Check if we're in ISR context
+    if (xPortInIsrContext()) {
+        MUTEXG_LOG_E("Cannot use NotifyMutexGuard from ISR context (mutex '%s')",
+                     MUTEXG_NAME(m_mutex->handle()));
+        m_mutex = nullptr;  // Invalidate to prevent unlock attempt
+        return;
+    }
+
+    m_taken = m_hooks.acquire(m_mutex->handle(), MUTEXGUARD_GUARD_SITE(), false,
+                              [&] { return m_mutex->lock(timeout); });
+
+    MUTEX_GUARD_LOG("Notify mutex '%s' %s", MUTEXG_NAME(m_mutex->handle()),
+                    m_taken ? "locked" : "failed to lock (timeout)");
+}
+
+NotifyMutexGuard::~NotifyMutexGuard() {
+    unlock();
+}
+
+void NotifyMutexGuard::unlock() noexcept {
+    if (m_taken && m_mutex != nullptr) {
+        // Double-check we're not in ISR context
+        if (xPortInIsrContext()) {
+            MUTEXG_LOG_E("Cannot unlock notify mutex '%s' from ISR context",
+                         MUTEXG_NAME(m_mutex->handle()));
+            return;
+        }
+
+        m_hooks.release(m_mutex->handle(), [&] { m_mutex->unlock(); });
+        m_taken = false;
+
+        MUTEX_GUARD_LOG("Notify mutex '%s' unlocked", MUTEXG_NAME(m_mutex->handle()));
+    }
+}
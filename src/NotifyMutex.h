@@ -0,0 +1,181 @@
+#ifndef _NOTIFYMUTEX_H_
+#define _NOTIFYMUTEX_H_
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "GuardHooks.h"
+#include "MutexGuardLogging.h"
+
+/**
+ * @brief Mutex built from an atomic word and direct-to-task notifications
+ *
+ * Every xSemaphoreTake()/xSemaphoreGive() on a FreeRTOS mutex runs the
+ * generic queue code inside a critical section, even when nobody else wants
+ * the mutex. NotifyMutex is a benaphore: lock() is one compare-and-swap on an
+ * atomic state word when the mutex is free, and unlock() is one more when
+ * nobody waits. Only a task that finds the mutex held takes the slow path:
+ * it joins a wait list kept on the waiting tasks' stacks and sleeps in
+ * ulTaskNotifyTake(). unlock() hands the mutex directly to the first waiter
+ * and wakes it with xTaskNotifyGive(). Waiters are served by priority, and in
+ * FIFO order within one priority. The mutex needs no heap and no semaphore,
+ * so it can be a static or a member of any object.
+ *
+ * Trade-offs against a FreeRTOS mutex: there is no priority inheritance, no
+ * owner check and no recursion, and unlock() must be called by the task that
+ * locked it. A blocked waiter uses its task's notification value (index 0),
+ * like a task notification used as a semaphore: the task must not expect
+ * other index-0 notifications while it waits in lock(). Not usable from ISR
+ * context.
+ *
+ * Usage:
+ * @code
+ * static NotifyMutex configLock;
+ * {
+ *     NotifyMutexGuard lock(configLock, pdMS_TO_TICKS(10));
+ *     if (lock) {
+ *         config.update();
+ *     }
+ * }
+ * @endcode
+ */
+class NotifyMutex {
+public:
+    NotifyMutex();
+
+    // Not copyable or movable: waiters hold a pointer to the mutex
+    NotifyMutex(const NotifyMutex&) = delete;
+    NotifyMutex& operator=(const NotifyMutex&) = delete;
+
+    /**
+     * @brief Acquire the mutex
+     *
+     * @param timeout Ticks to wait, with the same meaning as for
+     *                xSemaphoreTake(): 0 tries once, portMAX_DELAY waits forever
+     * @return true if the mutex is now held by the caller
+     */
+    bool lock(TickType_t timeout = portMAX_DELAY) {
+        return tryLock() || lockSlow(timeout);
+    }
+
+    /**
+     * @brief Acquire the mutex only if it is free right now
+     */
+    bool tryLock() {
+        uint32_t expected = kUnlocked;
+        return m_state.compare_exchange_strong(expected, kLocked, std::memory_order_acquire,
+                                               std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Release the mutex, handing it to the first waiter if there is one
+     */
+    void unlock() {
+        uint32_t expected = kLocked;
+        if (!m_state.compare_exchange_strong(expected, kUnlocked, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+            unlockSlow();
+        }
+    }
+
+    /**
+     * @brief Check if some task holds the mutex (a snapshot)
+     */
+    bool isLocked() const noexcept { return m_state.load(std::memory_order_relaxed) != kUnlocked; }
+
+    /**
+     * @brief Handle identifying this mutex in MutexRegistry, statistics and lockdep
+     *
+     * Only an identity: it is not a semaphore and must not be passed to the
+     * xSemaphore* functions.
+     */
+    SemaphoreHandle_t handle() const noexcept {
+        return reinterpret_cast<SemaphoreHandle_t>(const_cast<NotifyMutex*>(this));
+    }
+
+private:
+    enum : uint32_t {
+        kUnlocked = 0,
+        kLocked = 1,
+        kContended = 2  ///< Locked, and the wait list is not empty
+    };
+
+    struct Waiter {
+        TaskHandle_t task;
+        UBaseType_t priority;
+        Waiter* next;
+        bool granted;  ///< Set by unlock() when it hands the mutex over
+    };
+
+    bool lockSlow(TickType_t timeout);
+    void unlockSlow();
+    void enqueue(Waiter* waiter);
+    void remove(Waiter* waiter);
+
+    std::atomic<uint32_t> m_state;
+    portMUX_TYPE m_waitLock;  ///< Guards the wait list and the kContended transitions
+    Waiter* m_waiters;        ///< Highest priority first
+};
+
+/**
+ * @brief RAII guard for NotifyMutex
+ *
+ * Same API and timeout semantics as MutexGuard. Logging, statistics and
+ * lockdep identify the mutex by NotifyMutex::handle().
+ */
+class NotifyMutexGuard {
+public:
+    /**
+     * @brief Construct the guard and attempt to lock the mutex
+     *
+     * @param mutex The mutex to lock
+     * @param timeout Timeout in ticks to wait for the mutex (default: 100ms)
+     */
+    explicit NotifyMutexGuard(NotifyMutex& mutex, TickType_t timeout = pdMS_TO_TICKS(100));
+
+    /**
+     * @brief Destroy the guard and unlock the mutex if it was locked
+     */
+    ~NotifyMutexGuard();
+
+    // Delete copy constructor and assignment operator to prevent double-release
+    NotifyMutexGuard(const NotifyMutexGuard&) = delete;
+    NotifyMutexGuard& operator=(const NotifyMutexGuard&) = delete;
+
+    // Delete move semantics for safety
+    NotifyMutexGuard(NotifyMutexGuard&&) = delete;
+    NotifyMutexGuard& operator=(NotifyMutexGuard&&) = delete;
+
+    /**
+     * @brief Check if the mutex was successfully locked
+     */
+    bool hasLock() const noexcept { return m_taken; }
+
+    /**
+     * @brief Check if the guarded mutex is usable (false after an ISR-context attempt)
+     */
+    bool isValid() const noexcept { return m_mutex != nullptr; }
+
+    /**
+     * @brief Manually unlock the mutex before the guard is destroyed
+     *
+     * Safe to call multiple times.
+     */
+    void unlock() noexcept;
+
+    /**
+     * @brief Convert to bool for convenient if-statement usage
+     */
+    explicit operator bool() const noexcept { return hasLock(); }
+
+private:
+    NotifyMutex* m_mutex;  ///< The mutex, nullptr if unusable
+    bool m_taken;          ///< Whether the mutex was successfully taken
+    GuardHooks m_hooks;    ///< Diagnostic hook state
+};
+
+#endif // _NOTIFYMUTEX_H_
@@ -1,42 +1,30 @@
 #include "RecursiveMutexGuard.h"
 
-RecursiveMutexGuard::RecursiveMutexGuard(SemaphoreHandle_t handle, TickType_t timeout)
-    : m_handle(handle), m_taken(false) {
-    
-    // Check for null handle
-    if (m_handle == nullptr) {
-        RMUTEXG_LOG_W("Attempted to create RecursiveMutexGuard with null handle");
-        return;
-    }
-    
-    // Check if we're in ISR context
-    if (xPortInIsrContext()) {
-        RMUTEXG_LOG_E("Cannot use RecursiveMutexGuard from ISR context");
-        m_handle = nullptr;  // Invalidate to prevent unlock attempt
-        return;
-    }
-    
-    // Attempt to take the recursive mutex
-    m_taken = (xSemaphoreTakeRecursive(m_handle, timeout) == pdTRUE);
-    
-    RECURSIVE_MUTEX_GUARD_LOG("Recursive mutex %s", m_taken ? "locked" : "failed to lock (timeout)");
+#ifndef MUTEXGUARD_HEADER_ONLY
+template class BasicGuard<RecursiveMutexLockPolicy, DefaultGuardChecks, RecursiveMutexGuardLog>;
+#endif
+
+void RecursiveMutexGuardLog::nullHandle() {
+    RMUTEXG_LOG_W("Attempted to create RecursiveMutexGuard with null handle");
 }
 
-RecursiveMutexGuard::~RecursiveMutexGuard() {
-    unlock();
+void RecursiveMutexGuardLog::isrLock(SemaphoreHandle_t handle) {
+    RMUTEXG_LOG_E("Cannot use RecursiveMutexGuard from ISR context (mutex '%s')",
+                  RMUTEXG_NAME(handle));
 }
 
-void RecursiveMutexGuard::unlock() noexcept {
-    if (m_taken && m_handle != nullptr) {
-        // Double-check we're not in ISR context
-        if (xPortInIsrContext()) {
-            RMUTEXG_LOG_E("Cannot unlock recursive mutex from ISR context");
-            return;
-        }
+void RecursiveMutexGuardLog::isrUnlock(SemaphoreHandle_t handle) {
+    RMUTEXG_LOG_E("Cannot unlock recursive mutex '%s' from ISR context", RMUTEXG_NAME(handle));
+}
 
-        xSemaphoreGiveRecursive(m_handle);
-        m_taken = false;
+void RecursiveMutexGuardLog::locked(SemaphoreHandle_t handle, bool taken) {
+    (void)handle;
+    (void)taken;
+    RECURSIVE_MUTEX_GUARD_LOG("Recursive mutex '%s' %s", RMUTEXG_NAME(handle),
+                              taken ? "locked" : "failed to lock (timeout)");
+}
 
-        RECURSIVE_MUTEX_GUARD_LOG("Recursive mutex unlocked");
-    }
-}
\ No newline at end of file
+void RecursiveMutexGuardLog::unlocked(SemaphoreHandle_t handle) {
+    (void)handle;
+    RECURSIVE_MUTEX_GUARD_LOG("Recursive mutex '%s' unlocked", RMUTEXG_NAME(handle));
+}
@@ -3,7 +3,27 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include "BasicGuard.h"
 #include "RecursiveMutexGuardLogging.h"
+#include "MutexGuardStats.h"
+
+/**
+ * @brief Log policy for RecursiveMutexGuard: RMUTEXG_LOG_* and RECURSIVE_MUTEX_GUARD_LOG
+ *
+ * Defined in RecursiveMutexGuard.cpp, so the library's debug flags decide what is logged.
+ */
+struct RecursiveMutexGuardLog {
+#ifdef RECURSIVE_MUTEX_GUARD_DEBUG
+    static const bool verbose = true;
+#else
+    static const bool verbose = false;  ///< Lock/unlock messages compiled out
+#endif
+    MUTEXGUARD_COLD static void nullHandle();
+    MUTEXGUARD_COLD static void isrLock(SemaphoreHandle_t handle);
+    MUTEXGUARD_COLD static void isrUnlock(SemaphoreHandle_t handle);
+    MUTEXGUARD_COLD static void locked(SemaphoreHandle_t handle, bool taken);
+    MUTEXGUARD_COLD static void unlocked(SemaphoreHandle_t handle);
+};
 
 /**
  * @brief RAII recursive mutex guard for automatic recursive mutex management
@@ -35,59 +55,14 @@
  *     }
  * }
  * @endcode
+ *
+ * An instantiation of BasicGuard with all checks enabled, compiled once in
+ * RecursiveMutexGuard.cpp, or inlined at each use when MUTEXGUARD_HEADER_ONLY is defined.
  */
-class RecursiveMutexGuard {
-public:
-    /**
-     * @brief Construct a new Recursive Mutex Guard and attempt to lock the mutex
-     * 
-     * @param handle The FreeRTOS recursive mutex handle to lock
-     * @param timeout Timeout in ticks to wait for the mutex (default: 100ms)
-     */
-    explicit RecursiveMutexGuard(SemaphoreHandle_t handle, TickType_t timeout = pdMS_TO_TICKS(100));
-    
-    /**
-     * @brief Destroy the Recursive Mutex Guard and unlock the mutex if it was locked
-     */
-    ~RecursiveMutexGuard();
-    
-    // Delete copy constructor and assignment operator to prevent double-release
-    RecursiveMutexGuard(const RecursiveMutexGuard&) = delete;
-    RecursiveMutexGuard& operator=(const RecursiveMutexGuard&) = delete;
-    
-    // Delete move semantics for safety
-    RecursiveMutexGuard(RecursiveMutexGuard&&) = delete;
-    RecursiveMutexGuard& operator=(RecursiveMutexGuard&&) = delete;
-    
-    /**
-     * @brief Check if the recursive mutex was successfully locked
-     * @return true if the mutex is currently held by this guard
-     */
-    bool hasLock() const noexcept { return m_taken; }
+typedef BasicGuard<RecursiveMutexLockPolicy, DefaultGuardChecks, RecursiveMutexGuardLog> RecursiveMutexGuard;
 
-    /**
-     * @brief Check if the recursive mutex handle is valid
-     * @return true if the mutex handle is not null
-     */
-    bool isValid() const noexcept { return m_handle != nullptr; }
-
-    /**
-     * @brief Manually unlock the recursive mutex before the guard is destroyed
-     *
-     * This method is safe to call multiple times. After calling unlock(),
-     * hasLock() will return false.
-     */
-    void unlock() noexcept;
-
-    /**
-     * @brief Convert to bool for convenient if-statement usage
-     * @return true if the mutex is locked
-     */
-    explicit operator bool() const noexcept { return hasLock(); }
-
-private:
-    SemaphoreHandle_t m_handle;  ///< The recursive mutex handle
-    bool m_taken;                ///< Whether the mutex was successfully taken
-};
+#ifndef MUTEXGUARD_HEADER_ONLY
+extern template class BasicGuard<RecursiveMutexLockPolicy, DefaultGuardChecks, RecursiveMutexGuardLog>;
+#endif
 
 #endif // _RECURSIVEMUTEXGUARD_H_
\ No newline at end of file
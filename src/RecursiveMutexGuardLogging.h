@@ -4,6 +4,7 @@
 #define RMUTEXG_LOG_TAG "RecursiveMutexGuard"
 
 #include <esp_log.h>  // Required for ESP_LOG_* constants
+#include "MutexRegistry.h"
 
 // Define log levels based on debug flag
 #ifdef RECURSIVEMUTEXGUARD_DEBUG
@@ -22,8 +23,34 @@
     #define RMUTEXG_LOG_LEVEL_V ESP_LOG_NONE  // Suppress
 #endif
 
-// Route to custom logger or ESP-IDF
-#ifdef USE_CUSTOM_LOGGER
+// Route to the binary or deferred backend, custom logger or ESP-IDF
+#if defined(MUTEXGUARD_BINARY_LOG)
+    // Unformatted records, decoded on the host by tools/binary_log.py
+    #include "BinaryLog.h"
+    #define RMUTEXG_LOG_E(...) MUTEXGUARD_BINARY_WRITE(RMUTEXG_LOG_LEVEL_E, RMUTEXG_LOG_TAG, __VA_ARGS__)
+    #define RMUTEXG_LOG_W(...) MUTEXGUARD_BINARY_WRITE(RMUTEXG_LOG_LEVEL_W, RMUTEXG_LOG_TAG, __VA_ARGS__)
+    #define RMUTEXG_LOG_I(...) MUTEXGUARD_BINARY_WRITE(RMUTEXG_LOG_LEVEL_I, RMUTEXG_LOG_TAG, __VA_ARGS__)
+    #ifdef RECURSIVEMUTEXGUARD_DEBUG
+        #define RMUTEXG_LOG_D(...) MUTEXGUARD_BINARY_WRITE(RMUTEXG_LOG_LEVEL_D, RMUTEXG_LOG_TAG, __VA_ARGS__)
+        #define RMUTEXG_LOG_V(...) MUTEXGUARD_BINARY_WRITE(RMUTEXG_LOG_LEVEL_V, RMUTEXG_LOG_TAG, __VA_ARGS__)
+    #else
+        #define RMUTEXG_LOG_D(...) ((void)0)
+        #define RMUTEXG_LOG_V(...) ((void)0)
+    #endif
+#elif defined(MUTEXGUARD_DEFERRED_LOG)
+    // Capture now, format and print later in the DeferredLog task
+    #include "DeferredLog.h"
+    #define RMUTEXG_LOG_E(...) MUTEXGUARD_DEFERRED_WRITE(RMUTEXG_LOG_LEVEL_E, RMUTEXG_LOG_TAG, __VA_ARGS__)
+    #define RMUTEXG_LOG_W(...) MUTEXGUARD_DEFERRED_WRITE(RMUTEXG_LOG_LEVEL_W, RMUTEXG_LOG_TAG, __VA_ARGS__)
+    #define RMUTEXG_LOG_I(...) MUTEXGUARD_DEFERRED_WRITE(RMUTEXG_LOG_LEVEL_I, RMUTEXG_LOG_TAG, __VA_ARGS__)
+    #ifdef RECURSIVEMUTEXGUARD_DEBUG
+        #define RMUTEXG_LOG_D(...) MUTEXGUARD_DEFERRED_WRITE(RMUTEXG_LOG_LEVEL_D, RMUTEXG_LOG_TAG, __VA_ARGS__)
+        #define RMUTEXG_LOG_V(...) MUTEXGUARD_DEFERRED_WRITE(RMUTEXG_LOG_LEVEL_V, RMUTEXG_LOG_TAG, __VA_ARGS__)
+    #else
+        #define RMUTEXG_LOG_D(...) ((void)0)
+        #define RMUTEXG_LOG_V(...) ((void)0)
+    #endif
+#elif defined(USE_CUSTOM_LOGGER)
     #include <LogInterface.h>
     #define RMUTEXG_LOG_E(...) LOG_WRITE(RMUTEXG_LOG_LEVEL_E, RMUTEXG_LOG_TAG, __VA_ARGS__)
     #define RMUTEXG_LOG_W(...) LOG_WRITE(RMUTEXG_LOG_LEVEL_W, RMUTEXG_LOG_TAG, __VA_ARGS__)
@@ -45,6 +72,9 @@
     #endif
 #endif
 
+// Printable mutex identity: the name from MutexRegistry, else the address
+#define RMUTEXG_NAME(handle) MutexRegistry::displayName(handle)
+
 // Keep backward compatibility with old debug macro
 #ifdef RECURSIVE_MUTEX_GUARD_DEBUG
     #define RECURSIVE_MUTEX_GUARD_LOG(...) RMUTEXG_LOG_I(__VA_ARGS__)
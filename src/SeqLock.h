@@ -0,0 +1,180 @@
+#ifndef _SEQLOCK_H_
+#define _SEQLOCK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <type_traits>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifndef MUTEXGUARD_SEQLOCK_SPIN_RETRIES
+#define MUTEXGUARD_SEQLOCK_SPIN_RETRIES 64  ///< Busy retries before a reader sleeps a tick
+#endif
+
+/**
+ * @brief Small value shared by one writer and many readers through a sequence lock
+ *
+ * Readers of small structs (sensor snapshots, controller state) only need a
+ * consistent copy. A seqlock lets them copy without taking any lock: the
+ * writer bumps a sequence counter to an odd value, updates the data and
+ * bumps it back to even; a reader copies the data between two reads of the
+ * counter and retries if the counter was odd or changed. Writers never wait
+ * for readers and readers never block the writer.
+ *
+ * The data is stored as an array of word-sized atomics accessed with relaxed
+ * ordering, framed by acquire/release fences on the sequence counter. That is
+ * the C++ memory model's recipe for seqlocks (no data race on the payload),
+ * and it compiles to plain loads and stores plus the fences each target needs:
+ * `memw` on Xtensa, `fence` on RISC-V and only a compiler barrier on x86.
+ *
+ * Constraints:
+ * - One writer at a time. Serialize writers externally if there are several.
+ * - T must be trivially copyable and default constructible; keep it small,
+ *   since readers copy all of it on every attempt and retry while a write is
+ *   in progress.
+ * - A reader that preempts the writer on the same core cannot make progress
+ *   until the writer runs again. read() therefore sleeps one tick after
+ *   MUTEXGUARD_SEQLOCK_SPIN_RETRIES failed attempts; from an ISR use
+ *   tryRead() instead.
+ *
+ * Usage:
+ * @code
+ * struct ImuSample { float ax, ay, az; uint32_t timestampUs; };
+ * static SeqLocked<ImuSample> latestImu;
+ *
+ * void imuTask(void*) {        // The single writer
+ *     latestImu.write(readImu());
+ * }
+ *
+ * void controlTask(void*) {    // Any number of readers
+ *     ImuSample sample = latestImu.read();
+ * }
+ * @endcode
+ */
+template <typename T>
+class SeqLocked {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLocked<T> requires a trivially copyable T");
+    static_assert(std::is_default_constructible<T>::value,
+                  "SeqLocked<T> requires a default constructible T");
+
+public:
+    /**
+     * @brief Start with a value-initialized T
+     */
+    SeqLocked() : m_sequence(0) { store(T()); }
+
+    /**
+     * @brief Start with the given value
+     */
+    explicit SeqLocked(const T& initial) : m_sequence(0) { store(initial); }
+
+    SeqLocked(const SeqLocked&) = delete;
+    SeqLocked& operator=(const SeqLocked&) = delete;
+
+    /**
+     * @brief Publish a new value (single writer only)
+     *
+     * Wait-free; safe from a task or an ISR.
+     */
+    void write(const T& value) {
+        uint32_t sequence = beginWrite();
+        store(value);
+        endWrite(sequence);
+    }
+
+    /**
+     * @brief Modify the current value in place (single writer only)
+     *
+     * @param fn Called with a T& holding the current value
+     */
+    template <typename Fn>
+    void update(Fn fn) {
+        T value = load();  // Only the writer changes the data, so this copy is stable
+        fn(value);
+        write(value);
+    }
+
+    /**
+     * @brief Copy the value once, without retrying
+     *
+     * @param out Receives the value if the copy was consistent
+     * @return false if a write was in progress or completed during the copy
+     */
+    bool tryRead(T& out) const {
+        uint32_t before = m_sequence.load(std::memory_order_acquire);
+        if (before & 1u) {
+            return false;
+        }
+        T copy = load();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        out = copy;
+        return true;
+    }
+
+    /**
+     * @brief Copy a consistent value, retrying while the writer is active
+     */
+    T read() const {
+        T value;
+        uint32_t attempts = 0;
+        while (!tryRead(value)) {
+            if (++attempts >= MUTEXGUARD_SEQLOCK_SPIN_RETRIES) {
+                // The writer may be preempted on this core; let it finish
+                vTaskDelay(1);
+                attempts = 0;
+            }
+        }
+        return value;
+    }
+
+    /**
+     * @brief Number of completed writes times two (odd while a write is in progress)
+     */
+    uint32_t sequence() const { return m_sequence.load(std::memory_order_acquire); }
+
+private:
+    static const size_t kWords = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    uint32_t beginWrite() {
+        uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+        configASSERT((sequence & 1u) == 0);  // Concurrent writers
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        // Orders the odd sequence before the data stores
+        std::atomic_thread_fence(std::memory_order_release);
+        return sequence;
+    }
+
+    void endWrite(uint32_t sequence) {
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    void store(const T& value) {
+        uint32_t words[kWords] = {};
+        memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < kWords; i++) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    T load() const {
+        uint32_t words[kWords];
+        for (size_t i = 0; i < kWords; i++) {
+            words[i] = m_words[i].load(std::memory_order_relaxed);
+        }
+        T value;
+        memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    std::atomic<uint32_t> m_sequence;       ///< Even when stable, odd during a write
+    std::atomic<uint32_t> m_words[kWords];  ///< The value, one relaxed atomic per word
+};
+
+#endif // _SEQLOCK_H_
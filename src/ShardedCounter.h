@@ -0,0 +1,127 @@
+#ifndef _SHARDEDCOUNTER_H_
+#define _SHARDEDCOUNTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <type_traits>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "MutexGuardConfig.h"
+
+/**
+ * @brief Event counter that tasks update without a mutex
+ *
+ * A counter behind a MutexGuard costs a take and a give on every increment,
+ * and every task that counts queues on the same mutex. ShardedCounter keeps
+ * one slot per shard, each on its own cache line. add() is one relaxed
+ * atomic add on the slot of the calling core. It never blocks and is safe
+ * from an ISR. Tasks on different cores never write the same line. value()
+ * sums all slots.
+ *
+ * A task can be moved to another core between reading its core ID and the
+ * add. The add still counts, because every slot is atomic; it only lands in
+ * the other core's slot. Callers that know their own index (worker i of N)
+ * can pass it to addTo() and keep one slot per task.
+ *
+ * Constraints:
+ * - value() reads the slots one after another. While other tasks count, it
+ *   returns a value between the totals at the start and at the end of the
+ *   call, not one instant's total. Use a MutexGuard if several counters must
+ *   be read consistently together.
+ * - T is an integer no wider than a pointer. Wider atomics are not lock-free
+ *   on 32-bit targets (std::atomic falls back to a lock). Overflow wraps.
+ * - Allocate statically, see MUTEXGUARD_CACHE_LINE_SIZE.
+ *
+ * Usage:
+ * @code
+ * static ShardedCounter<uint32_t> packetsReceived;
+ *
+ * void rxTask(void*) {
+ *     packetsReceived.increment();          // No lock, no waiting
+ * }
+ *
+ * void statsTask(void*) {
+ *     uint32_t perSecond = packetsReceived.reset();  // Take and zero the count
+ * }
+ * @endcode
+ */
+template <typename T = int32_t, size_t Shards = portNUM_PROCESSORS>
+class ShardedCounter {
+    static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+                  "ShardedCounter<T> requires an integer type");
+    static_assert(sizeof(T) <= sizeof(void*), "ShardedCounter<T> is limited to pointer-sized integers");
+    static_assert(Shards > 0, "ShardedCounter needs at least one shard");
+
+public:
+    ShardedCounter() {
+        for (size_t i = 0; i < Shards; i++) {
+            m_slots[i].value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+    /**
+     * @brief Add delta to the slot of the calling core
+     *
+     * Never blocks; safe from a task or an ISR.
+     */
+    void add(T delta = 1) {
+        addTo((size_t)xPortGetCoreID(), delta);
+    }
+
+    void increment() { add(1); }
+
+    void decrement() { add((T)-1); }
+
+    /**
+     * @brief Add delta to a chosen slot, e.g. one per worker task
+     *
+     * @param shard Any index; it is taken modulo Shards
+     */
+    void addTo(size_t shard, T delta) {
+        m_slots[shard % Shards].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sum of all slots
+     */
+    T value() const {
+        Unsigned sum = 0;
+        for (size_t i = 0; i < Shards; i++) {
+            sum += (Unsigned)m_slots[i].value.load(std::memory_order_relaxed);
+        }
+        return (T)sum;
+    }
+
+    /**
+     * @brief Return the sum and set every slot to zero
+     *
+     * Each slot is exchanged atomically, so no add is lost or counted twice
+     * across two reset() calls.
+     */
+    T reset() {
+        Unsigned sum = 0;
+        for (size_t i = 0; i < Shards; i++) {
+            sum += (Unsigned)m_slots[i].value.exchange(0, std::memory_order_relaxed);
+        }
+        return (T)sum;
+    }
+
+    static constexpr size_t shards() { return Shards; }
+
+private:
+    typedef typename std::make_unsigned<T>::type Unsigned;
+
+    struct alignas(MUTEXGUARD_CACHE_LINE_SIZE) Slot {
+        std::atomic<T> value;
+    };
+
+    Slot m_slots[Shards];
+};
+
+#endif // _SHARDEDCOUNTER_H_
@@ -0,0 +1,248 @@
+#include "SharedMutex.h"
+
+#include "freertos/task.h"
+
+namespace {
+
+// Upper bound for wake-up tokens; surplus tokens only cause a spurious re-check
+const UBaseType_t kMaxGateTokens = 0x7fff;
+
+TickType_t remainingTicks(TickType_t start, TickType_t timeout) {
+    if (timeout == portMAX_DELAY) {
+        return portMAX_DELAY;
+    }
+    TickType_t elapsed = xTaskGetTickCount() - start;
+    return elapsed >= timeout ? 0 : timeout - elapsed;
+}
+
+} // namespace
+
+SharedMutex::SharedMutex(Preference preference)
+    : m_readers(0),
+      m_waitingReaders(0),
+      m_waitingWriters(0),
+      m_writer(false),
+      m_preference(preference),
+      m_readGate(xSemaphoreCreateCounting(kMaxGateTokens, 0)),
+      m_writeGate(xSemaphoreCreateCounting(kMaxGateTokens, 0)) {
+    portMUX_INITIALIZE(&m_lock);
+    if (!isValid()) {
+        MUTEXG_LOG_E("Failed to create SharedMutex wake-up semaphores");
+    }
+}
+
+SharedMutex::~SharedMutex() {
+    if (m_readGate != nullptr) {
+        vSemaphoreDelete(m_readGate);
+    }
+    if (m_writeGate != nullptr) {
+        vSemaphoreDelete(m_writeGate);
+    }
+}
+
+void SharedMutex::wake(SemaphoreHandle_t gate, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        xSemaphoreGive(gate);
+    }
+}
+
+bool SharedMutex::lockShared(TickType_t timeout) {
+    if (!isValid()) {
+        return false;
+    }
+
+    TickType_t start = xTaskGetTickCount();
+    bool waiting = false;
+    portENTER_CRITICAL(&m_lock);
+    for (;;) {
+        if (canRead()) {
+            m_readers++;
+            if (waiting) {
+                m_waitingReaders--;
+            }
+            portEXIT_CRITICAL(&m_lock);
+            return true;
+        }
+
+        TickType_t wait = remainingTicks(start, timeout);
+        if (wait == 0) {
+            if (waiting) {
+                m_waitingReaders--;
+            }
+            portEXIT_CRITICAL(&m_lock);
+            return false;
+        }
+
+        // Registered before leaving the critical section, so the next
+        // release counts this task when it hands out wake-up tokens.
+        if (!waiting) {
+            m_waitingReaders++;
+            waiting = true;
+        }
+        portEXIT_CRITICAL(&m_lock);
+        xSemaphoreTake(m_readGate, wait);
+        portENTER_CRITICAL(&m_lock);
+    }
+}
+
+void SharedMutex::unlockShared() {
+    portENTER_CRITICAL(&m_lock);
+    m_readers--;
+    uint32_t writersToWake = (m_readers == 0) ? m_waitingWriters : 0;
+    portEXIT_CRITICAL(&m_lock);
+
+    wake(m_writeGate, writersToWake);
+}
+
+bool SharedMutex::lock(TickType_t timeout) {
+    if (!isValid()) {
+        return false;
+    }
+
+    TickType_t start = xTaskGetTickCount();
+    bool waiting = false;
+    portENTER_CRITICAL(&m_lock);
+    for (;;) {
+        if (canWrite()) {
+            m_writer = true;
+            if (waiting) {
+                m_waitingWriters--;
+            }
+            portEXIT_CRITICAL(&m_lock);
+            return true;
+        }
+
+        TickType_t wait = remainingTicks(start, timeout);
+        if (wait == 0) {
+            uint32_t readersToWake = 0;
+            if (waiting) {
+                m_waitingWriters--;
+                // Under writer preference this task may have been holding
+                // readers back; let them re-check
+                if (m_waitingWriters == 0 && !m_writer) {
+                    readersToWake = m_waitingReaders;
+                }
+            }
+            portEXIT_CRITICAL(&m_lock);
+            wake(m_readGate, readersToWake);
+            return false;
+        }
+
+        if (!waiting) {
+            m_waitingWriters++;
+            waiting = true;
+        }
+        portEXIT_CRITICAL(&m_lock);
+        xSemaphoreTake(m_writeGate, wait);
+        portENTER_CRITICAL(&m_lock);
+    }
+}
+
+void SharedMutex::unlock() {
+    portENTER_CRITICAL(&m_lock);
+    m_writer = false;
+    uint32_t writersToWake = m_waitingWriters;
+    uint32_t readersToWake =
+        (m_preference == Preference::Writers && writersToWake > 0) ? 0 : m_waitingReaders;
+    portEXIT_CRITICAL(&m_lock);
+
+    wake(m_writeGate, writersToWake);
+    wake(m_readGate, readersToWake);
+}
+
+uint32_t SharedMutex::readerCount() const {
+    portENTER_CRITICAL(&m_lock);
+    uint32_t readers = m_readers;
+    portEXIT_CRITICAL(&m_lock);
+    return readers;
+}
+
+SharedGuard::SharedGuard(SharedMutex& mutex, TickType_t timeout)
+    : m_mutex(&mutex), m_taken(false) {
+
+    // Check for a lock whose semaphores could not be created
+    if (!m_mutex->isValid()) {
+        MUTEXG_LOG_W("Attempted to create SharedGuard with invalid lock");
+        m_mutex = nullptr;
+        return;
+    }
+
+    // Check if we're in ISR context
+    if (xPortInIsrContext()) {
+        MUTEXG_LOG_E("Cannot use SharedGuard from ISR context (lock '%s')",
+                     MUTEXG_NAME(m_mutex->handle()));
+        m_mutex = nullptr;  // Invalidate to prevent unlock attempt
+        return;
+    }
+
+    m_taken = m_hooks.acquire(m_mutex->handle(), MUTEXGUARD_GUARD_SITE(), false,
+                              [&] { return m_mutex->lockShared(timeout); });
+
+    MUTEX_GUARD_LOG("Shared lock '%s' %s", MUTEXG_NAME(m_mutex->handle()),
+                    m_taken ? "locked" : "failed to lock (timeout)");
+}
+
+SharedGuard::~SharedGuard() {
+    unlock();
+}
+
+void SharedGuard::unlock() noexcept {
+    if (m_taken && m_mutex != nullptr) {
+        // Double-check we're not in ISR context
+        if (xPortInIsrContext()) {
+            MUTEXG_LOG_E("Cannot unlock shared lock '%s' from ISR context",
+                         MUTEXG_NAME(m_mutex->handle()));
+            return;
+        }
+
+        m_hooks.release(m_mutex->handle(), [&] { m_mutex->unlockShared(); });
+        m_taken = false;
+
+        MUTEX_GUARD_LOG("Shared lock '%s' unlocked", MUTEXG_NAME(m_mutex->handle()));
+    }
+}
+
+ExclusiveGuard::ExclusiveGuard(SharedMutex& mutex, TickType_t timeout)
+    : m_mutex(&mutex), m_taken(false) {
+
+    // Check for a lock whose semaphores could not be created
+    if (!m_mutex->isValid()) {
+        MUTEXG_LOG_W("Attempted to create ExclusiveGuard with invalid lock");
+        m_mutex = nullptr;
+        return;
+    }
+
+    // Check if we're in ISR context
+    if (xPortInIsrContext()) {
+        MUTEXG_LOG_E("Cannot use ExclusiveGuard from ISR context (lock '%s')",
+                     MUTEXG_NAME(m_mutex->handle()));
+        m_mutex = nullptr;  // Invalidate to prevent unlock attempt
+        return;
+    }
+
+    m_taken = m_hooks.acquire(m_mutex->handle(), MUTEXGUARD_GUARD_SITE(), false,
+                              [&] { return m_mutex->lock(timeout); });
+
+    MUTEX_GUARD_LOG("Exclusive lock '%s' %s", MUTEXG_NAME(m_mutex->handle()),
+                    m_taken ? "locked" : "failed to lock (timeout)");
+}
+
+ExclusiveGuard::~ExclusiveGuard() {
+    unlock();
+}
+
+void ExclusiveGuard::unlock() noexcept {
+    if (m_taken && m_mutex != nullptr) {
+        // Double-check we're not in ISR context
+        if (xPortInIsrContext()) {
+            MUTEXG_LOG_E("Cannot unlock exclusive lock '%s' from ISR context",
+                         MUTEXG_NAME(m_mutex->handle()));
+            return;
+        }
+
+        m_hooks.release(m_mutex->handle(), [&] { m_mutex->unlock(); });
+        m_taken = false;
+
+        MUTEX_GUARD_LOG("Exclusive lock '%s' unlocked", MUTEXG_NAME(m_mutex->handle()));
+    }
+}
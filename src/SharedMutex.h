@@ -0,0 +1,243 @@
+#ifndef _SHAREDMUTEX_H_
+#define _SHAREDMUTEX_H_
+
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "GuardHooks.h"
+#include "MutexGuardLogging.h"
+
+/**
+ * @brief Reader-writer lock built on a portMUX spinlock and two semaphores
+ *
+ * Any number of readers may hold the lock at once; a writer holds it alone.
+ * Suited to state that is read far more often than it is written, such as
+ * configuration tables or calibration data, where MutexGuard would
+ * serialize every reader.
+ *
+ * The lock state (active readers, writer flag, waiter counts) lives behind a
+ * short portMUX critical section, so an uncontended acquisition never enters
+ * the scheduler. Tasks that have to wait sleep on a counting semaphore per
+ * side and re-check the state when woken, which keeps FreeRTOS timeout
+ * semantics exact.
+ *
+ * With Preference::Writers (the default) a waiting writer blocks new
+ * readers, so a steady stream of readers cannot starve writers. With
+ * Preference::Readers, readers enter whenever no writer holds the lock,
+ * which gives readers the lowest latency but lets writers starve.
+ *
+ * Not recursive: under writer preference, a task taking the shared lock
+ * twice deadlocks if a writer queues in between. No priority inheritance.
+ *
+ * Usage:
+ * @code
+ * static SharedMutex configLock;
+ *
+ * float readGain() {
+ *     SharedGuard lock(configLock);
+ *     return lock ? config.gain : 0.0f;
+ * }
+ *
+ * void writeGain(float gain) {
+ *     ExclusiveGuard lock(configLock, pdMS_TO_TICKS(50));
+ *     if (lock) {
+ *         config.gain = gain;
+ *     }
+ * }
+ * @endcode
+ */
+class SharedMutex {
+public:
+    /**
+     * @brief Which side wins when readers and writers both wait
+     */
+    enum class Preference : uint8_t {
+        Readers,  ///< Readers enter unless a writer holds the lock
+        Writers   ///< Waiting writers block new readers
+    };
+
+    /**
+     * @brief Create the lock and its wake-up semaphores
+     *
+     * Check isValid() if heap allocation may fail.
+     */
+    explicit SharedMutex(Preference preference = Preference::Writers);
+
+    /**
+     * @brief Delete the semaphores; the lock must not be held
+     */
+    ~SharedMutex();
+
+    SharedMutex(const SharedMutex&) = delete;
+    SharedMutex& operator=(const SharedMutex&) = delete;
+
+    /**
+     * @brief Acquire the lock for reading
+     * @param timeout Ticks to wait; 0 tries once, portMAX_DELAY waits forever
+     * @return true if the shared lock is now held
+     */
+    bool lockShared(TickType_t timeout = portMAX_DELAY);
+
+    /**
+     * @brief Release a shared lock
+     */
+    void unlockShared();
+
+    /**
+     * @brief Acquire the lock for writing
+     * @param timeout Ticks to wait; 0 tries once, portMAX_DELAY waits forever
+     * @return true if the exclusive lock is now held
+     */
+    bool lock(TickType_t timeout = portMAX_DELAY);
+
+    /**
+     * @brief Release the exclusive lock
+     */
+    void unlock();
+
+    /**
+     * @brief Check if the wake-up semaphores were created
+     */
+    bool isValid() const noexcept { return m_readGate != nullptr && m_writeGate != nullptr; }
+
+    /**
+     * @brief Handle identifying this lock in MutexRegistry, statistics and lockdep
+     */
+    SemaphoreHandle_t handle() const noexcept { return m_writeGate; }
+
+    /**
+     * @brief Number of tasks currently holding the shared lock
+     */
+    uint32_t readerCount() const;
+
+private:
+    bool canRead() const {
+        return !m_writer && !(m_preference == Preference::Writers && m_waitingWriters > 0);
+    }
+    bool canWrite() const { return !m_writer && m_readers == 0; }
+    static void wake(SemaphoreHandle_t gate, uint32_t count);
+
+    mutable portMUX_TYPE m_lock;  ///< Guards every field below
+    uint32_t m_readers;           ///< Tasks holding the shared lock
+    uint32_t m_waitingReaders;    ///< Readers in the slow path
+    uint32_t m_waitingWriters;    ///< Writers in the slow path
+    bool m_writer;                ///< A task holds the exclusive lock
+    Preference m_preference;
+    SemaphoreHandle_t m_readGate;   ///< Counting semaphore waiting readers sleep on
+    SemaphoreHandle_t m_writeGate;  ///< Counting semaphore waiting writers sleep on
+};
+
+/**
+ * @brief RAII guard holding a SharedMutex for reading
+ *
+ * Same API and timeout semantics as MutexGuard.
+ */
+class SharedGuard {
+public:
+    /**
+     * @brief Construct the guard and attempt to acquire the shared lock
+     *
+     * @param mutex The lock to acquire
+     * @param timeout Timeout in ticks to wait for the lock (default: 100ms)
+     */
+    explicit SharedGuard(SharedMutex& mutex, TickType_t timeout = pdMS_TO_TICKS(100));
+
+    /**
+     * @brief Destroy the guard and release the lock if it is held
+     */
+    ~SharedGuard();
+
+    // Delete copy constructor and assignment operator to prevent double-release
+    SharedGuard(const SharedGuard&) = delete;
+    SharedGuard& operator=(const SharedGuard&) = delete;
+
+    // Delete move semantics for safety
+    SharedGuard(SharedGuard&&) = delete;
+    SharedGuard& operator=(SharedGuard&&) = delete;
+
+    /**
+     * @brief Check if the shared lock was successfully acquired
+     */
+    bool hasLock() const noexcept { return m_taken; }
+
+    /**
+     * @brief Check if the guarded lock is usable
+     */
+    bool isValid() const noexcept { return m_mutex != nullptr; }
+
+    /**
+     * @brief Release the lock before the guard is destroyed
+     *
+     * Safe to call multiple times.
+     */
+    void unlock() noexcept;
+
+    /**
+     * @brief Convert to bool for convenient if-statement usage
+     */
+    explicit operator bool() const noexcept { return hasLock(); }
+
+private:
+    SharedMutex* m_mutex;  ///< The lock, nullptr if unusable
+    bool m_taken;          ///< Whether the shared lock was acquired
+    GuardHooks m_hooks;    ///< Diagnostic hook state
+};
+
+/**
+ * @brief RAII guard holding a SharedMutex for writing
+ *
+ * Same API and timeout semantics as MutexGuard.
+ */
+class ExclusiveGuard {
+public:
+    /**
+     * @brief Construct the guard and attempt to acquire the exclusive lock
+     *
+     * @param mutex The lock to acquire
+     * @param timeout Timeout in ticks to wait for the lock (default: 100ms)
+     */
+    explicit ExclusiveGuard(SharedMutex& mutex, TickType_t timeout = pdMS_TO_TICKS(100));
+
+    /**
+     * @brief Destroy the guard and release the lock if it is held
+     */
+    ~ExclusiveGuard();
+
+    // Delete copy constructor and assignment operator to prevent double-release
+    ExclusiveGuard(const ExclusiveGuard&) = delete;
+    ExclusiveGuard& operator=(const ExclusiveGuard&) = delete;
+
+    // Delete move semantics for safety
+    ExclusiveGuard(ExclusiveGuard&&) = delete;
+    ExclusiveGuard& operator=(ExclusiveGuard&&) = delete;
+
+    /**
+     * @brief Check if the exclusive lock was successfully acquired
+     */
+    bool hasLock() const noexcept { return m_taken; }
+
+    /**
+     * @brief Check if the guarded lock is usable
+     */
+    bool isValid() const noexcept { return m_mutex != nullptr; }
+
+    /**
+     * @brief Release the lock before the guard is destroyed
+     *
+     * Safe to call multiple times.
+     */
+    void unlock() noexcept;
+
+    /**
+     * @brief Convert to bool for convenient if-statement usage
+     */
+    explicit operator bool() const noexcept { return hasLock(); }
+
+private:
+    SharedMutex* m_mutex;  ///< The lock, nullptr if unusable
+    bool m_taken;          ///< Whether the exclusive lock was acquired
+    GuardHooks m_hooks;    ///< Diagnostic hook state
+};
+
+#endif // _SHAREDMUTEX_H_
@@ -0,0 +1,187 @@
+#ifndef _SPINLOCKGUARD_H_
+#define _SPINLOCKGUARD_H_
+
+#include "freertos/FreeRTOS.h"
+#include "MutexGuardLogging.h"
+
+/**
+ * @brief RAII guard for an ESP-IDF critical-section spinlock (portMUX_TYPE)
+ *
+ * For critical sections of a few dozen instructions, a FreeRTOS mutex costs
+ * far more than the protected work. This guard enters a portMUX critical
+ * section instead: interrupts are masked on the current core and the other
+ * core spins on the lock word until it is released. Nothing is allocated and
+ * no task ever sleeps.
+ *
+ * Keep the protected section short and non-blocking: no FreeRTOS calls that
+ * may block, no logging and no flash access while the guard holds the lock.
+ * For anything longer, use MutexGuard.
+ *
+ * There is no timeout; once constructed with a valid lock from task context
+ * the guard always holds it. Use SpinlockGuardISR for code that may also run
+ * in an interrupt handler.
+ *
+ * Usage:
+ * @code
+ * static portMUX_TYPE counterLock = portMUX_INITIALIZER_UNLOCKED;
+ * {
+ *     SpinlockGuard lock(&counterLock);
+ *     counter++;
+ * }
+ * @endcode
+ */
+class SpinlockGuard {
+public:
+    /**
+     * @brief Enter the critical section guarded by mux
+     *
+     * @param mux Initialized spinlock (portMUX_INITIALIZER_UNLOCKED)
+     */
+    explicit SpinlockGuard(portMUX_TYPE* mux) : m_mux(mux), m_taken(false) {
+        if (m_mux == nullptr) {
+            MUTEXG_LOG_W("Attempted to create SpinlockGuard with null spinlock");
+            return;
+        }
+        if (xPortInIsrContext()) {
+            MUTEXG_LOG_E("Cannot use SpinlockGuard from ISR context, use SpinlockGuardISR");
+            m_mux = nullptr;
+            return;
+        }
+        portENTER_CRITICAL(m_mux);
+        m_taken = true;
+    }
+
+    /**
+     * @brief Leave the critical section if it is still held
+     */
+    ~SpinlockGuard() { unlock(); }
+
+    // Delete copy constructor and assignment operator to prevent double-release
+    SpinlockGuard(const SpinlockGuard&) = delete;
+    SpinlockGuard& operator=(const SpinlockGuard&) = delete;
+
+    // Delete move semantics for safety
+    SpinlockGuard(SpinlockGuard&&) = delete;
+    SpinlockGuard& operator=(SpinlockGuard&&) = delete;
+
+    /**
+     * @brief Check if the spinlock is held by this guard
+     */
+    bool hasLock() const noexcept { return m_taken; }
+
+    /**
+     * @brief Check if the spinlock pointer is valid
+     */
+    bool isValid() const noexcept { return m_mux != nullptr; }
+
+    /**
+     * @brief Leave the critical section before the guard is destroyed
+     *
+     * Safe to call multiple times.
+     */
+    void unlock() noexcept {
+        if (m_taken) {
+            m_taken = false;
+            portEXIT_CRITICAL(m_mux);
+        }
+    }
+
+    /**
+     * @brief Convert to bool for convenient if-statement usage
+     */
+    explicit operator bool() const noexcept { return hasLock(); }
+
+private:
+    portMUX_TYPE* m_mux;  ///< The spinlock
+    bool m_taken;         ///< Whether the critical section was entered
+};
+
+/**
+ * @brief SpinlockGuard variant usable from both ISR and task context
+ *
+ * Picks portENTER_CRITICAL_ISR or portENTER_CRITICAL at runtime, so the same
+ * code path can share state between an interrupt handler and a task. It never
+ * logs, since logging is not allowed from an ISR.
+ *
+ * Usage:
+ * @code
+ * static portMUX_TYPE rxLock = portMUX_INITIALIZER_UNLOCKED;
+ *
+ * void IRAM_ATTR onRx() {
+ *     SpinlockGuardISR lock(&rxLock);
+ *     rxCount++;
+ * }
+ * @endcode
+ */
+class SpinlockGuardISR {
+public:
+    /**
+     * @brief Enter the critical section guarded by mux
+     *
+     * @param mux Initialized spinlock (portMUX_INITIALIZER_UNLOCKED)
+     */
+    explicit SpinlockGuardISR(portMUX_TYPE* mux)
+        : m_mux(mux), m_taken(false), m_fromIsr(false) {
+        if (m_mux == nullptr) {
+            return;
+        }
+        m_fromIsr = (xPortInIsrContext() != pdFALSE);
+        if (m_fromIsr) {
+            portENTER_CRITICAL_ISR(m_mux);
+        } else {
+            portENTER_CRITICAL(m_mux);
+        }
+        m_taken = true;
+    }
+
+    /**
+     * @brief Leave the critical section if it is still held
+     */
+    ~SpinlockGuardISR() { unlock(); }
+
+    // Delete copy constructor and assignment operator to prevent double-release
+    SpinlockGuardISR(const SpinlockGuardISR&) = delete;
+    SpinlockGuardISR& operator=(const SpinlockGuardISR&) = delete;
+
+    // Delete move semantics for safety
+    SpinlockGuardISR(SpinlockGuardISR&&) = delete;
+    SpinlockGuardISR& operator=(SpinlockGuardISR&&) = delete;
+
+    /**
+     * @brief Check if the spinlock is held by this guard
+     */
+    bool hasLock() const noexcept { return m_taken; }
+
+    /**
+     * @brief Check if the spinlock pointer is valid
+     */
+    bool isValid() const noexcept { return m_mux != nullptr; }
+
+    /**
+     * @brief Leave the critical section before the guard is destroyed
+     *
+     * Safe to call multiple times.
+     */
+    void unlock() noexcept {
+        if (m_taken) {
+            m_taken = false;
+            if (m_fromIsr) {
+                portEXIT_CRITICAL_ISR(m_mux);
+            } else {
+                portEXIT_CRITICAL(m_mux);
+            }
+        }
+    }
+
+    /**
+     * @brief Convert to bool for convenient if-statement usage
+     */
+    explicit operator bool() const noexcept { return hasLock(); }
+
+private:
+    portMUX_TYPE* m_mux;  ///< The spinlock
+    bool m_taken;         ///< Whether the critical section was entered
+    bool m_fromIsr;       ///< Entered with the _ISR variants
+};
+
+#endif // _SPINLOCKGUARD_H_
@@ -0,0 +1,24 @@
+#include "StaticMutex.h"
+
+#include "freertos/task.h"
+
+SemaphoreHandle_t StaticMutexBase::create() noexcept {
+    uint8_t expected = kUninitialized;
+    if (m_state.compare_exchange_strong(expected, kCreating, std::memory_order_acquire,
+                                        std::memory_order_acquire)) {
+        // Static creation cannot fail for a valid buffer
+        m_handle = m_recursive ? xSemaphoreCreateRecursiveMutexStatic(&m_storage)
+                               : xSemaphoreCreateMutexStatic(&m_storage);
+        configASSERT(m_handle != nullptr);
+        m_state.store(kReady, std::memory_order_release);
+        return m_handle;
+    }
+
+    // Another task is creating it. Creation is short and never blocks, but
+    // the creator may have a lower priority than this task, and a yield only
+    // runs tasks of equal priority: sleep so that it can finish.
+    while (m_state.load(std::memory_order_acquire) != kReady) {
+        vTaskDelay(1);
+    }
+    return m_handle;
+}
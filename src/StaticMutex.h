@@ -0,0 +1,125 @@
+#ifndef _STATICMUTEX_H_
+#define _STATICMUTEX_H_
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "BasicGuard.h"
+#include "MutexGuard.h"
+#include "RecursiveMutexGuard.h"
+
+/**
+ * @brief Common part of StaticMutex and StaticRecursiveMutex
+ *
+ * Holds the StaticSemaphore_t the kernel object lives in. The constructor is
+ * constexpr, so a namespace-scope instance is constant-initialized before any
+ * code runs and can be locked from other static constructors regardless of
+ * initialization order. The kernel object is created on first use; a
+ * compare-and-swap on a state byte makes sure exactly one task creates it,
+ * and a task that loses the race sleeps a tick at a time until it is ready.
+ * The first use must therefore be from a task or from static initialization,
+ * not from an ISR.
+ *
+ * The destructor is trivial, so a static instance also stays usable during
+ * static destruction. Instances with automatic or dynamic storage are not
+ * deleted from the kernel when they go away.
+ */
+class StaticMutexBase {
+public:
+    StaticMutexBase(const StaticMutexBase&) = delete;
+    StaticMutexBase& operator=(const StaticMutexBase&) = delete;
+
+    /**
+     * @brief The mutex handle, created on the first call; never nullptr
+     *
+     * Usable with MutexRegistry, statistics and the raw FreeRTOS API. Once
+     * created, this is one load and a predicted branch.
+     */
+    SemaphoreHandle_t handle() noexcept {
+        if (MUTEXGUARD_EXPECT_FALSE(m_state.load(std::memory_order_acquire) != kReady)) MUTEXGUARD_UNLIKELY {
+            return create();
+        }
+        return m_handle;
+    }
+
+protected:
+    constexpr explicit StaticMutexBase(bool recursive) noexcept
+        : m_storage(), m_handle(nullptr), m_state(kUninitialized), m_recursive(recursive) {}
+
+private:
+    enum : uint8_t { kUninitialized, kCreating, kReady };
+
+    MUTEXGUARD_COLD SemaphoreHandle_t create() noexcept;
+
+    StaticSemaphore_t m_storage;     ///< Memory of the kernel object
+    SemaphoreHandle_t m_handle;      ///< Valid once m_state is kReady
+    std::atomic<uint8_t> m_state;    ///< Creation state
+    bool m_recursive;                ///< Create a recursive mutex
+};
+
+/**
+ * @brief Mutex in caller-provided memory, without heap allocation
+ *
+ * Usage:
+ * @code
+ * static StaticMutex busMutex;  // No xSemaphoreCreateMutex(), no null handle
+ *
+ * void writeRegister(uint8_t reg, uint8_t value) {
+ *     StaticMutexGuard lock(busMutex);
+ *     if (lock) {
+ *         i2cWrite(reg, value);
+ *     }
+ * }
+ * @endcode
+ */
+class StaticMutex : public StaticMutexBase {
+public:
+    constexpr StaticMutex() noexcept : StaticMutexBase(false) {}
+};
+
+/**
+ * @brief Recursive mutex in caller-provided memory, without heap allocation
+ */
+class StaticRecursiveMutex : public StaticMutexBase {
+public:
+    constexpr StaticRecursiveMutex() noexcept : StaticMutexBase(true) {}
+};
+
+/**
+ * @brief MutexGuard for a StaticMutex, without the null-handle check
+ *
+ * Same API and timeout semantics as MutexGuard. The handle cannot be null,
+ * so only the ISR check remains.
+ */
+class StaticMutexGuard : public BasicGuard<MutexLockPolicy, IsrOnlyGuardChecks, MutexGuardLog> {
+public:
+    /**
+     * @brief Construct the guard and attempt to lock the mutex
+     *
+     * @param mutex The mutex to lock
+     * @param timeout Timeout in ticks to wait for the mutex (default: 100ms)
+     */
+    explicit StaticMutexGuard(StaticMutex& mutex, TickType_t timeout = pdMS_TO_TICKS(100))
+        : BasicGuard(mutex.handle(), timeout) {}
+};
+
+/**
+ * @brief RecursiveMutexGuard for a StaticRecursiveMutex, without the null-handle check
+ */
+class StaticRecursiveMutexGuard
+    : public BasicGuard<RecursiveMutexLockPolicy, IsrOnlyGuardChecks, RecursiveMutexGuardLog> {
+public:
+    /**
+     * @brief Construct the guard and attempt to lock the recursive mutex
+     *
+     * @param mutex The recursive mutex to lock
+     * @param timeout Timeout in ticks to wait for the mutex (default: 100ms)
+     */
+    explicit StaticRecursiveMutexGuard(StaticRecursiveMutex& mutex, TickType_t timeout = pdMS_TO_TICKS(100))
+        : BasicGuard(mutex.handle(), timeout) {}
+};
+
+#endif // _STATICMUTEX_H_
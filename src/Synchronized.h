@@ -0,0 +1,222 @@
+#ifndef _SYNCHRONIZED_H_
+#define _SYNCHRONIZED_H_
+
+#include <stddef.h>
+
+#include <type_traits>
+#include <utility>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "StaticMutex.h"
+#include "UniqueMutexGuard.h"
+
+/**
+ * @brief A value that can only be reached while its own mutex is held
+ *
+ * Keeping a mutex and the data it protects as separate fields makes it easy
+ * to touch the data without the lock. Synchronized<T> owns both: the value
+ * lives next to a StaticMutex and is only handed out through lock(), which
+ * returns a handle holding the mutex, or withLock(), which runs a function
+ * with the mutex held.
+ *
+ * Every call locks once. To do several operations under one acquisition,
+ * keep the handle from lock() or do all of them in one withLock() or
+ * forEach() call instead of calling a locking helper per operation.
+ *
+ * Usage:
+ * @code
+ * struct Stats { uint32_t samples; float sum; };
+ * static Synchronized<Stats> stats;
+ *
+ * void addSample(float value) {
+ *     stats.withLock([&](Stats& s) {
+ *         s.samples++;
+ *         s.sum += value;
+ *     });
+ * }
+ *
+ * float mean() {
+ *     auto locked = stats.lock();
+ *     return (locked && locked->samples) ? locked->sum / locked->samples : 0.0f;
+ * }
+ * @endcode
+ */
+template <typename T>
+class Synchronized {
+public:
+    /**
+     * @brief Handle that holds the mutex and gives access to the value
+     *
+     * Movable, so it can be returned from accessors. Check it before use:
+     * dereferencing a handle that failed to lock is an assertion failure.
+     * The mutex is released when the handle is destroyed or unlock() is called.
+     */
+    template <typename U>
+    class BasicLocked {
+    public:
+        BasicLocked(U& value, SemaphoreHandle_t handle, TickType_t timeout)
+            : m_value(&value), m_guard(handle, timeout) {}
+
+        BasicLocked(BasicLocked&& other) noexcept
+            : m_value(other.m_value), m_guard(std::move(other.m_guard)) {}
+        BasicLocked& operator=(BasicLocked&& other) noexcept {
+            m_value = other.m_value;
+            m_guard = std::move(other.m_guard);
+            return *this;
+        }
+
+        BasicLocked(const BasicLocked&) = delete;
+        BasicLocked& operator=(const BasicLocked&) = delete;
+
+        /**
+         * @brief Check if the mutex is held and the value may be accessed
+         */
+        bool hasLock() const noexcept { return m_guard.hasLock(); }
+
+        /**
+         * @brief Convert to bool for convenient if-statement usage
+         */
+        explicit operator bool() const noexcept { return hasLock(); }
+
+        /**
+         * @brief Release the mutex early; the value is no longer accessible
+         */
+        void unlock() noexcept { m_guard.unlock(); }
+
+        U& operator*() const {
+            configASSERT(hasLock());
+            return *m_value;
+        }
+
+        U* operator->() const {
+            configASSERT(hasLock());
+            return m_value;
+        }
+
+    private:
+        U* m_value;
+        UniqueMutexGuard m_guard;
+    };
+
+    typedef BasicLocked<T> Locked;
+    typedef BasicLocked<const T> ConstLocked;
+
+    /**
+     * @brief Value-initialize the value, so `static Synchronized<T> s = {};` works
+     *
+     * Both constructors are constexpr: for a literal T, a namespace-scope
+     * instance is constant-initialized like its StaticMutex and may be used
+     * from other static constructors regardless of initialization order.
+     */
+    constexpr Synchronized() : m_value() {}
+
+    /**
+     * @brief Construct the value from the given arguments
+     *
+     * Disabled for a single Synchronized argument, so copying reports the
+     * deleted copy constructor instead of failing to build a T from it.
+     */
+    template <typename Arg, typename... Args,
+              typename = typename std::enable_if<
+                  !std::is_same<typename std::decay<Arg>::type, Synchronized>::value>::type>
+    constexpr explicit Synchronized(Arg&& arg, Args&&... args)
+        : m_value(static_cast<Arg&&>(arg), static_cast<Args&&>(args)...) {}  // std::forward is constexpr from C++14
+
+    Synchronized(const Synchronized&) = delete;
+    Synchronized& operator=(const Synchronized&) = delete;
+
+    /**
+     * @brief Lock the mutex and return a handle to the value
+     *
+     * @param timeout Timeout in ticks to wait for the mutex (default: 100ms)
+     */
+    Locked lock(TickType_t timeout = pdMS_TO_TICKS(100)) {
+        return Locked(m_value, m_mutex.handle(), timeout);
+    }
+
+    /**
+     * @brief Lock the mutex and return a read-only handle to the value
+     */
+    ConstLocked lock(TickType_t timeout = pdMS_TO_TICKS(100)) const {
+        return ConstLocked(m_value, m_mutex.handle(), timeout);
+    }
+
+    /**
+     * @brief Run fn(T&) with the mutex held
+     *
+     * @return true if the mutex was acquired and fn ran
+     */
+    template <typename Fn>
+    bool withLock(Fn fn, TickType_t timeout = pdMS_TO_TICKS(100)) {
+        StaticMutexGuard guard(m_mutex, timeout);
+        if (!guard) {
+            return false;
+        }
+        fn(m_value);
+        return true;
+    }
+
+    /**
+     * @brief Run fn(const T&) with the mutex held
+     */
+    template <typename Fn>
+    bool withLock(Fn fn, TickType_t timeout = pdMS_TO_TICKS(100)) const {
+        StaticMutexGuard guard(m_mutex, timeout);
+        if (!guard) {
+            return false;
+        }
+        fn(static_cast<const T&>(m_value));
+        return true;
+    }
+
+    /**
+     * @brief Apply fn(T&, item) to every item of a range under one acquisition
+     *
+     * For example pushing a batch of samples into a synchronized buffer.
+     *
+     * @return Number of items applied: the range length, or 0 on timeout
+     */
+    template <typename InputIt, typename Fn>
+    size_t forEach(InputIt first, InputIt last, Fn fn, TickType_t timeout = pdMS_TO_TICKS(100)) {
+        StaticMutexGuard guard(m_mutex, timeout);
+        if (!guard) {
+            return 0;
+        }
+        size_t applied = 0;
+        for (; first != last; ++first, ++applied) {
+            fn(m_value, *first);
+        }
+        return applied;
+    }
+
+    /**
+     * @brief Copy the value out under the lock
+     *
+     * @param out Receives the value if the mutex was acquired
+     * @return true on success
+     */
+    bool get(T& out, TickType_t timeout = pdMS_TO_TICKS(100)) const {
+        return withLock([&out](const T& value) { out = value; }, timeout);
+    }
+
+    /**
+     * @brief Replace the value under the lock
+     *
+     * @return true on success
+     */
+    bool set(const T& value, TickType_t timeout = pdMS_TO_TICKS(100)) {
+        return withLock([&value](T& current) { current = value; }, timeout);
+    }
+
+    /**
+     * @brief Handle of the owned mutex, e.g. to name it in MutexRegistry
+     */
+    SemaphoreHandle_t handle() const noexcept { return m_mutex.handle(); }
+
+private:
+    mutable StaticMutex m_mutex;  ///< Locked for every access, also from const members
+    T m_value;                    ///< Only reachable with m_mutex held
+};
+
+#endif // _SYNCHRONIZED_H_
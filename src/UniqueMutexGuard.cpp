@@ -0,0 +1,111 @@
+#include "UniqueMutexGuard.h"
+
+#include <utility>
+
+UniqueMutexGuard::UniqueMutexGuard() noexcept
+    : m_handle(nullptr), m_taken(false) {}
+
+UniqueMutexGuard::UniqueMutexGuard(SemaphoreHandle_t handle, TickType_t timeout)
+    : m_handle(handle), m_taken(false) {
+    acquire(timeout, MUTEXGUARD_GUARD_SITE());
+}
+
+UniqueMutexGuard::UniqueMutexGuard(SemaphoreHandle_t handle, DeferLock) noexcept
+    : m_handle(handle), m_taken(false) {}
+
+UniqueMutexGuard::UniqueMutexGuard(SemaphoreHandle_t handle, TryToLock)
+    : m_handle(handle), m_taken(false) {
+    acquire(0, MUTEXGUARD_GUARD_SITE());
+}
+
+UniqueMutexGuard::UniqueMutexGuard(SemaphoreHandle_t handle, AdoptLock) noexcept
+    : m_handle(handle), m_taken(handle != nullptr) {
+    if (m_taken) {
+        m_hooks.adopted(m_handle, MUTEXGUARD_GUARD_SITE());
+    }
+    MUTEX_GUARD_LOG("Mutex '%s' adopted", MUTEXG_NAME(m_handle));
+}
+
+UniqueMutexGuard::~UniqueMutexGuard() {
+    unlock();
+}
+
+UniqueMutexGuard::UniqueMutexGuard(UniqueMutexGuard&& other) noexcept
+    : m_handle(other.m_handle), m_taken(other.m_taken), m_hooks(other.m_hooks) {
+    other.m_handle = nullptr;
+    other.m_taken = false;
+}
+
+UniqueMutexGuard& UniqueMutexGuard::operator=(UniqueMutexGuard&& other) noexcept {
+    if (this != &other) {
+        unlock();
+        m_handle = other.m_handle;
+        m_taken = other.m_taken;
+        m_hooks = other.m_hooks;
+        other.m_handle = nullptr;
+        other.m_taken = false;
+    }
+    return *this;
+}
+
+bool UniqueMutexGuard::lock(TickType_t timeout) {
+    return acquire(timeout, MUTEXGUARD_GUARD_SITE());
+}
+
+bool UniqueMutexGuard::acquire(TickType_t timeout, const void* callSite) {
+    // Check for null handle
+    if (m_handle == nullptr) {
+        MUTEXG_LOG_W("Attempted to lock UniqueMutexGuard with null handle");
+        return false;
+    }
+
+    // Taking a non-recursive mutex twice would deadlock
+    if (m_taken) {
+        MUTEXG_LOG_W("UniqueMutexGuard already holds mutex '%s'", MUTEXG_NAME(m_handle));
+        return true;
+    }
+
+    // Check if we're in ISR context
+    if (xPortInIsrContext()) {
+        MUTEXG_LOG_E("Cannot use UniqueMutexGuard from ISR context (mutex '%s')", MUTEXG_NAME(m_handle));
+        return false;
+    }
+
+    m_taken = m_hooks.acquire(m_handle, callSite, false,
+                              [&] { return xSemaphoreTake(m_handle, timeout) == pdTRUE; });
+
+    MUTEX_GUARD_LOG("Mutex '%s' %s", MUTEXG_NAME(m_handle),
+                    m_taken ? "locked" : "failed to lock (timeout)");
+    return m_taken;
+}
+
+void UniqueMutexGuard::unlock() noexcept {
+    if (m_taken && m_handle != nullptr) {
+        // Double-check we're not in ISR context
+        if (xPortInIsrContext()) {
+            MUTEXG_LOG_E("Cannot unlock mutex '%s' from ISR context", MUTEXG_NAME(m_handle));
+            return;
+        }
+
+        m_hooks.release(m_handle, [&] { xSemaphoreGive(m_handle); });
+        m_taken = false;
+
+        MUTEX_GUARD_LOG("Mutex '%s' unlocked", MUTEXG_NAME(m_handle));
+    }
+}
+
+SemaphoreHandle_t UniqueMutexGuard::release() noexcept {
+    SemaphoreHandle_t handle = m_handle;
+    if (m_taken) {
+        m_hooks.detached(handle);
+    }
+    m_handle = nullptr;
+    m_taken = false;
+    return handle;
+}
+
+void UniqueMutexGuard::swap(UniqueMutexGuard& other) noexcept {
+    std::swap(m_handle, other.m_handle);
+    std::swap(m_taken, other.m_taken);
+    std::swap(m_hooks, other.m_hooks);
+}
@@ -0,0 +1,178 @@
+#ifndef _UNIQUEMUTEXGUARD_H_
+#define _UNIQUEMUTEXGUARD_H_
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "GuardHooks.h"
+#include "MutexGuardLogging.h"
+
+/**
+ * @brief Tag: construct a UniqueMutexGuard without locking
+ */
+struct DeferLock {};
+
+/**
+ * @brief Tag: construct a UniqueMutexGuard with a single non-blocking attempt
+ */
+struct TryToLock {};
+
+/**
+ * @brief Tag: construct a UniqueMutexGuard for a mutex the caller already holds
+ */
+struct AdoptLock {};
+
+constexpr DeferLock deferLock{};
+constexpr TryToLock tryToLock{};
+constexpr AdoptLock adoptLock{};
+
+/**
+ * @brief Movable mutex guard with deferred, try and adopted locking
+ *
+ * MutexGuard pins the lock to one scope. UniqueMutexGuard has the same
+ * layout but can be moved out of a function, so an accessor can return the
+ * held lock together with the data instead of the caller locking again.
+ * It can also be created unlocked and locked later, relocked after
+ * unlock(), and detached from the mutex with release().
+ *
+ * The mutex is still owned by the task that locked it: moving the guard to
+ * another task and unlocking there is not allowed by FreeRTOS.
+ *
+ * Usage:
+ * @code
+ * UniqueMutexGuard lockConfig() {
+ *     return UniqueMutexGuard(configMutex, pdMS_TO_TICKS(50));
+ * }
+ *
+ * {
+ *     UniqueMutexGuard lock = lockConfig();
+ *     if (lock) {
+ *         config.gain = 2.0f;
+ *     }
+ * }
+ *
+ * UniqueMutexGuard later(configMutex, deferLock);
+ * if (later.tryLock()) {
+ *     // ...
+ * }
+ * @endcode
+ */
+class UniqueMutexGuard {
+public:
+    /**
+     * @brief Construct a guard that is not associated with any mutex
+     */
+    UniqueMutexGuard() noexcept;
+
+    /**
+     * @brief Construct the guard and attempt to lock the mutex
+     *
+     * @param handle The FreeRTOS mutex handle to lock
+     * @param timeout Timeout in ticks to wait for the mutex (default: 100ms)
+     */
+    explicit UniqueMutexGuard(SemaphoreHandle_t handle, TickType_t timeout = pdMS_TO_TICKS(100));
+
+    /**
+     * @brief Associate the guard with the mutex without locking it
+     */
+    UniqueMutexGuard(SemaphoreHandle_t handle, DeferLock) noexcept;
+
+    /**
+     * @brief Try to lock the mutex once, without blocking
+     */
+    UniqueMutexGuard(SemaphoreHandle_t handle, TryToLock);
+
+    /**
+     * @brief Take over a mutex the calling task already holds
+     *
+     * Typically the handle returned by release(). Lockdep tracks the mutex
+     * as held again; hold-time statistics and the hold budget restart at
+     * adoption.
+     */
+    UniqueMutexGuard(SemaphoreHandle_t handle, AdoptLock) noexcept;
+
+    /**
+     * @brief Destroy the guard and unlock the mutex if it is held
+     */
+    ~UniqueMutexGuard();
+
+    // Copying would release the mutex twice
+    UniqueMutexGuard(const UniqueMutexGuard&) = delete;
+    UniqueMutexGuard& operator=(const UniqueMutexGuard&) = delete;
+
+    /**
+     * @brief Take over the other guard's mutex and lock state
+     *
+     * The other guard is left empty.
+     */
+    UniqueMutexGuard(UniqueMutexGuard&& other) noexcept;
+
+    /**
+     * @brief Unlock the current mutex if held, then take over the other guard's
+     */
+    UniqueMutexGuard& operator=(UniqueMutexGuard&& other) noexcept;
+
+    /**
+     * @brief Lock the associated mutex
+     *
+     * @param timeout Timeout in ticks to wait for the mutex (default: 100ms)
+     * @return true if the mutex is now held, including when it already was
+     */
+    bool lock(TickType_t timeout = pdMS_TO_TICKS(100));
+
+    /**
+     * @brief Lock the associated mutex only if it is free right now
+     */
+    bool tryLock() { return lock(0); }
+
+    /**
+     * @brief Unlock the mutex, keeping the association so it can be relocked
+     *
+     * Safe to call multiple times.
+     */
+    void unlock() noexcept;
+
+    /**
+     * @brief Detach from the mutex without unlocking it
+     *
+     * The caller becomes responsible for the lock, e.g. by adopting it into
+     * another guard or calling xSemaphoreGive(). Lockdep stops counting it
+     * as held, so a raw give leaves the task's held locks balanced.
+     *
+     * @return The mutex handle, or nullptr if the guard had none
+     */
+    SemaphoreHandle_t release() noexcept;
+
+    /**
+     * @brief Exchange mutexes and lock state with another guard
+     */
+    void swap(UniqueMutexGuard& other) noexcept;
+
+    /**
+     * @brief The associated mutex handle, nullptr if none
+     */
+    SemaphoreHandle_t mutex() const noexcept { return m_handle; }
+
+    /**
+     * @brief Check if the mutex is currently held by this guard
+     */
+    bool hasLock() const noexcept { return m_taken; }
+
+    /**
+     * @brief Check if the guard is associated with a mutex
+     */
+    bool isValid() const noexcept { return m_handle != nullptr; }
+
+    /**
+     * @brief Convert to bool for convenient if-statement usage
+     */
+    explicit operator bool() const noexcept { return hasLock(); }
+
+private:
+    bool acquire(TickType_t timeout, const void* callSite);
+
+    SemaphoreHandle_t m_handle;  ///< The mutex handle, nullptr if none
+    bool m_taken;                ///< Whether the mutex is held by this guard
+    GuardHooks m_hooks;          ///< Diagnostic hook state
+};
+
+#endif // _UNIQUEMUTEXGUARD_H_
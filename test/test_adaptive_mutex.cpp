@@ -0,0 +1,145 @@
+/**
+ * @file test_adaptive_mutex.cpp
+ * @brief Unit tests for AdaptiveMutex and AdaptiveMutexGuard
+ */
+
+#ifdef UNIT_TEST
+
+#include <Arduino.h>
+#include <unity.h>
+#include <AdaptiveMutex.h>
+
+#define ADAPTIVE_TEST_TASKS 4
+#define ADAPTIVE_TEST_ITERATIONS 5000
+
+static AdaptiveMutex* testMutex = nullptr;
+
+void setUp() {
+    testMutex = new AdaptiveMutex();
+}
+
+void tearDown() {
+    delete testMutex;
+    testMutex = nullptr;
+}
+
+void test_adaptive_guard_acquires_lock() {
+    TEST_ASSERT_TRUE(testMutex->isValid());
+    {
+        AdaptiveMutexGuard guard(*testMutex);
+        TEST_ASSERT_TRUE(guard.hasLock());
+        TEST_ASSERT_TRUE(guard.isValid());
+        TEST_ASSERT_FALSE(testMutex->tryLock());
+    }
+    // Released on destruction
+    TEST_ASSERT_TRUE(testMutex->tryLock());
+    testMutex->unlock();
+}
+
+void test_adaptive_guard_unlock() {
+    AdaptiveMutexGuard guard(*testMutex);
+    guard.unlock();
+    TEST_ASSERT_FALSE(guard.hasLock());
+    guard.unlock();  // Second unlock is a no-op
+    TEST_ASSERT_TRUE(testMutex->tryLock());
+    testMutex->unlock();
+}
+
+void test_adaptive_guard_timeout() {
+    TEST_ASSERT_TRUE(testMutex->lock());
+
+    // Zero timeout fails immediately, a short one after spinning and blocking
+    AdaptiveMutexGuard immediate(*testMutex, 0);
+    TEST_ASSERT_FALSE(immediate.hasLock());
+
+    uint32_t start = millis();
+    AdaptiveMutexGuard timed(*testMutex, pdMS_TO_TICKS(20));
+    TEST_ASSERT_FALSE(timed.hasLock());
+    TEST_ASSERT_GREATER_OR_EQUAL(15, millis() - start);
+
+    testMutex->unlock();
+    AdaptiveMutexGuard after(*testMutex, 0);
+    TEST_ASSERT_TRUE(after.hasLock());
+}
+
+static SemaphoreHandle_t waiterDone = nullptr;
+static volatile bool waiterGotLock = false;
+
+static void blockingWaiterTask(void* param) {
+    (void)param;
+    AdaptiveMutexGuard guard(*testMutex, portMAX_DELAY);
+    waiterGotLock = guard.hasLock();
+    guard.unlock();
+    xSemaphoreGive(waiterDone);
+    vTaskDelete(NULL);
+}
+
+void test_adaptive_unlock_wakes_blocked_waiter() {
+    waiterGotLock = false;
+    waiterDone = xSemaphoreCreateBinary();
+    TEST_ASSERT_TRUE(testMutex->lock());
+
+    xTaskCreate(blockingWaiterTask, "Waiter", 2048, NULL, 1, NULL);
+    delay(50);  // Long past the spin budget: the waiter is asleep
+    TEST_ASSERT_FALSE(waiterGotLock);
+
+    testMutex->unlock();
+    TEST_ASSERT_TRUE(xSemaphoreTake(waiterDone, pdMS_TO_TICKS(1000)) == pdTRUE);
+    TEST_ASSERT_TRUE(waiterGotLock);
+    vSemaphoreDelete(waiterDone);
+}
+
+static volatile uint32_t adaptiveCounter = 0;
+static SemaphoreHandle_t incrementDone = nullptr;
+
+static void adaptiveIncrementTask(void* param) {
+    (void)param;
+    for (int i = 0; i < ADAPTIVE_TEST_ITERATIONS; i++) {
+        AdaptiveMutexGuard guard(*testMutex, portMAX_DELAY);
+        if (guard) {
+            adaptiveCounter = adaptiveCounter + 1;
+        }
+    }
+    xSemaphoreGive(incrementDone);
+    vTaskDelete(NULL);
+}
+
+void test_adaptive_mutual_exclusion() {
+    adaptiveCounter = 0;
+    incrementDone = xSemaphoreCreateCounting(ADAPTIVE_TEST_TASKS, 0);
+
+    for (int i = 0; i < ADAPTIVE_TEST_TASKS; i++) {
+        xTaskCreatePinnedToCore(adaptiveIncrementTask, "Adapt", 2048, NULL, 1, NULL,
+                                i % portNUM_PROCESSORS);
+    }
+    for (int i = 0; i < ADAPTIVE_TEST_TASKS; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(incrementDone, pdMS_TO_TICKS(10000)) == pdTRUE);
+    }
+
+    TEST_ASSERT_EQUAL(ADAPTIVE_TEST_TASKS * ADAPTIVE_TEST_ITERATIONS, adaptiveCounter);
+    TEST_ASSERT_LESS_OR_EQUAL(MUTEXGUARD_ADAPTIVE_MAX_SPIN, testMutex->spinEstimate());
+    vSemaphoreDelete(incrementDone);
+}
+
+void runAdaptiveMutexTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_adaptive_guard_acquires_lock);
+    RUN_TEST(test_adaptive_guard_unlock);
+    RUN_TEST(test_adaptive_guard_timeout);
+    RUN_TEST(test_adaptive_unlock_wakes_blocked_waiter);
+    RUN_TEST(test_adaptive_mutual_exclusion);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== AdaptiveMutex Tests ===\n");
+    runAdaptiveMutexTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST
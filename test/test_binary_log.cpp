@@ -0,0 +1,252 @@
+/**
+ * @file test_binary_log.cpp
+ * @brief Unit tests for the MUTEXGUARD_BINARY_LOG record encoding
+ */
+
+#if defined(UNIT_TEST) && defined(MUTEXGUARD_BINARY_LOG)
+
+#include <string.h>
+
+#include <Arduino.h>
+#include <unity.h>
+#include <BinaryLog.h>
+#include <MutexGuard.h>
+#include <MutexGuardLogging.h>
+#include <MutexRegistry.h>
+#include <RecursiveMutexGuard.h>
+
+// Checked against tools/binary_log.py, which must compute the same IDs
+static_assert(BinaryLog::messageId(ESP_LOG_INFO, "MutexGuard", "Mutex '%s' unlocked") == 464378,
+              "message ID differs from tools/binary_log.py");
+static_assert(BinaryLog::argClasses("%s=%5.2f %% %lu %-3d %p %i") ==
+                  (3u | 2u << 2 | 0u << 4 | 1u << 6 | 0u << 8 | 1u << 10),
+              "argument classes");
+
+static const int kMaxFrames = 8;
+static uint8_t frames[kMaxFrames][MUTEXGUARD_BINARY_LOG_FRAME];
+static size_t frameLengths[kMaxFrames];
+static int frameCount = 0;
+
+static void captureSink(const uint8_t* data, size_t length) {
+    if (frameCount < kMaxFrames) {
+        memcpy(frames[frameCount], data, length);
+        frameLengths[frameCount] = length;
+    }
+    frameCount++;
+}
+
+// Undo the escaping and COBS stuffing of frame index; returns the payload length
+static size_t unstuff(int index, uint8_t* payload) {
+    uint8_t frame[MUTEXGUARD_BINARY_LOG_FRAME];
+    size_t length = 0;
+    for (size_t at = 0; at < frameLengths[index]; at++) {
+        uint8_t byte = frames[index][at];
+        TEST_ASSERT_TRUE(byte != '\n' && byte != '\r');
+        if (byte == 0x7D) {
+            byte = frames[index][++at] ^ 0x20;
+            TEST_ASSERT_TRUE(byte == '\n' || byte == '\r' || byte == 0x7D);
+        }
+        frame[length++] = byte;
+    }
+    TEST_ASSERT_TRUE(length >= 4);
+    TEST_ASSERT_EQUAL(0, frame[0]);
+    TEST_ASSERT_EQUAL(0, frame[length - 1]);
+
+    size_t out = 0;
+    size_t at = 1;
+    while (at < length - 1) {
+        uint8_t code = frame[at];
+        TEST_ASSERT_TRUE(code != 0);
+        TEST_ASSERT_TRUE(at + code <= length - 1);
+        for (size_t i = 1; i < code; i++) {
+            TEST_ASSERT_TRUE(frame[at + i] != 0);
+            payload[out++] = frame[at + i];
+        }
+        at += code;
+        if (at < length - 1) {
+            payload[out++] = 0;
+        }
+    }
+    return out;
+}
+
+struct PayloadReader {
+    const uint8_t* data;
+    size_t length;
+    size_t at;
+
+    unsigned long long varint() {
+        unsigned long long value = 0;
+        for (int shift = 0; at < length; shift += 7) {
+            uint8_t byte = data[at++];
+            value |= (unsigned long long)(byte & 0x7F) << shift;
+            if (byte < 0x80) {
+                return value;
+            }
+        }
+        TEST_FAIL_MESSAGE("truncated varint");
+        return 0;
+    }
+
+    long long zigzag() {
+        unsigned long long value = varint();
+        return (long long)(value >> 1) ^ -(long long)(value & 1);
+    }
+
+    bool string(const char* expected) {
+        size_t size = (size_t)varint();
+        bool same = size == strlen(expected) && at + size <= length &&
+                    memcmp(data + at, expected, size) == 0;
+        at += size;
+        return same;
+    }
+};
+
+static uint8_t payload[MUTEXGUARD_BINARY_LOG_FRAME];
+
+static PayloadReader readFrame(int index, uint32_t expectedId) {
+    PayloadReader reader = {payload, unstuff(index, payload), 0};
+    TEST_ASSERT_EQUAL_UINT32(expectedId, (uint32_t)reader.varint());
+    uint32_t timestamp = (uint32_t)reader.varint();
+    TEST_ASSERT_TRUE(esp_log_timestamp() - timestamp < 1000);
+    return reader;
+}
+
+void setUp() {
+    frameCount = 0;
+    BinaryLog::setSink(captureSink);
+}
+
+void tearDown() {
+    BinaryLog::setSink(nullptr);
+    MutexRegistry::clear();
+}
+
+void test_binary_log_respects_runtime_level() {
+    esp_log_level_set("*", ESP_LOG_WARN);
+    MUTEXG_LOG_I("Filtered %u", 1u);
+    MUTEXG_LOG_W("Kept %u", 2u);
+    esp_log_level_set("*", ESP_LOG_NONE);
+    MUTEXG_LOG_E("Filtered %u", 3u);
+    esp_log_level_set("*", ESP_LOG_INFO);
+
+    TEST_ASSERT_EQUAL(1, frameCount);
+    PayloadReader reader = readFrame(0, BinaryLog::messageId(ESP_LOG_WARN, MUTEXG_LOG_TAG, "Kept %u"));
+    TEST_ASSERT_EQUAL_UINT32(2, (uint32_t)reader.varint());
+}
+
+void test_binary_log_frame_layout() {
+    MUTEXG_LOG_W("Value %d", -5);
+    TEST_ASSERT_EQUAL(1, frameCount);
+
+    PayloadReader reader = readFrame(0, BinaryLog::messageId(ESP_LOG_WARN, MUTEXG_LOG_TAG, "Value %d"));
+    TEST_ASSERT_EQUAL(-5, (int)reader.zigzag());
+    TEST_ASSERT_EQUAL(reader.length, reader.at);
+    // Delimiters, COBS code byte, 3-byte ID, 1-3 byte timestamp, 1-byte value
+    TEST_ASSERT_TRUE(frameLengths[0] <= 10);
+}
+
+void test_binary_log_arguments() {
+    int local = 0;
+    MUTEXG_LOG_I("%s %u %x %ld %lld %.2f %p %c", "name", 300u, -1, -70000L, 1LL << 40, 1.5,
+                 (void*)&local, 'z');
+    TEST_ASSERT_EQUAL(1, frameCount);
+
+    PayloadReader reader = readFrame(0, BinaryLog::messageId(ESP_LOG_INFO, MUTEXG_LOG_TAG,
+                                                             "%s %u %x %ld %lld %.2f %p %c"));
+    TEST_ASSERT_TRUE(reader.string("name"));
+    TEST_ASSERT_EQUAL_UINT32(300, (uint32_t)reader.varint());
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFu, (uint32_t)reader.varint());  // As printf sees -1 with %x
+    TEST_ASSERT_TRUE(reader.zigzag() == -70000);
+    TEST_ASSERT_TRUE(reader.zigzag() == (1LL << 40));
+    double value;
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; i++) {
+        bits |= (uint64_t)payload[reader.at++] << (8 * i);
+    }
+    memcpy(&value, &bits, sizeof(value));
+    TEST_ASSERT_TRUE(value == 1.5);
+    TEST_ASSERT_TRUE(reader.varint() == (uintptr_t)&local);
+    TEST_ASSERT_EQUAL('z', (int)reader.varint());
+    TEST_ASSERT_EQUAL(reader.length, reader.at);
+}
+
+void test_binary_log_zero_bytes_stuffed() {
+    MUTEXG_LOG_I("%u %u %d", 0u, 256u, 0);
+    PayloadReader reader = readFrame(0, BinaryLog::messageId(ESP_LOG_INFO, MUTEXG_LOG_TAG, "%u %u %d"));
+    TEST_ASSERT_EQUAL(0, (int)reader.varint());
+    TEST_ASSERT_EQUAL(256, (int)reader.varint());  // 0x80 0x02
+    TEST_ASSERT_EQUAL(0, (int)reader.zigzag());
+    TEST_ASSERT_EQUAL(reader.length, reader.at);
+}
+
+void test_binary_log_line_endings_escaped() {
+    MUTEXG_LOG_I("%u %u %u %u", 10u, 13u, 0x7Du, 0u);
+    TEST_ASSERT_EQUAL(1, frameCount);
+    PayloadReader reader = readFrame(0, BinaryLog::messageId(ESP_LOG_INFO, MUTEXG_LOG_TAG, "%u %u %u %u"));
+    TEST_ASSERT_EQUAL(10, (int)reader.varint());
+    TEST_ASSERT_EQUAL(13, (int)reader.varint());
+    TEST_ASSERT_EQUAL(0x7D, (int)reader.varint());
+    TEST_ASSERT_EQUAL(0, (int)reader.varint());
+    TEST_ASSERT_EQUAL(reader.length, reader.at);
+}
+
+void test_binary_log_guard_messages() {
+    SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+    MutexRegistry::registerMutex(mutex, "bl_mutex");
+    {
+        MutexGuard guard(mutex);
+    }
+    RecursiveMutexGuard invalid(nullptr);
+    TEST_ASSERT_EQUAL(3, frameCount);
+
+    PayloadReader locked = readFrame(0, BinaryLog::messageId(ESP_LOG_INFO, MUTEXG_LOG_TAG, "Mutex '%s' %s"));
+    TEST_ASSERT_TRUE(locked.string("bl_mutex"));
+    TEST_ASSERT_TRUE(locked.string("locked"));
+    PayloadReader unlocked = readFrame(1, 464378);
+    TEST_ASSERT_TRUE(unlocked.string("bl_mutex"));
+    readFrame(2, BinaryLog::messageId(ESP_LOG_WARN, RMUTEXG_LOG_TAG,
+                                      "Attempted to create RecursiveMutexGuard with null handle"));
+    vSemaphoreDelete(mutex);
+}
+
+void test_binary_log_limits() {
+    char longText[MUTEXGUARD_BINARY_LOG_STRING + 20];
+    memset(longText, 'x', sizeof(longText) - 1);
+    longText[sizeof(longText) - 1] = '\0';
+    MUTEXG_LOG_I("%s", longText);
+    TEST_ASSERT_EQUAL(1, frameCount);
+    PayloadReader reader = readFrame(0, BinaryLog::messageId(ESP_LOG_INFO, MUTEXG_LOG_TAG, "%s"));
+    TEST_ASSERT_EQUAL(MUTEXGUARD_BINARY_LOG_STRING, (int)reader.varint());
+
+    // Too large for one frame: dropped and counted, never sent cut short
+    uint32_t droppedBefore = BinaryLog::dropped();
+    MUTEXG_LOG_I("%s %s %s %s", longText, longText, longText, longText);
+    TEST_ASSERT_EQUAL(1, frameCount);
+    TEST_ASSERT_EQUAL_UINT32(1, BinaryLog::dropped() - droppedBefore);
+}
+
+void runBinaryLogTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_binary_log_frame_layout);
+    RUN_TEST(test_binary_log_respects_runtime_level);
+    RUN_TEST(test_binary_log_arguments);
+    RUN_TEST(test_binary_log_zero_bytes_stuffed);
+    RUN_TEST(test_binary_log_line_endings_escaped);
+    RUN_TEST(test_binary_log_guard_messages);
+    RUN_TEST(test_binary_log_limits);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== MutexGuard Binary Logging Tests ===\n");
+    runBinaryLogTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST && MUTEXGUARD_BINARY_LOG
@@ -0,0 +1,180 @@
+/**
+ * @file test_deferred_log.cpp
+ * @brief Unit tests for the MUTEXGUARD_DEFERRED_LOG logging backend
+ */
+
+#if defined(UNIT_TEST) && defined(MUTEXGUARD_DEFERRED_LOG)
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Arduino.h>
+#include <unity.h>
+#include <DeferredLog.h>
+#include <MutexGuard.h>
+#include <MutexGuardLogging.h>
+#include <MutexRegistry.h>
+#include <RecursiveMutexGuard.h>
+
+static const int kMaxLines = 32;
+static char lines[kMaxLines][MUTEXGUARD_DEFERRED_LOG_LINE];
+static const char* tags[kMaxLines];
+static esp_log_level_t levels[kMaxLines];
+static volatile int lineCount = 0;
+
+static volatile bool blockSink = false;
+static SemaphoreHandle_t sinkEntered = nullptr;
+static SemaphoreHandle_t sinkRelease = nullptr;
+
+static void captureSink(esp_log_level_t level, const char* tag, uint32_t timestampMs,
+                        const char* message) {
+    (void)timestampMs;
+    if (blockSink) {
+        blockSink = false;
+        xSemaphoreGive(sinkEntered);
+        xSemaphoreTake(sinkRelease, portMAX_DELAY);
+    }
+    if (lineCount < kMaxLines) {
+        strncpy(lines[lineCount], message, MUTEXGUARD_DEFERRED_LOG_LINE - 1);
+        tags[lineCount] = tag;
+        levels[lineCount] = level;
+        lineCount++;
+    }
+}
+
+static bool captured(const char* text) {
+    for (int i = 0; i < lineCount; i++) {
+        if (strcmp(lines[i], text) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void setUp() {
+    memset(lines, 0, sizeof(lines));
+    lineCount = 0;
+    DeferredLog::setSink(captureSink);
+}
+
+void tearDown() {
+    DeferredLog::flush();
+    DeferredLog::setSink(nullptr);
+    MutexRegistry::clear();
+}
+
+void test_deferred_log_immediate_before_begin() {
+    TEST_ASSERT_FALSE(DeferredLog::isRunning());
+    MUTEXG_LOG_W("Value %d", 42);
+    TEST_ASSERT_EQUAL(1, lineCount);
+    TEST_ASSERT_EQUAL_STRING("Value 42", lines[0]);
+    TEST_ASSERT_EQUAL_STRING(MUTEXG_LOG_TAG, tags[0]);
+    TEST_ASSERT_EQUAL(ESP_LOG_WARN, levels[0]);
+}
+
+void test_deferred_log_formats_in_task() {
+    TEST_ASSERT_TRUE(DeferredLog::begin());
+    TEST_ASSERT_TRUE(DeferredLog::isRunning());
+
+    int local = 0;
+    MUTEXG_LOG_I("%s=%u %ld %lld %x %%", "a", 7u, -5L, 1LL << 40, 255);
+    MUTEXG_LOG_E("%c %.2f %5d|%-3u| %p", 'z', 1.5, -42, 9u, (void*)&local);
+    TEST_ASSERT_TRUE(DeferredLog::flush());
+
+    char expected[MUTEXGUARD_DEFERRED_LOG_LINE];
+    TEST_ASSERT_EQUAL(2, lineCount);
+    snprintf(expected, sizeof(expected), "%s=%u %ld %lld %x %%", "a", 7u, -5L, 1LL << 40, 255);
+    TEST_ASSERT_EQUAL_STRING(expected, lines[0]);
+    TEST_ASSERT_EQUAL(ESP_LOG_INFO, levels[0]);
+    snprintf(expected, sizeof(expected), "%c %.2f %5d|%-3u| %p", 'z', 1.5, -42, 9u, (void*)&local);
+    TEST_ASSERT_EQUAL_STRING(expected, lines[1]);
+    TEST_ASSERT_EQUAL(ESP_LOG_ERROR, levels[1]);
+}
+
+void test_deferred_log_copies_strings() {
+    char buffer[16] = "before";
+    MUTEXG_LOG_I("name %s", buffer);
+    strcpy(buffer, "after");
+    TEST_ASSERT_TRUE(DeferredLog::flush());
+    TEST_ASSERT_EQUAL_STRING("name before", lines[0]);
+}
+
+void test_deferred_log_guard_messages() {
+    SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+    MutexRegistry::registerMutex(mutex, "dl_mutex");
+    {
+        MutexGuard guard(mutex);
+    }
+    RecursiveMutexGuard invalid(nullptr);
+    TEST_ASSERT_TRUE(DeferredLog::flush());
+
+    TEST_ASSERT_TRUE(captured("Mutex 'dl_mutex' locked"));
+    TEST_ASSERT_TRUE(captured("Mutex 'dl_mutex' unlocked"));
+    TEST_ASSERT_TRUE(captured("Attempted to create RecursiveMutexGuard with null handle"));
+    TEST_ASSERT_EQUAL_STRING(RMUTEXG_LOG_TAG, tags[lineCount - 1]);
+    vSemaphoreDelete(mutex);
+}
+
+void test_deferred_log_drops_when_full() {
+    sinkEntered = xSemaphoreCreateBinary();
+    sinkRelease = xSemaphoreCreateBinary();
+    uint32_t droppedBefore = DeferredLog::dropped();
+
+    // Hold the logger task inside the sink, then overfill the queue
+    blockSink = true;
+    MUTEXG_LOG_I("blocker");
+    TEST_ASSERT_TRUE(xSemaphoreTake(sinkEntered, pdMS_TO_TICKS(1000)) == pdTRUE);
+    for (int i = 0; i < MUTEXGUARD_DEFERRED_LOG_DEPTH + 3; i++) {
+        MUTEXG_LOG_I("message %d", i);
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, DeferredLog::dropped() - droppedBefore);
+
+    xSemaphoreGive(sinkRelease);
+    TEST_ASSERT_TRUE(DeferredLog::flush());
+    TEST_ASSERT_TRUE(captured("message 0"));
+    TEST_ASSERT_FALSE(captured("message 8"));
+    TEST_ASSERT_TRUE(captured("3 log messages dropped (queue full)"));
+
+    vSemaphoreDelete(sinkEntered);
+    vSemaphoreDelete(sinkRelease);
+}
+
+void test_deferred_log_limits() {
+    char longText[MUTEXGUARD_DEFERRED_LOG_TEXT + 20];
+    memset(longText, 'x', sizeof(longText) - 1);
+    longText[sizeof(longText) - 1] = '\0';
+    MUTEXG_LOG_I("%s|%s", longText, "cut");
+    MUTEXG_LOG_I("%d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7, 8);
+    MUTEXG_LOG_I("%d %d %d %d %d %d %s %.1f %p", 1, 2, 3, 4, 5, 6, "extra", 1.5, (void*)nullptr);
+    TEST_ASSERT_TRUE(DeferredLog::flush());
+
+    // The first string fills the text area; the second is empty
+    TEST_ASSERT_EQUAL(MUTEXGUARD_DEFERRED_LOG_TEXT, strlen(lines[0]));
+    TEST_ASSERT_EQUAL('|', lines[0][MUTEXGUARD_DEFERRED_LOG_TEXT - 1]);
+    TEST_ASSERT_EQUAL_STRING("1 2 3 4 5 6 ? ?", lines[1]);
+    TEST_ASSERT_EQUAL_STRING("1 2 3 4 5 6 ? ? ?", lines[2]);
+}
+
+void runDeferredLogTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_deferred_log_immediate_before_begin);
+    RUN_TEST(test_deferred_log_formats_in_task);
+    RUN_TEST(test_deferred_log_copies_strings);
+    RUN_TEST(test_deferred_log_guard_messages);
+    RUN_TEST(test_deferred_log_drops_when_full);
+    RUN_TEST(test_deferred_log_limits);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== MutexGuard Deferred Logging Tests ===\n");
+    runDeferredLogTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST && MUTEXGUARD_DEFERRED_LOG
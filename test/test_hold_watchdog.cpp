@@ -0,0 +1,227 @@
+/**
+ * @file test_hold_watchdog.cpp
+ * @brief Unit tests for the MUTEXGUARD_HOLD_WATCHDOG hold-time budgets
+ */
+
+#if defined(UNIT_TEST) && defined(MUTEXGUARD_HOLD_WATCHDOG)
+
+#include <utility>
+
+#include <Arduino.h>
+#include <unity.h>
+#include <HoldWatchdog.h>
+#include <MultiMutexGuard.h>
+#include <MutexGuard.h>
+#include <MutexRegistry.h>
+#include <UniqueMutexGuard.h>
+
+static SemaphoreHandle_t mutexA = nullptr;
+static SemaphoreHandle_t mutexB = nullptr;
+
+static HoldViolation lastViolation;
+static int reportCount = 0;
+
+static void captureViolation(const HoldViolation& violation) {
+    lastViolation = violation;
+    reportCount++;
+}
+
+void setUp() {
+    HoldWatchdog::reset();
+    HoldWatchdog::clearBudgets();
+    HoldWatchdog::setReportHandler(captureViolation);
+    reportCount = 0;
+    mutexA = xSemaphoreCreateMutex();
+    mutexB = xSemaphoreCreateMutex();
+}
+
+void tearDown() {
+    HoldWatchdog::setReportHandler(nullptr);
+    HoldWatchdog::clearBudgets();
+    MutexRegistry::clear();
+    vSemaphoreDelete(mutexA);
+    vSemaphoreDelete(mutexB);
+}
+
+void test_hold_watchdog_no_budget() {
+    {
+        MutexGuard guard(mutexA);
+        vTaskDelay(pdMS_TO_TICKS(3));
+    }
+    TEST_ASSERT_EQUAL(0, HoldWatchdog::budget(mutexA));
+    TEST_ASSERT_EQUAL(0, HoldWatchdog::violations());
+    TEST_ASSERT_EQUAL(0, reportCount);
+}
+
+void test_hold_watchdog_budget_exceeded() {
+    TEST_ASSERT_TRUE(HoldWatchdog::setBudget(mutexA, 1000));
+    {
+        MutexGuard fast(mutexA);  // Well within the budget
+    }
+    TEST_ASSERT_EQUAL(0, reportCount);
+
+    {
+        MutexGuard slow(mutexA);
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+    TEST_ASSERT_EQUAL(1, HoldWatchdog::violations());
+    TEST_ASSERT_EQUAL(1, reportCount);
+    TEST_ASSERT_EQUAL_PTR(mutexA, lastViolation.handle);
+    TEST_ASSERT_NOT_NULL(lastViolation.callSite);
+    TEST_ASSERT_NOT_NULL(lastViolation.taskName);
+    TEST_ASSERT_EQUAL_UINT32(1000, lastViolation.budgetUs);
+    TEST_ASSERT_TRUE(lastViolation.holdUs > 1000);
+}
+
+void test_hold_watchdog_default_and_exempt() {
+    HoldWatchdog::setDefaultBudget(1000);
+    TEST_ASSERT_TRUE(HoldWatchdog::setBudget(mutexB, UINT32_MAX));
+    {
+        MutexGuard a(mutexA);
+        MutexGuard b(mutexB);
+        vTaskDelay(pdMS_TO_TICKS(3));
+    }
+    TEST_ASSERT_EQUAL(1, reportCount);
+    TEST_ASSERT_EQUAL_PTR(mutexA, lastViolation.handle);
+
+    // Removing the override brings mutexB back under the default
+    TEST_ASSERT_TRUE(HoldWatchdog::setBudget(mutexB, 0));
+    TEST_ASSERT_EQUAL_UINT32(1000, HoldWatchdog::budget(mutexB));
+}
+
+void test_hold_watchdog_registry_budget() {
+    HoldWatchdog::setDefaultBudget(50000);
+    MutexRegistry::registerMutex(mutexA, "sensor", "test", 1000);
+    TEST_ASSERT_EQUAL_UINT32(1000, HoldWatchdog::budget(mutexA));
+    TEST_ASSERT_EQUAL_UINT32(50000, HoldWatchdog::budget(mutexB));
+    {
+        MutexGuard guard(mutexA);
+        vTaskDelay(pdMS_TO_TICKS(3));
+    }
+    TEST_ASSERT_EQUAL(1, reportCount);
+    TEST_ASSERT_EQUAL_UINT32(1000, lastViolation.budgetUs);
+
+    // setBudget() overrides the registered value
+    HoldWatchdog::setBudget(mutexA, 2000);
+    TEST_ASSERT_EQUAL_UINT32(2000, HoldWatchdog::budget(mutexA));
+}
+
+void test_hold_watchdog_checked_on_unlock() {
+    HoldWatchdog::setBudget(mutexA, 1000);
+    MutexGuard guard(mutexA);
+    vTaskDelay(pdMS_TO_TICKS(3));
+    guard.unlock();
+    TEST_ASSERT_EQUAL(1, reportCount);
+
+    // The destructor does not report the same section again
+    vTaskDelay(pdMS_TO_TICKS(3));
+    TEST_ASSERT_EQUAL(1, reportCount);
+}
+
+void test_hold_watchdog_moved_unique_guard() {
+    HoldWatchdog::setBudget(mutexA, 1000);
+    {
+        UniqueMutexGuard first(mutexA);
+        vTaskDelay(pdMS_TO_TICKS(3));
+        UniqueMutexGuard second(std::move(first));
+    }
+    TEST_ASSERT_EQUAL(1, reportCount);
+    TEST_ASSERT_NOT_NULL(lastViolation.callSite);
+    TEST_ASSERT_TRUE(lastViolation.holdUs > 1000);
+}
+
+void test_hold_watchdog_multi_guard() {
+    HoldWatchdog::setDefaultBudget(1000);
+    {
+        MultiMutexGuard both({mutexA, mutexB});
+        vTaskDelay(pdMS_TO_TICKS(3));
+    }
+    // One violation per mutex held too long
+    TEST_ASSERT_EQUAL(2, reportCount);
+}
+
+void test_hold_watchdog_recent_order() {
+    HoldWatchdog::setDefaultBudget(1000);
+    {
+        MutexGuard a(mutexA);
+        vTaskDelay(pdMS_TO_TICKS(3));
+    }
+    {
+        MutexGuard b(mutexB);
+        vTaskDelay(pdMS_TO_TICKS(3));
+    }
+
+    HoldViolation recent[4];
+    TEST_ASSERT_EQUAL(2, HoldWatchdog::recentViolations(recent, 4));
+    TEST_ASSERT_EQUAL_PTR(mutexA, recent[0].handle);
+    TEST_ASSERT_EQUAL_PTR(mutexB, recent[1].handle);
+
+    // A short buffer gets the newest
+    TEST_ASSERT_EQUAL(1, HoldWatchdog::recentViolations(recent, 1));
+    TEST_ASSERT_EQUAL_PTR(mutexB, recent[0].handle);
+}
+
+static SemaphoreHandle_t overrunDone = nullptr;
+
+static void overrunTask(void*) {
+    {
+        MutexGuard guard(mutexA);
+        vTaskDelay(pdMS_TO_TICKS(3));
+    }
+    xSemaphoreGive(overrunDone);
+    vTaskDelete(NULL);
+}
+
+void test_hold_watchdog_name_outlives_task() {
+    HoldWatchdog::setBudget(mutexA, 1000);
+    overrunDone = xSemaphoreCreateBinary();
+
+    xTaskCreate(overrunTask, "Overrun", 2048, NULL, 1, NULL);
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(overrunDone, pdMS_TO_TICKS(1000)));
+    vTaskDelay(pdMS_TO_TICKS(20));  // Let the task finish deleting itself
+    vSemaphoreDelete(overrunDone);
+
+    HoldViolation recent[1];
+    TEST_ASSERT_EQUAL(1, HoldWatchdog::recentViolations(recent, 1));
+    TEST_ASSERT_EQUAL_STRING("Overrun", recent[0].taskName);
+}
+
+void test_hold_watchdog_log_rate_limited() {
+    HoldWatchdog::setReportHandler(nullptr);  // Default logging handler
+    HoldWatchdog::setBudget(mutexA, 1000);
+    for (int i = 0; i < 5; i++) {
+        MutexGuard guard(mutexA);
+        vTaskDelay(pdMS_TO_TICKS(2));
+    }
+    // The first is logged, the rest fall within the same interval
+    TEST_ASSERT_EQUAL(5, HoldWatchdog::violations());
+    TEST_ASSERT_EQUAL(4, HoldWatchdog::suppressedReports());
+}
+
+void runHoldWatchdogTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_hold_watchdog_no_budget);
+    RUN_TEST(test_hold_watchdog_budget_exceeded);
+    RUN_TEST(test_hold_watchdog_default_and_exempt);
+    RUN_TEST(test_hold_watchdog_registry_budget);
+    RUN_TEST(test_hold_watchdog_checked_on_unlock);
+    RUN_TEST(test_hold_watchdog_moved_unique_guard);
+    RUN_TEST(test_hold_watchdog_multi_guard);
+    RUN_TEST(test_hold_watchdog_recent_order);
+    RUN_TEST(test_hold_watchdog_name_outlives_task);
+    RUN_TEST(test_hold_watchdog_log_rate_limited);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== MutexGuard Hold-Time Watchdog Tests ===\n");
+    runHoldWatchdogTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST && MUTEXGUARD_HOLD_WATCHDOG
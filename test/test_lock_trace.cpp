@@ -0,0 +1,243 @@
+/**
+ * @file test_lock_trace.cpp
+ * @brief Unit tests for the MUTEXGUARD_TRACE lock event ring
+ */
+
+#if defined(UNIT_TEST) && defined(MUTEXGUARD_TRACE)
+
+#include <string.h>
+
+#include <utility>
+
+#include <Arduino.h>
+#include <unity.h>
+#include <LockTrace.h>
+#include <MultiMutexGuard.h>
+#include <MutexGuard.h>
+#include <MutexRegistry.h>
+#include <RecursiveMutexGuard.h>
+#include <UniqueMutexGuard.h>
+
+static SemaphoreHandle_t mutexA = nullptr;
+static LockTraceEvent events[2 * MUTEXGUARD_TRACE_EVENTS];
+
+void setUp() {
+    LockTrace::stop();
+    LockTrace::clear();
+    mutexA = xSemaphoreCreateMutex();
+}
+
+void tearDown() {
+    LockTrace::stop();
+    MutexRegistry::clear();
+    vSemaphoreDelete(mutexA);
+}
+
+void test_lock_trace_off_until_started() {
+    {
+        MutexGuard guard(mutexA);
+    }
+    TEST_ASSERT_FALSE(LockTrace::isRecording());
+    TEST_ASSERT_EQUAL(0, LockTrace::snapshot(events, 8));
+}
+
+void test_lock_trace_lock_and_release() {
+    LockTrace::start();
+    {
+        MutexGuard guard(mutexA);
+    }
+    LockTrace::stop();
+
+    TEST_ASSERT_EQUAL(3, LockTrace::snapshot(events, 8));
+    TEST_ASSERT_EQUAL(LOCK_TRACE_WAIT, events[0].type);
+    TEST_ASSERT_EQUAL(LOCK_TRACE_ACQUIRED, events[1].type);
+    TEST_ASSERT_EQUAL(LOCK_TRACE_RELEASED, events[2].type);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_PTR(mutexA, events[i].handle);
+        TEST_ASSERT_EQUAL_PTR(xTaskGetCurrentTaskHandle(), events[i].task);
+    }
+    TEST_ASSERT_TRUE(events[2].timestampUs - events[0].timestampUs < 1000000);
+}
+
+void test_lock_trace_timeout() {
+    LockTrace::start();
+    MutexGuard outer(mutexA);
+    {
+        MutexGuard inner(mutexA, 0);
+        TEST_ASSERT_FALSE(inner.hasLock());
+    }
+    LockTrace::stop();
+
+    TEST_ASSERT_EQUAL(4, LockTrace::snapshot(events, 8));
+    TEST_ASSERT_EQUAL(LOCK_TRACE_WAIT, events[2].type);
+    TEST_ASSERT_EQUAL(LOCK_TRACE_TIMEOUT, events[3].type);
+}
+
+void test_lock_trace_recursive() {
+    SemaphoreHandle_t recursive = xSemaphoreCreateRecursiveMutex();
+    LockTrace::start();
+    {
+        RecursiveMutexGuard outer(recursive);
+        RecursiveMutexGuard inner(recursive);
+    }
+    LockTrace::stop();
+
+    TEST_ASSERT_EQUAL(6, LockTrace::snapshot(events, 8));
+    TEST_ASSERT_EQUAL(LOCK_TRACE_RELEASED, events[4].type);
+    TEST_ASSERT_EQUAL(LOCK_TRACE_RELEASED, events[5].type);
+    vSemaphoreDelete(recursive);
+}
+
+void test_lock_trace_unique_guard() {
+    LockTrace::start();
+    {
+        UniqueMutexGuard guard(mutexA);
+        UniqueMutexGuard moved(std::move(guard));
+        moved.unlock();
+        TEST_ASSERT_TRUE(moved.lock());
+        SemaphoreHandle_t handle = moved.release();
+        UniqueMutexGuard adopted(handle, adoptLock);
+    }
+    LockTrace::stop();
+
+    // A move is not an event; release() and adoption end and start a hold
+    const uint8_t expected[] = {LOCK_TRACE_WAIT, LOCK_TRACE_ACQUIRED, LOCK_TRACE_RELEASED,
+                                LOCK_TRACE_WAIT, LOCK_TRACE_ACQUIRED, LOCK_TRACE_RELEASED,
+                                LOCK_TRACE_ACQUIRED, LOCK_TRACE_RELEASED};
+    TEST_ASSERT_EQUAL(8, LockTrace::snapshot(events, 16));
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL(expected[i], events[i].type);
+        TEST_ASSERT_EQUAL_PTR(mutexA, events[i].handle);
+    }
+}
+
+void test_lock_trace_multi_guard() {
+    SemaphoreHandle_t mutexB = xSemaphoreCreateMutex();
+    LockTrace::start();
+    {
+        MultiMutexGuard both({mutexA, mutexB});
+        TEST_ASSERT_TRUE(both.hasLock());
+    }
+    LockTrace::stop();
+
+    // Each mutex of the set gets its own wait, acquisition and release
+    TEST_ASSERT_EQUAL(6, LockTrace::snapshot(events, 16));
+    int counts[2][4] = {};
+    for (int i = 0; i < 6; i++) {
+        int mutex = events[i].handle == mutexA ? 0 : 1;
+        TEST_ASSERT_TRUE(events[i].handle == mutexA || events[i].handle == mutexB);
+        switch (events[i].type) {
+            case LOCK_TRACE_WAIT: counts[mutex][0]++; break;
+            case LOCK_TRACE_ACQUIRED: counts[mutex][1]++; break;
+            case LOCK_TRACE_RELEASED: counts[mutex][2]++; break;
+            default: counts[mutex][3]++; break;
+        }
+    }
+    for (int mutex = 0; mutex < 2; mutex++) {
+        TEST_ASSERT_EQUAL(1, counts[mutex][0]);
+        TEST_ASSERT_EQUAL(1, counts[mutex][1]);
+        TEST_ASSERT_EQUAL(1, counts[mutex][2]);
+        TEST_ASSERT_EQUAL(0, counts[mutex][3]);
+    }
+
+    // A timeout ends the wait of every mutex in the set
+    LockTrace::clear();
+    MutexGuard holder(mutexB);
+    LockTrace::start();
+    {
+        MultiMutexGuard both({mutexA, mutexB}, 0);
+        TEST_ASSERT_FALSE(both.hasLock());
+    }
+    LockTrace::stop();
+    size_t count = LockTrace::snapshot(events, 16);
+    TEST_ASSERT_EQUAL(4, count);
+    TEST_ASSERT_EQUAL(LOCK_TRACE_TIMEOUT, events[2].type);
+    TEST_ASSERT_EQUAL(LOCK_TRACE_TIMEOUT, events[3].type);
+    TEST_ASSERT_TRUE(events[2].handle != events[3].handle);
+
+    holder.unlock();
+    vSemaphoreDelete(mutexB);
+}
+
+void test_lock_trace_keeps_newest() {
+    LockTrace::start();
+    for (int i = 0; i < MUTEXGUARD_TRACE_EVENTS; i++) {
+        MutexGuard guard(mutexA);
+    }
+    LockTrace::stop();
+
+    // Three events per guard overflow the ring of the recording core
+    size_t count = LockTrace::snapshot(events, 2 * MUTEXGUARD_TRACE_EVENTS);
+    TEST_ASSERT_TRUE(count >= MUTEXGUARD_TRACE_EVENTS);
+    TEST_ASSERT_EQUAL(3 * MUTEXGUARD_TRACE_EVENTS, count + LockTrace::overwritten());
+    TEST_ASSERT_EQUAL(LOCK_TRACE_RELEASED, events[count - 1].type);
+    for (size_t i = 1; i < count; i++) {
+        TEST_ASSERT_TRUE(events[i].timestampUs >= events[i - 1].timestampUs);
+    }
+
+    // A short buffer gets the oldest
+    TEST_ASSERT_EQUAL(2, LockTrace::snapshot(events + count, 2));
+    TEST_ASSERT_EQUAL_UINT32(events[0].timestampUs, events[count].timestampUs);
+}
+
+static int dumpLines = 0;
+static int dumpEvents = 0;
+static bool sawTaskName = false;
+static bool sawMutexName = false;
+static bool sawEnd = false;
+
+static void collectLine(const char* line, void* context) {
+    TEST_ASSERT_EQUAL_PTR(&dumpLines, context);
+    dumpLines++;
+    if (strncmp(line, "LT E ", 5) == 0) {
+        dumpEvents++;
+    } else if (strncmp(line, "LT T ", 5) == 0) {
+        sawTaskName = sawTaskName || strstr(line, pcTaskGetName(NULL)) != nullptr;
+    } else if (strncmp(line, "LT M ", 5) == 0) {
+        sawMutexName = sawMutexName || strstr(line, "traced") != nullptr;
+    } else if (strcmp(line, "LT end events=3") == 0) {
+        sawEnd = true;
+    }
+}
+
+void test_lock_trace_dump() {
+    MutexRegistry::registerMutex(mutexA, "traced");
+    LockTrace::start();
+    {
+        MutexGuard guard(mutexA);
+    }
+    LockTrace::stop();
+
+    LockTrace::dump(collectLine, &dumpLines);
+    TEST_ASSERT_EQUAL(3, dumpEvents);
+    TEST_ASSERT_TRUE(sawTaskName);
+    TEST_ASSERT_TRUE(sawMutexName);
+    TEST_ASSERT_TRUE(sawEnd);
+    TEST_ASSERT_EQUAL(7, dumpLines);  // begin, T, M, three E, end
+}
+
+void runLockTraceTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_lock_trace_off_until_started);
+    RUN_TEST(test_lock_trace_lock_and_release);
+    RUN_TEST(test_lock_trace_timeout);
+    RUN_TEST(test_lock_trace_recursive);
+    RUN_TEST(test_lock_trace_unique_guard);
+    RUN_TEST(test_lock_trace_multi_guard);
+    RUN_TEST(test_lock_trace_keeps_newest);
+    RUN_TEST(test_lock_trace_dump);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== MutexGuard Lock Trace Tests ===\n");
+    runLockTraceTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST && MUTEXGUARD_TRACE
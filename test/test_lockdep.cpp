@@ -0,0 +1,342 @@
+/**
+ * @file test_lockdep.cpp
+ * @brief Unit tests for the MUTEXGUARD_LOCKDEP lock-order validator
+ */
+
+#if defined(UNIT_TEST) && defined(MUTEXGUARD_LOCKDEP)
+
+#include <Arduino.h>
+#include <unity.h>
+#include <AdaptiveMutex.h>
+#include <MultiMutexGuard.h>
+#include <MutexGuard.h>
+#include <NotifyMutex.h>
+#include <RecursiveMutexGuard.h>
+#include <SharedMutex.h>
+#include <UniqueMutexGuard.h>
+#include <LockDep.h>
+
+static SemaphoreHandle_t mutexA = nullptr;
+static SemaphoreHandle_t mutexB = nullptr;
+static SemaphoreHandle_t mutexC = nullptr;
+
+static LockDepReport lastReport;
+static int reportCount = 0;
+
+static void captureReport(const LockDepReport& report) {
+    lastReport = report;
+    reportCount++;
+}
+
+void setUp() {
+    LockDep::reset();
+    LockDep::setReportHandler(captureReport);
+    reportCount = 0;
+    mutexA = xSemaphoreCreateMutex();
+    mutexB = xSemaphoreCreateMutex();
+    mutexC = xSemaphoreCreateMutex();
+}
+
+void tearDown() {
+    LockDep::setReportHandler(nullptr);
+    vSemaphoreDelete(mutexA);
+    vSemaphoreDelete(mutexB);
+    vSemaphoreDelete(mutexC);
+}
+
+void test_lockdep_consistent_order() {
+    for (int i = 0; i < 3; i++) {
+        MutexGuard a(mutexA);
+        MutexGuard b(mutexB);
+        MutexGuard c(mutexC);
+        TEST_ASSERT_EQUAL(3, LockDep::heldCount());
+    }
+    TEST_ASSERT_EQUAL(0, LockDep::heldCount());
+    TEST_ASSERT_EQUAL(0, LockDep::violations());
+}
+
+void test_lockdep_inversion_reported_once() {
+    {
+        MutexGuard a(mutexA);
+        MutexGuard b(mutexB);
+    }
+    for (int i = 0; i < 2; i++) {
+        MutexGuard b(mutexB);
+        MutexGuard a(mutexA);
+        TEST_ASSERT_TRUE(a.hasLock());
+    }
+
+    TEST_ASSERT_EQUAL(1, LockDep::violations());
+    TEST_ASSERT_EQUAL(1, reportCount);
+    TEST_ASSERT_EQUAL_PTR(mutexA, lastReport.acquiring);
+    TEST_ASSERT_EQUAL_PTR(mutexB, lastReport.held);
+    TEST_ASSERT_NOT_NULL(lastReport.acquireSite);
+    TEST_ASSERT_NOT_NULL(lastReport.heldSite);
+
+    // Both sites of the earlier A -> B order are reported
+    TEST_ASSERT_EQUAL(1, lastReport.chainLength);
+    TEST_ASSERT_EQUAL_PTR(mutexA, lastReport.chain[0].from);
+    TEST_ASSERT_EQUAL_PTR(mutexB, lastReport.chain[0].to);
+    TEST_ASSERT_NOT_NULL(lastReport.chain[0].fromSite);
+    TEST_ASSERT_NOT_NULL(lastReport.chain[0].toSite);
+}
+
+void test_lockdep_transitive_cycle() {
+    {
+        MutexGuard a(mutexA);
+        MutexGuard b(mutexB);
+    }
+    {
+        MutexGuard b(mutexB);
+        MutexGuard c(mutexC);
+    }
+    {
+        MutexGuard c(mutexC);
+        MutexGuard a(mutexA);
+    }
+
+    TEST_ASSERT_EQUAL(1, reportCount);
+    TEST_ASSERT_EQUAL_PTR(mutexA, lastReport.acquiring);
+    TEST_ASSERT_EQUAL_PTR(mutexC, lastReport.held);
+    TEST_ASSERT_EQUAL(2, lastReport.chainLength);
+    TEST_ASSERT_EQUAL_PTR(mutexA, lastReport.chain[0].from);
+    TEST_ASSERT_EQUAL_PTR(mutexB, lastReport.chain[1].from);
+    TEST_ASSERT_EQUAL_PTR(mutexC, lastReport.chain[1].to);
+}
+
+void test_lockdep_recursive_reentry() {
+    SemaphoreHandle_t recursive = xSemaphoreCreateRecursiveMutex();
+    {
+        RecursiveMutexGuard outer(recursive);
+        MutexGuard b(mutexB);
+        RecursiveMutexGuard inner(recursive);  // Does not block: not an inversion
+        TEST_ASSERT_TRUE(inner.hasLock());
+    }
+    TEST_ASSERT_EQUAL(0, LockDep::violations());
+    TEST_ASSERT_EQUAL(0, LockDep::heldCount());
+    LockDep::forget(recursive);
+    vSemaphoreDelete(recursive);
+}
+
+void test_lockdep_self_deadlock() {
+    MutexGuard outer(mutexA);
+    MutexGuard inner(mutexA, 0);
+    TEST_ASSERT_FALSE(inner.hasLock());
+
+    TEST_ASSERT_EQUAL(1, reportCount);
+    TEST_ASSERT_EQUAL_PTR(mutexA, lastReport.acquiring);
+    TEST_ASSERT_EQUAL_PTR(mutexA, lastReport.held);
+    TEST_ASSERT_EQUAL(0, lastReport.chainLength);
+}
+
+void test_lockdep_forget() {
+    {
+        MutexGuard a(mutexA);
+        MutexGuard b(mutexB);
+    }
+    LockDep::forget(mutexA);
+    {
+        MutexGuard b(mutexB);
+        MutexGuard a(mutexA);
+    }
+    TEST_ASSERT_EQUAL(0, LockDep::violations());
+}
+
+void test_lockdep_out_of_order_unlock() {
+    MutexGuard a(mutexA);
+    MutexGuard b(mutexB);
+    a.unlock();
+    TEST_ASSERT_EQUAL(1, LockDep::heldCount());
+    b.unlock();
+    TEST_ASSERT_EQUAL(0, LockDep::heldCount());
+
+    // With nothing held, taking the locks singly records no ordering
+    {
+        MutexGuard b2(mutexB);
+    }
+    {
+        MutexGuard a2(mutexA);
+    }
+    TEST_ASSERT_EQUAL(0, LockDep::violations());
+}
+
+void test_lockdep_multi_guard_any_order() {
+    {
+        MultiMutexGuard ab({mutexA, mutexB});
+        TEST_ASSERT_EQUAL(2, LockDep::heldCount());
+    }
+    {
+        MultiMutexGuard ba({mutexB, mutexA});
+        MutexGuard c(mutexC);  // Ordered after both members
+    }
+    TEST_ASSERT_EQUAL(0, LockDep::heldCount());
+    TEST_ASSERT_EQUAL(0, LockDep::violations());
+
+    // The set is still ordered against locks taken outside it: C -> A and
+    // C -> B each invert an earlier order
+    {
+        MutexGuard c(mutexC);
+        MultiMutexGuard ab({mutexA, mutexB});
+    }
+    TEST_ASSERT_EQUAL(2, LockDep::violations());
+}
+
+void test_lockdep_adaptive_guard() {
+    AdaptiveMutex adaptive;
+    {
+        MutexGuard a(mutexA);
+        AdaptiveMutexGuard lock(adaptive);
+        TEST_ASSERT_EQUAL(2, LockDep::heldCount());
+    }
+    TEST_ASSERT_EQUAL(0, LockDep::heldCount());
+    {
+        AdaptiveMutexGuard lock(adaptive);
+        MutexGuard a(mutexA);
+    }
+    TEST_ASSERT_EQUAL(1, LockDep::violations());
+    TEST_ASSERT_EQUAL_PTR(adaptive.handle(), lastReport.held);
+}
+
+void test_lockdep_shared_guards() {
+    SharedMutex shared;
+    {
+        SharedGuard read(shared);
+        MutexGuard a(mutexA);
+        TEST_ASSERT_EQUAL(2, LockDep::heldCount());
+    }
+    TEST_ASSERT_EQUAL(0, LockDep::heldCount());
+    {
+        MutexGuard a(mutexA);
+        ExclusiveGuard write(shared);  // Inverts the order taken under the read lock
+    }
+    TEST_ASSERT_EQUAL(1, LockDep::violations());
+    TEST_ASSERT_EQUAL_PTR(shared.handle(), lastReport.acquiring);
+    TEST_ASSERT_EQUAL(0, LockDep::heldCount());
+}
+
+void test_lockdep_unique_guard_release_and_adopt() {
+    // release() hands the lock to the caller, who gives it back directly
+    UniqueMutexGuard released(mutexA);
+    TEST_ASSERT_EQUAL(1, LockDep::heldCount());
+    SemaphoreHandle_t handle = released.release();
+    TEST_ASSERT_EQUAL(0, LockDep::heldCount());
+    xSemaphoreGive(handle);
+
+    // A release()d lock adopted by another guard is tracked once
+    {
+        UniqueMutexGuard first(mutexA);
+        UniqueMutexGuard second(first.release(), adoptLock);
+        TEST_ASSERT_EQUAL(1, LockDep::heldCount());
+    }
+    TEST_ASSERT_EQUAL(0, LockDep::heldCount());
+
+    // An adopted lock is ordered against locks taken while it is held
+    TEST_ASSERT_TRUE(xSemaphoreTake(mutexA, 0) == pdTRUE);
+    {
+        UniqueMutexGuard adopted(mutexA, adoptLock);
+        MutexGuard c(mutexC);
+        TEST_ASSERT_EQUAL(2, LockDep::heldCount());
+    }
+    TEST_ASSERT_EQUAL(0, LockDep::heldCount());
+    {
+        MutexGuard c(mutexC);
+        MutexGuard a(mutexA);
+    }
+    TEST_ASSERT_EQUAL(1, LockDep::violations());
+    TEST_ASSERT_EQUAL_PTR(mutexA, lastReport.acquiring);
+}
+
+void test_lockdep_notify_guard() {
+    NotifyMutex notify;
+    {
+        NotifyMutexGuard n(notify);
+        MutexGuard a(mutexA);
+        TEST_ASSERT_EQUAL(2, LockDep::heldCount());
+    }
+    TEST_ASSERT_EQUAL(0, LockDep::heldCount());
+    {
+        MutexGuard a(mutexA);
+        NotifyMutexGuard n(notify);
+    }
+    TEST_ASSERT_EQUAL(1, LockDep::violations());
+    TEST_ASSERT_EQUAL_PTR(notify.handle(), lastReport.acquiring);
+}
+
+__attribute__((noinline)) static void lockBThenA() {
+    MutexGuard b(mutexB);
+    MutexGuard a(mutexA);
+}
+
+void test_lockdep_reports_guard_sites() {
+    {
+        MutexGuard a(mutexA);
+        MutexGuard b(mutexB);
+    }
+    lockBThenA();
+    TEST_ASSERT_EQUAL(1, LockDep::violations());
+
+    // Each guard is reported at its own line, inlined guards included
+    uintptr_t function = (uintptr_t)&lockBThenA;
+    TEST_ASSERT_TRUE(lastReport.acquireSite != lastReport.heldSite);
+    TEST_ASSERT_TRUE((uintptr_t)lastReport.heldSite > function);
+    TEST_ASSERT_TRUE((uintptr_t)lastReport.acquireSite > (uintptr_t)lastReport.heldSite);
+}
+
+static SemaphoreHandle_t taskDone = nullptr;
+
+static void orderAtoBTask(void* parameter) {
+    (void)parameter;
+    {
+        MutexGuard a(mutexA);
+        MutexGuard b(mutexB);
+    }
+    xSemaphoreGive(taskDone);
+    vTaskDelete(NULL);
+}
+
+void test_lockdep_detects_across_tasks() {
+    // The tasks never run their sections concurrently, so nothing hangs,
+    // but the hazard is still found
+    taskDone = xSemaphoreCreateBinary();
+    xTaskCreate(orderAtoBTask, "lockdep_ab", 4096, NULL, 1, NULL);
+    TEST_ASSERT_TRUE(xSemaphoreTake(taskDone, pdMS_TO_TICKS(1000)) == pdTRUE);
+    {
+        MutexGuard b(mutexB);
+        MutexGuard a(mutexA);
+    }
+    TEST_ASSERT_EQUAL(1, reportCount);
+    TEST_ASSERT_EQUAL_PTR(mutexA, lastReport.acquiring);
+    vSemaphoreDelete(taskDone);
+}
+
+void runLockDepTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_lockdep_consistent_order);
+    RUN_TEST(test_lockdep_inversion_reported_once);
+    RUN_TEST(test_lockdep_transitive_cycle);
+    RUN_TEST(test_lockdep_recursive_reentry);
+    RUN_TEST(test_lockdep_self_deadlock);
+    RUN_TEST(test_lockdep_forget);
+    RUN_TEST(test_lockdep_out_of_order_unlock);
+    RUN_TEST(test_lockdep_multi_guard_any_order);
+    RUN_TEST(test_lockdep_adaptive_guard);
+    RUN_TEST(test_lockdep_shared_guards);
+    RUN_TEST(test_lockdep_unique_guard_release_and_adopt);
+    RUN_TEST(test_lockdep_notify_guard);
+    RUN_TEST(test_lockdep_reports_guard_sites);
+    RUN_TEST(test_lockdep_detects_across_tasks);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== MutexGuard Lock-Order Validator Tests ===\n");
+    runLockDepTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST && MUTEXGUARD_LOCKDEP
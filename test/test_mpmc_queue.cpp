@@ -0,0 +1,166 @@
+/**
+ * @file test_mpmc_queue.cpp
+ * @brief Unit tests for MpmcQueue
+ */
+
+#ifdef UNIT_TEST
+
+#include <Arduino.h>
+#include <unity.h>
+#include <MpmcQueue.h>
+
+#define MPMC_TEST_PRODUCERS 4
+#define MPMC_TEST_CONSUMERS 2
+#define MPMC_TEST_ITEMS 5000  // Per producer
+
+static MpmcQueue<uint32_t, 8> smallQueue;
+static MpmcQueue<uint32_t, 8> fanInQueue;
+
+static SemaphoreHandle_t tasksDone = nullptr;
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_mpmc_queue_fifo_and_bounds() {
+    uint32_t value = 0;
+    TEST_ASSERT_TRUE(smallQueue.isValid());
+    TEST_ASSERT_TRUE(smallQueue.empty());
+    TEST_ASSERT_FALSE(smallQueue.tryPop(value));
+
+    // Several laps so every slot's sequence number wraps
+    for (uint32_t lap = 0; lap < 3; lap++) {
+        for (uint32_t i = 0; i < smallQueue.capacity(); i++) {
+            TEST_ASSERT_TRUE(smallQueue.tryPush(lap * 100 + i));
+        }
+        TEST_ASSERT_FALSE(smallQueue.tryPush(999));
+        TEST_ASSERT_EQUAL_UINT32(8, smallQueue.size());
+
+        for (uint32_t i = 0; i < smallQueue.capacity(); i++) {
+            TEST_ASSERT_TRUE(smallQueue.tryPop(value));
+            TEST_ASSERT_EQUAL_UINT32(lap * 100 + i, value);
+        }
+        TEST_ASSERT_FALSE(smallQueue.tryPop(value));
+    }
+}
+
+void test_mpmc_queue_timeouts() {
+    uint32_t value = 0;
+    TickType_t start = xTaskGetTickCount();
+    TEST_ASSERT_FALSE(smallQueue.pop(value, pdMS_TO_TICKS(20)));
+    TEST_ASSERT_TRUE(xTaskGetTickCount() - start >= pdMS_TO_TICKS(15));
+
+    for (uint32_t i = 0; i < smallQueue.capacity(); i++) {
+        TEST_ASSERT_TRUE(smallQueue.push(i, 0));
+    }
+    TEST_ASSERT_FALSE(smallQueue.push(99, 0));
+    TEST_ASSERT_FALSE(smallQueue.push(99, pdMS_TO_TICKS(10)));
+
+    for (uint32_t i = 0; i < smallQueue.capacity(); i++) {
+        TEST_ASSERT_TRUE(smallQueue.pop(value, 0));
+    }
+}
+
+static void delayedPushTask(void* param) {
+    (void)param;
+    vTaskDelay(pdMS_TO_TICKS(20));
+    smallQueue.tryPush(42);
+    xSemaphoreGive(tasksDone);
+    vTaskDelete(NULL);
+}
+
+void test_mpmc_queue_try_push_wakes_blocked_pop() {
+    tasksDone = xSemaphoreCreateBinary();
+    xTaskCreate(delayedPushTask, "MpmcDelayed", 2048, NULL, 1, NULL);
+
+    uint32_t value = 0;
+    TEST_ASSERT_TRUE(smallQueue.pop(value, pdMS_TO_TICKS(2000)));
+    TEST_ASSERT_EQUAL_UINT32(42, value);
+
+    TEST_ASSERT_TRUE(xSemaphoreTake(tasksDone, pdMS_TO_TICKS(1000)) == pdTRUE);
+    vSemaphoreDelete(tasksDone);
+}
+
+static uint32_t received[MPMC_TEST_CONSUMERS];
+static bool inOrder[MPMC_TEST_CONSUMERS];
+
+static void fanInProducerTask(void* param) {
+    uint32_t producer = (uint32_t)(intptr_t)param;
+    for (uint32_t i = 0; i < MPMC_TEST_ITEMS; i++) {
+        fanInQueue.push((producer << 24) | i, portMAX_DELAY);
+    }
+    xSemaphoreGive(tasksDone);
+    vTaskDelete(NULL);
+}
+
+static void fanInConsumerTask(void* param) {
+    int consumer = (int)(intptr_t)param;
+    const uint32_t share = MPMC_TEST_PRODUCERS * MPMC_TEST_ITEMS / MPMC_TEST_CONSUMERS;
+    int32_t last[MPMC_TEST_PRODUCERS];
+    for (int p = 0; p < MPMC_TEST_PRODUCERS; p++) {
+        last[p] = -1;
+    }
+
+    inOrder[consumer] = true;
+    for (received[consumer] = 0; received[consumer] < share; received[consumer]++) {
+        uint32_t value = 0;
+        fanInQueue.pop(value, portMAX_DELAY);
+
+        // One consumer sees each producer's elements in the order they were pushed
+        uint32_t producer = value >> 24;
+        int32_t sequence = (int32_t)(value & 0xffffff);
+        if (producer >= MPMC_TEST_PRODUCERS || sequence <= last[producer]) {
+            inOrder[consumer] = false;
+        } else {
+            last[producer] = sequence;
+        }
+    }
+    xSemaphoreGive(tasksDone);
+    vTaskDelete(NULL);
+}
+
+void test_mpmc_queue_fan_in_fan_out() {
+    tasksDone = xSemaphoreCreateCounting(MPMC_TEST_PRODUCERS + MPMC_TEST_CONSUMERS, 0);
+
+    for (int i = 0; i < MPMC_TEST_CONSUMERS; i++) {
+        xTaskCreatePinnedToCore(fanInConsumerTask, "MpmcConsumer", 2048, (void*)(intptr_t)i, 1,
+                                NULL, i % portNUM_PROCESSORS);
+    }
+    for (int i = 0; i < MPMC_TEST_PRODUCERS; i++) {
+        xTaskCreatePinnedToCore(fanInProducerTask, "MpmcProducer", 2048, (void*)(intptr_t)i, 1,
+                                NULL, i % portNUM_PROCESSORS);
+    }
+    for (int i = 0; i < MPMC_TEST_PRODUCERS + MPMC_TEST_CONSUMERS; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(tasksDone, pdMS_TO_TICKS(10000)) == pdTRUE);
+    }
+
+    for (int i = 0; i < MPMC_TEST_CONSUMERS; i++) {
+        TEST_ASSERT_EQUAL_UINT32(MPMC_TEST_PRODUCERS * MPMC_TEST_ITEMS / MPMC_TEST_CONSUMERS,
+                                 received[i]);
+        TEST_ASSERT_TRUE(inOrder[i]);
+    }
+    TEST_ASSERT_TRUE(fanInQueue.empty());
+    vSemaphoreDelete(tasksDone);
+}
+
+void runMpmcQueueTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mpmc_queue_fifo_and_bounds);
+    RUN_TEST(test_mpmc_queue_timeouts);
+    RUN_TEST(test_mpmc_queue_try_push_wakes_blocked_pop);
+    RUN_TEST(test_mpmc_queue_fan_in_fan_out);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== MpmcQueue Tests ===\n");
+    runMpmcQueueTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST
@@ -0,0 +1,164 @@
+/**
+ * @file test_multi_mutex_guard.cpp
+ * @brief Unit tests for MultiMutexGuard
+ */
+
+#ifdef UNIT_TEST
+
+#include <Arduino.h>
+#include <unity.h>
+#include <MultiMutexGuard.h>
+
+#define MULTI_TEST_ITERATIONS 2000
+
+static SemaphoreHandle_t mutexA = nullptr;
+static SemaphoreHandle_t mutexB = nullptr;
+static SemaphoreHandle_t mutexC = nullptr;
+
+void setUp() {
+    if (mutexA == nullptr) {
+        mutexA = xSemaphoreCreateMutex();
+        mutexB = xSemaphoreCreateMutex();
+        mutexC = xSemaphoreCreateMutex();
+    }
+}
+
+void tearDown() {}
+
+static bool isFree(SemaphoreHandle_t handle) {
+    if (xSemaphoreTake(handle, 0) != pdTRUE) {
+        return false;
+    }
+    xSemaphoreGive(handle);
+    return true;
+}
+
+void test_multi_guard_locks_all_and_releases() {
+    {
+        MultiMutexGuard guard({mutexA, mutexB, mutexC});
+        TEST_ASSERT_TRUE(guard.hasLock());
+        TEST_ASSERT_TRUE(guard.isValid());
+        TEST_ASSERT_EQUAL(3, guard.count());
+        TEST_ASSERT_EQUAL(-1, guard.failedIndex());
+        TEST_ASSERT_FALSE(isFree(mutexA));
+        TEST_ASSERT_FALSE(isFree(mutexB));
+        TEST_ASSERT_FALSE(isFree(mutexC));
+    }
+    TEST_ASSERT_TRUE(isFree(mutexA));
+    TEST_ASSERT_TRUE(isFree(mutexB));
+    TEST_ASSERT_TRUE(isFree(mutexC));
+}
+
+void test_multi_guard_manual_unlock() {
+    SemaphoreHandle_t handles[] = {mutexB, mutexA};
+    MultiMutexGuard guard(handles, 2);
+    TEST_ASSERT_TRUE(guard.hasLock());
+
+    guard.unlock();
+    guard.unlock();  // Safe to call twice
+    TEST_ASSERT_FALSE(guard.hasLock());
+    TEST_ASSERT_TRUE(isFree(mutexA));
+    TEST_ASSERT_TRUE(isFree(mutexB));
+}
+
+void test_multi_guard_timeout_reports_busy_handle() {
+    xSemaphoreTake(mutexB, portMAX_DELAY);
+
+    unsigned long start = millis();
+    MultiMutexGuard guard({mutexA, mutexB, mutexC}, pdMS_TO_TICKS(30));
+    unsigned long elapsed = millis() - start;
+
+    TEST_ASSERT_FALSE(guard.hasLock());
+    TEST_ASSERT_TRUE(guard.isValid());
+    TEST_ASSERT_EQUAL(1, guard.failedIndex());
+    TEST_ASSERT_TRUE(guard.failedHandle() == mutexB);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, guard.retries());
+    TEST_ASSERT_LESS_OR_EQUAL(80, elapsed);
+
+    // Nothing stays held after a failure
+    TEST_ASSERT_TRUE(isFree(mutexA));
+    TEST_ASSERT_TRUE(isFree(mutexC));
+    xSemaphoreGive(mutexB);
+}
+
+void test_multi_guard_rejects_invalid_sets() {
+    MultiMutexGuard withNull({mutexA, nullptr});
+    TEST_ASSERT_FALSE(withNull.isValid());
+    TEST_ASSERT_FALSE(withNull.hasLock());
+    TEST_ASSERT_EQUAL(1, withNull.failedIndex());
+
+    MultiMutexGuard duplicate({mutexA, mutexB, mutexA});
+    TEST_ASSERT_FALSE(duplicate.isValid());
+    TEST_ASSERT_EQUAL(2, duplicate.failedIndex());
+    TEST_ASSERT_TRUE(duplicate.failedHandle() == mutexA);
+
+    TEST_ASSERT_TRUE(isFree(mutexA));
+    TEST_ASSERT_TRUE(isFree(mutexB));
+}
+
+static volatile uint32_t sharedA = 0;
+static volatile uint32_t sharedB = 0;
+static volatile uint32_t multiFailures = 0;
+static SemaphoreHandle_t multiDone = nullptr;
+
+static void opposingOrderTask(void* param) {
+    bool reversed = param != nullptr;
+    for (int i = 0; i < MULTI_TEST_ITERATIONS; i++) {
+        // Nested guards in these orders could deadlock
+        MultiMutexGuard guard(reversed ? std::initializer_list<SemaphoreHandle_t>{mutexB, mutexA}
+                                       : std::initializer_list<SemaphoreHandle_t>{mutexA, mutexB},
+                              pdMS_TO_TICKS(1000));
+        if (!guard) {
+            multiFailures = multiFailures + 1;
+            continue;
+        }
+        sharedA = sharedA + 1;
+        if ((i & 0x3f) == 0) {
+            taskYIELD();  // Let the other task find the pair busy
+        }
+        sharedB = sharedB + 1;
+    }
+    xSemaphoreGive(multiDone);
+    vTaskDelete(NULL);
+}
+
+void test_multi_guard_opposite_orders_do_not_deadlock() {
+    sharedA = 0;
+    sharedB = 0;
+    multiFailures = 0;
+    multiDone = xSemaphoreCreateCounting(2, 0);
+
+    xTaskCreatePinnedToCore(opposingOrderTask, "MultiAB", 2048, NULL, 1, NULL, 0);
+    xTaskCreatePinnedToCore(opposingOrderTask, "MultiBA", 2048, (void*)1, 1, NULL, 1);
+
+    TEST_ASSERT_TRUE(xSemaphoreTake(multiDone, pdMS_TO_TICKS(20000)) == pdTRUE);
+    TEST_ASSERT_TRUE(xSemaphoreTake(multiDone, pdMS_TO_TICKS(20000)) == pdTRUE);
+
+    TEST_ASSERT_EQUAL(0, multiFailures);
+    TEST_ASSERT_EQUAL(2 * MULTI_TEST_ITERATIONS, sharedA);
+    TEST_ASSERT_EQUAL(2 * MULTI_TEST_ITERATIONS, sharedB);
+    vSemaphoreDelete(multiDone);
+}
+
+void runMultiMutexGuardTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_multi_guard_locks_all_and_releases);
+    RUN_TEST(test_multi_guard_manual_unlock);
+    RUN_TEST(test_multi_guard_timeout_reports_busy_handle);
+    RUN_TEST(test_multi_guard_rejects_invalid_sets);
+    RUN_TEST(test_multi_guard_opposite_orders_do_not_deadlock);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== MultiMutexGuard Tests ===\n");
+    runMultiMutexGuardTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST
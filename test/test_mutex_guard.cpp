@@ -133,6 +133,20 @@ void test_mutex_guard_default_timeout() {
     xSemaphoreGive(testMutex);
 }
 
+typedef BasicGuard<MutexLockPolicy, NoGuardChecks, SilentGuardLog> UncheckedMutexGuard;
+
+void test_basic_guard_unchecked_instantiation() {
+    TEST_ASSERT_EQUAL(sizeof(MutexGuard), sizeof(UncheckedMutexGuard));
+    {
+        UncheckedMutexGuard guard(testMutex);
+        TEST_ASSERT_TRUE(guard.hasLock());
+        TEST_ASSERT_EQUAL(pdFALSE, xSemaphoreTake(testMutex, 0));
+    }
+    BaseType_t taken = xSemaphoreTake(testMutex, 0);
+    TEST_ASSERT_EQUAL(pdTRUE, taken);
+    xSemaphoreGive(testMutex);
+}
+
 // Test runner
 void runMutexGuardTests() {
     UNITY_BEGIN();
@@ -147,6 +161,7 @@ void runMutexGuardTests() {
     RUN_TEST(test_mutex_guard_double_unlock_safe);
     RUN_TEST(test_mutex_guard_nested_scope);
     RUN_TEST(test_mutex_guard_default_timeout);
+    RUN_TEST(test_basic_guard_unchecked_instantiation);
 
     UNITY_END();
 }
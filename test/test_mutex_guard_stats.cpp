@@ -0,0 +1,236 @@
+/**
+ * @file test_mutex_guard_stats.cpp
+ * @brief Unit tests for the MUTEXGUARD_STATS contention statistics
+ *
+ * Built with and without MUTEXGUARD_STATS_HISTOGRAM; the histogram tests
+ * only run in the former configuration.
+ */
+
+#if defined(UNIT_TEST) && (defined(MUTEXGUARD_STATS) || defined(MUTEXGUARD_STATS_HISTOGRAM))
+
+#include <Arduino.h>
+#include <unity.h>
+#include <MutexGuard.h>
+#include <RecursiveMutexGuard.h>
+
+static SemaphoreHandle_t testMutex = nullptr;
+
+void setUp() {
+    MutexGuardStats::resetAll();
+    testMutex = xSemaphoreCreateMutex();
+}
+
+void tearDown() {
+    vSemaphoreDelete(testMutex);
+    testMutex = nullptr;
+}
+
+void test_stats_unknown_handle() {
+    MutexStatsSnapshot stats;
+    TEST_ASSERT_FALSE(MutexGuardStats::snapshot(testMutex, stats));
+    TEST_ASSERT_FALSE(MutexGuardStats::snapshot(nullptr, stats));
+}
+
+void test_stats_counts_acquisitions() {
+    for (int i = 0; i < 5; i++) {
+        MutexGuard guard(testMutex);
+        TEST_ASSERT_TRUE(guard.hasLock());
+    }
+
+    MutexStatsSnapshot stats;
+    TEST_ASSERT_TRUE(MutexGuardStats::snapshot(testMutex, stats));
+    TEST_ASSERT_EQUAL_PTR(testMutex, stats.handle);
+    TEST_ASSERT_EQUAL(5, stats.acquisitions);
+    TEST_ASSERT_EQUAL(0, stats.failedAcquisitions);
+}
+
+void test_stats_hold_time() {
+    {
+        MutexGuard guard(testMutex);
+        delay(20);
+    }
+
+    MutexStatsSnapshot stats;
+    TEST_ASSERT_TRUE(MutexGuardStats::snapshot(testMutex, stats));
+    TEST_ASSERT_GREATER_OR_EQUAL(15000, stats.maxHoldUs);
+    TEST_ASSERT_GREATER_OR_EQUAL(stats.maxHoldUs, stats.totalHoldUs);
+}
+
+void test_stats_failed_acquisition_wait_time() {
+    xSemaphoreTake(testMutex, portMAX_DELAY);
+    {
+        MutexGuard guard(testMutex, pdMS_TO_TICKS(20));
+        TEST_ASSERT_FALSE(guard.hasLock());
+    }
+    xSemaphoreGive(testMutex);
+
+    MutexStatsSnapshot stats;
+    TEST_ASSERT_TRUE(MutexGuardStats::snapshot(testMutex, stats));
+    TEST_ASSERT_EQUAL(0, stats.acquisitions);
+    TEST_ASSERT_EQUAL(1, stats.failedAcquisitions);
+    TEST_ASSERT_GREATER_OR_EQUAL(15000, stats.maxWaitUs);
+    TEST_ASSERT_EQUAL(0, stats.totalHoldUs);
+}
+
+void test_stats_recursive_guard() {
+    SemaphoreHandle_t recursive = xSemaphoreCreateRecursiveMutex();
+    {
+        RecursiveMutexGuard outer(recursive);
+        RecursiveMutexGuard inner(recursive);
+        TEST_ASSERT_TRUE(inner.hasLock());
+    }
+
+    MutexStatsSnapshot stats;
+    TEST_ASSERT_TRUE(MutexGuardStats::snapshot(recursive, stats));
+    TEST_ASSERT_EQUAL(2, stats.acquisitions);
+    vSemaphoreDelete(recursive);
+}
+
+void test_stats_reset() {
+    {
+        MutexGuard guard(testMutex);
+    }
+    MutexGuardStats::reset(testMutex);
+
+    MutexStatsSnapshot stats;
+    TEST_ASSERT_TRUE(MutexGuardStats::snapshot(testMutex, stats));
+    TEST_ASSERT_EQUAL(0, stats.acquisitions);
+    TEST_ASSERT_EQUAL(0, stats.maxHoldUs);
+}
+
+void test_stats_snapshot_all() {
+    SemaphoreHandle_t other = xSemaphoreCreateMutex();
+    {
+        MutexGuard a(testMutex);
+        MutexGuard b(other);
+    }
+
+    MutexStatsSnapshot all[MUTEXGUARD_STATS_MAX_MUTEXES];
+    TEST_ASSERT_EQUAL(2, MutexGuardStats::snapshotAll(all, MUTEXGUARD_STATS_MAX_MUTEXES));
+    TEST_ASSERT_EQUAL(1, MutexGuardStats::snapshotAll(all, 1));
+    vSemaphoreDelete(other);
+}
+
+void test_stats_table_full() {
+    SemaphoreHandle_t extra[MUTEXGUARD_STATS_MAX_MUTEXES];
+    for (int i = 0; i < MUTEXGUARD_STATS_MAX_MUTEXES; i++) {
+        extra[i] = xSemaphoreCreateMutex();
+        MutexGuard guard(extra[i]);
+    }
+
+    // Every slot is taken, so the test mutex cannot be tracked
+    {
+        MutexGuard guard(testMutex);
+        TEST_ASSERT_TRUE(guard.hasLock());
+    }
+    MutexStatsSnapshot stats;
+    TEST_ASSERT_FALSE(MutexGuardStats::snapshot(testMutex, stats));
+    TEST_ASSERT_GREATER_THAN(0, MutexGuardStats::droppedRecords());
+
+    for (int i = 0; i < MUTEXGUARD_STATS_MAX_MUTEXES; i++) {
+        vSemaphoreDelete(extra[i]);
+    }
+}
+
+#ifdef MUTEXGUARD_STATS_HISTOGRAM
+void test_histogram_bucket_layout() {
+    // Small values are exact
+    for (uint32_t v = 0; v < LatencyHistogram::kSubBuckets; v++) {
+        TEST_ASSERT_EQUAL(v, LatencyHistogram::bucketIndex(v));
+        TEST_ASSERT_EQUAL(v, LatencyHistogram::bucketUpperBound(v));
+    }
+
+    // Every value lies within its bucket and buckets are contiguous
+    uint32_t previousUpper = LatencyHistogram::kSubBuckets - 1;
+    for (size_t i = LatencyHistogram::kSubBuckets; i < LatencyHistogram::kBucketCount - 1; i++) {
+        uint32_t upper = LatencyHistogram::bucketUpperBound(i);
+        TEST_ASSERT_EQUAL(i, LatencyHistogram::bucketIndex(previousUpper + 1));
+        TEST_ASSERT_EQUAL(i, LatencyHistogram::bucketIndex(upper));
+        previousUpper = upper;
+    }
+
+    // Everything from 2^MAX_BITS goes to the overflow bucket
+    TEST_ASSERT_EQUAL(LatencyHistogram::kBucketCount - 1,
+                      LatencyHistogram::bucketIndex(1u << LatencyHistogram::kMaxBits));
+    TEST_ASSERT_EQUAL(LatencyHistogram::kBucketCount - 1, LatencyHistogram::bucketIndex(0xffffffffu));
+}
+
+void test_histogram_percentiles() {
+    static LatencyHistogram hist;
+    hist.reset();
+    for (uint32_t i = 0; i < 990; i++) {
+        hist.record(100);
+    }
+    for (uint32_t i = 0; i < 10; i++) {
+        hist.record(50000);
+    }
+
+    static LatencyHistogram::Snapshot snap;
+    hist.snapshot(snap);
+    TEST_ASSERT_EQUAL(1000, snap.total);
+
+    // Bucket upper bounds overestimate by at most 25% with 2 sub-bucket bits
+    TEST_ASSERT_GREATER_OR_EQUAL(100, snap.percentile(0.50));
+    TEST_ASSERT_LESS_OR_EQUAL(125, snap.percentile(0.50));
+    TEST_ASSERT_LESS_OR_EQUAL(125, snap.percentile(0.99));
+    TEST_ASSERT_GREATER_OR_EQUAL(50000, snap.percentile(0.999));
+    TEST_ASSERT_LESS_OR_EQUAL(62500, snap.percentile(0.999));
+}
+
+void test_stats_percentiles_from_guards() {
+    for (int i = 0; i < 20; i++) {
+        MutexGuard guard(testMutex);
+    }
+    {
+        MutexGuard guard(testMutex);
+        delay(20);
+    }
+
+    MutexPercentiles wait;
+    MutexPercentiles hold;
+    TEST_ASSERT_TRUE(MutexGuardStats::percentiles(testMutex, wait, hold));
+    TEST_ASSERT_EQUAL(21, wait.samples);
+    TEST_ASSERT_EQUAL(21, hold.samples);
+    TEST_ASSERT_LESS_THAN(15000, hold.p50Us);
+    TEST_ASSERT_GREATER_OR_EQUAL(15000, hold.p999Us);
+
+    static MutexHistogramSnapshot histograms;
+    TEST_ASSERT_TRUE(MutexGuardStats::histograms(testMutex, histograms));
+    TEST_ASSERT_EQUAL(21, histograms.holdUs.total);
+
+    MutexGuardStats::reset(testMutex);
+    TEST_ASSERT_TRUE(MutexGuardStats::percentiles(testMutex, wait, hold));
+    TEST_ASSERT_EQUAL(0, hold.samples);
+}
+#endif // MUTEXGUARD_STATS_HISTOGRAM
+
+void runMutexGuardStatsTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_stats_unknown_handle);
+    RUN_TEST(test_stats_counts_acquisitions);
+    RUN_TEST(test_stats_hold_time);
+    RUN_TEST(test_stats_failed_acquisition_wait_time);
+    RUN_TEST(test_stats_recursive_guard);
+    RUN_TEST(test_stats_reset);
+    RUN_TEST(test_stats_snapshot_all);
+    RUN_TEST(test_stats_table_full);
+#ifdef MUTEXGUARD_STATS_HISTOGRAM
+    RUN_TEST(test_histogram_bucket_layout);
+    RUN_TEST(test_histogram_percentiles);
+    RUN_TEST(test_stats_percentiles_from_guards);
+#endif
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== MutexGuard Statistics Tests ===\n");
+    runMutexGuardStatsTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST && (MUTEXGUARD_STATS || MUTEXGUARD_STATS_HISTOGRAM)
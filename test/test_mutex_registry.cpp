@@ -0,0 +1,173 @@
+/**
+ * @file test_mutex_registry.cpp
+ * @brief Unit tests for the MutexRegistry name lookup
+ */
+
+#ifdef UNIT_TEST
+
+#include <Arduino.h>
+#include <unity.h>
+#include <string.h>
+#include <MutexGuard.h>
+#include <MutexRegistry.h>
+
+static SemaphoreHandle_t testMutex = nullptr;
+
+void setUp() {
+    MutexRegistry::clear();
+    testMutex = xSemaphoreCreateMutex();
+}
+
+void tearDown() {
+    vSemaphoreDelete(testMutex);
+    testMutex = nullptr;
+}
+
+void test_registry_register_and_lookup() {
+    TEST_ASSERT_TRUE(MutexRegistry::registerMutex(testMutex, "i2c_bus", "sensors", 500));
+    TEST_ASSERT_EQUAL(1, MutexRegistry::size());
+
+    MutexInfo info;
+    TEST_ASSERT_TRUE(MutexRegistry::lookup(testMutex, info));
+    TEST_ASSERT_EQUAL_PTR(testMutex, info.handle);
+    TEST_ASSERT_EQUAL_STRING("i2c_bus", info.name);
+    TEST_ASSERT_EQUAL_STRING("sensors", info.module);
+    TEST_ASSERT_EQUAL(500, info.maxHoldUs);
+    TEST_ASSERT_EQUAL_STRING("i2c_bus", MutexRegistry::nameOf(testMutex));
+    TEST_ASSERT_EQUAL_STRING("i2c_bus", MutexRegistry::displayName(testMutex));
+}
+
+void test_registry_rejects_null() {
+    TEST_ASSERT_FALSE(MutexRegistry::registerMutex(nullptr, "null"));
+    TEST_ASSERT_NULL(MutexRegistry::nameOf(nullptr));
+    TEST_ASSERT_EQUAL(0, MutexRegistry::size());
+}
+
+void test_registry_unknown_handle_shows_address() {
+    MutexInfo info;
+    TEST_ASSERT_FALSE(MutexRegistry::lookup(testMutex, info));
+    TEST_ASSERT_NULL(MutexRegistry::nameOf(testMutex));
+
+    char expected[32];
+    snprintf(expected, sizeof(expected), "%p", (void*)testMutex);
+    TEST_ASSERT_EQUAL_STRING(expected, MutexRegistry::displayName(testMutex));
+}
+
+void test_registry_reregister_updates() {
+    TEST_ASSERT_TRUE(MutexRegistry::registerMutex(testMutex, "old"));
+    TEST_ASSERT_TRUE(MutexRegistry::registerMutex(testMutex, "new", nullptr, 42));
+    TEST_ASSERT_EQUAL(1, MutexRegistry::size());
+
+    MutexInfo info;
+    TEST_ASSERT_TRUE(MutexRegistry::lookup(testMutex, info));
+    TEST_ASSERT_EQUAL_STRING("new", info.name);
+    TEST_ASSERT_NULL(info.module);
+    TEST_ASSERT_EQUAL(42, info.maxHoldUs);
+}
+
+void test_registry_unregister() {
+    SemaphoreHandle_t others[8];
+    for (int i = 0; i < 8; i++) {
+        others[i] = xSemaphoreCreateMutex();
+        TEST_ASSERT_TRUE(MutexRegistry::registerMutex(others[i], "other"));
+    }
+    TEST_ASSERT_TRUE(MutexRegistry::registerMutex(testMutex, "victim"));
+
+    TEST_ASSERT_TRUE(MutexRegistry::unregisterMutex(testMutex));
+    TEST_ASSERT_FALSE(MutexRegistry::unregisterMutex(testMutex));
+    TEST_ASSERT_NULL(MutexRegistry::nameOf(testMutex));
+    TEST_ASSERT_EQUAL(8, MutexRegistry::size());
+
+    // Entries probed past the removed one are still found
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL_STRING("other", MutexRegistry::nameOf(others[i]));
+        vSemaphoreDelete(others[i]);
+    }
+}
+
+void test_registry_full() {
+    SemaphoreHandle_t extra[MUTEXGUARD_REGISTRY_CAPACITY];
+    for (int i = 0; i < MUTEXGUARD_REGISTRY_CAPACITY; i++) {
+        extra[i] = xSemaphoreCreateMutex();
+        TEST_ASSERT_TRUE(MutexRegistry::registerMutex(extra[i], "extra"));
+    }
+    TEST_ASSERT_FALSE(MutexRegistry::registerMutex(testMutex, "overflow"));
+    TEST_ASSERT_NULL(MutexRegistry::nameOf(testMutex));
+
+    // Removing one entry frees its slot for reuse
+    TEST_ASSERT_TRUE(MutexRegistry::unregisterMutex(extra[0]));
+    TEST_ASSERT_TRUE(MutexRegistry::registerMutex(testMutex, "reused"));
+    TEST_ASSERT_EQUAL_STRING("reused", MutexRegistry::nameOf(testMutex));
+
+    for (int i = 0; i < MUTEXGUARD_REGISTRY_CAPACITY; i++) {
+        vSemaphoreDelete(extra[i]);
+    }
+}
+
+void test_registry_churn() {
+    // The registry only uses handles as keys, so fake ones collide freely
+    static uint64_t keys[3 * MUTEXGUARD_REGISTRY_CAPACITY];
+    const int live = MUTEXGUARD_REGISTRY_CAPACITY - 2;
+    bool registered[3 * MUTEXGUARD_REGISTRY_CAPACITY] = {};
+    uint32_t random = 12345;
+
+    for (int round = 0; round < 2000; round++) {
+        random = random * 1103515245u + 12345u;
+        int index = (int)((random >> 8) % (3 * MUTEXGUARD_REGISTRY_CAPACITY));
+        SemaphoreHandle_t handle = reinterpret_cast<SemaphoreHandle_t>(&keys[index]);
+        if (registered[index]) {
+            TEST_ASSERT_TRUE(MutexRegistry::unregisterMutex(handle));
+            registered[index] = false;
+        } else if (MutexRegistry::size() < (size_t)live) {
+            TEST_ASSERT_TRUE(MutexRegistry::registerMutex(handle, "churn", nullptr, (uint32_t)index));
+            registered[index] = true;
+        }
+
+        // Every live entry is found with its own metadata, every removed one misses
+        for (int i = 0; i < 3 * MUTEXGUARD_REGISTRY_CAPACITY; i++) {
+            MutexInfo info;
+            bool found = MutexRegistry::lookup(reinterpret_cast<SemaphoreHandle_t>(&keys[i]), info);
+            TEST_ASSERT_EQUAL(registered[i], found);
+            if (found) {
+                TEST_ASSERT_EQUAL(i, (int)info.maxHoldUs);
+            }
+        }
+    }
+}
+
+void test_registry_guard_logs_name() {
+    // Exercises the named debug log path; the guard must behave as usual
+    MutexRegistry::registerMutex(testMutex, "logged");
+    {
+        MutexGuard guard(testMutex);
+        TEST_ASSERT_TRUE(guard.hasLock());
+    }
+    MutexGuard guard(testMutex, 0);
+    TEST_ASSERT_TRUE(guard.hasLock());
+}
+
+void runMutexRegistryTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_registry_register_and_lookup);
+    RUN_TEST(test_registry_rejects_null);
+    RUN_TEST(test_registry_unknown_handle_shows_address);
+    RUN_TEST(test_registry_reregister_updates);
+    RUN_TEST(test_registry_unregister);
+    RUN_TEST(test_registry_full);
+    RUN_TEST(test_registry_churn);
+    RUN_TEST(test_registry_guard_logs_name);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== MutexRegistry Tests ===\n");
+    runMutexRegistryTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST
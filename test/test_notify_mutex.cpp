@@ -0,0 +1,248 @@
+/**
+ * @file test_notify_mutex.cpp
+ * @brief Unit tests for NotifyMutex and NotifyMutexGuard
+ */
+
+#ifdef UNIT_TEST
+
+#include <Arduino.h>
+#include <unity.h>
+#include <NotifyMutex.h>
+
+#define NOTIFY_TEST_TASKS 4
+#define NOTIFY_TEST_ITERATIONS 5000
+
+static NotifyMutex* testMutex = nullptr;
+
+void setUp() {
+    testMutex = new NotifyMutex();
+}
+
+void tearDown() {
+    delete testMutex;
+    testMutex = nullptr;
+}
+
+void test_notify_guard_acquires_lock() {
+    TEST_ASSERT_FALSE(testMutex->isLocked());
+    {
+        NotifyMutexGuard guard(*testMutex);
+        TEST_ASSERT_TRUE(guard.hasLock());
+        TEST_ASSERT_TRUE(guard.isValid());
+        TEST_ASSERT_TRUE(testMutex->isLocked());
+        TEST_ASSERT_FALSE(testMutex->tryLock());
+    }
+    // Released on destruction
+    TEST_ASSERT_FALSE(testMutex->isLocked());
+    TEST_ASSERT_TRUE(testMutex->tryLock());
+    testMutex->unlock();
+}
+
+void test_notify_guard_unlock() {
+    NotifyMutexGuard guard(*testMutex);
+    guard.unlock();
+    TEST_ASSERT_FALSE(guard.hasLock());
+    guard.unlock();  // Second unlock is a no-op
+    TEST_ASSERT_TRUE(testMutex->tryLock());
+    testMutex->unlock();
+}
+
+void test_notify_guard_timeout() {
+    TEST_ASSERT_TRUE(testMutex->lock());
+
+    NotifyMutexGuard immediate(*testMutex, 0);
+    TEST_ASSERT_FALSE(immediate.hasLock());
+
+    uint32_t start = millis();
+    NotifyMutexGuard timed(*testMutex, pdMS_TO_TICKS(20));
+    TEST_ASSERT_FALSE(timed.hasLock());
+    TEST_ASSERT_GREATER_OR_EQUAL(15, millis() - start);
+
+    // The timed-out waiter left the wait list, so this unlock is the fast one
+    testMutex->unlock();
+    TEST_ASSERT_FALSE(testMutex->isLocked());
+    NotifyMutexGuard after(*testMutex, 0);
+    TEST_ASSERT_TRUE(after.hasLock());
+}
+
+static SemaphoreHandle_t waiterLocked = nullptr;
+static SemaphoreHandle_t waiterRelease = nullptr;
+static volatile uint32_t leftoverNotifications = 0;
+
+static void holdingWaiterTask(void* param) {
+    (void)param;
+    NotifyMutexGuard guard(*testMutex, portMAX_DELAY);
+    // The hand-over wake-up was consumed, nothing is left pending
+    leftoverNotifications = ulTaskNotifyTake(pdTRUE, 0);
+    xSemaphoreGive(waiterLocked);
+    xSemaphoreTake(waiterRelease, portMAX_DELAY);
+    guard.unlock();
+    xSemaphoreGive(waiterLocked);
+    vTaskDelete(NULL);
+}
+
+void test_notify_unlock_hands_over_to_waiter() {
+    leftoverNotifications = 1;
+    waiterLocked = xSemaphoreCreateCounting(2, 0);
+    waiterRelease = xSemaphoreCreateBinary();
+    TEST_ASSERT_TRUE(testMutex->lock());
+
+    xTaskCreate(holdingWaiterTask, "Waiter", 2048, NULL, 1, NULL);
+    delay(50);
+    TEST_ASSERT_TRUE(xSemaphoreTake(waiterLocked, 0) == pdFALSE);
+
+    // Ownership passes straight to the waiter: the mutex is never free
+    testMutex->unlock();
+    TEST_ASSERT_FALSE(testMutex->tryLock());
+    TEST_ASSERT_TRUE(xSemaphoreTake(waiterLocked, pdMS_TO_TICKS(1000)) == pdTRUE);
+    TEST_ASSERT_EQUAL_UINT32(0, leftoverNotifications);
+    TEST_ASSERT_FALSE(testMutex->tryLock());
+
+    xSemaphoreGive(waiterRelease);
+    TEST_ASSERT_TRUE(xSemaphoreTake(waiterLocked, pdMS_TO_TICKS(1000)) == pdTRUE);
+    TEST_ASSERT_TRUE(testMutex->tryLock());
+    testMutex->unlock();
+
+    vSemaphoreDelete(waiterLocked);
+    vSemaphoreDelete(waiterRelease);
+}
+
+static SemaphoreHandle_t orderDone = nullptr;
+static volatile int acquireOrder[2];
+static volatile int acquireCount = 0;
+
+static void orderedWaiterTask(void* param) {
+    NotifyMutexGuard guard(*testMutex, portMAX_DELAY);
+    acquireOrder[acquireCount++] = (int)(intptr_t)param;
+    guard.unlock();
+    xSemaphoreGive(orderDone);
+    vTaskDelete(NULL);
+}
+
+void test_notify_waiters_served_by_priority() {
+    acquireCount = 0;
+    orderDone = xSemaphoreCreateCounting(2, 0);
+    TEST_ASSERT_TRUE(testMutex->lock());
+
+    // The low-priority task queues first, but the high-priority one goes first
+    xTaskCreate(orderedWaiterTask, "Low", 2048, (void*)(intptr_t)1, 1, NULL);
+    delay(50);
+    xTaskCreate(orderedWaiterTask, "High", 2048, (void*)(intptr_t)2, 2, NULL);
+    delay(50);
+
+    testMutex->unlock();
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(orderDone, pdMS_TO_TICKS(1000)) == pdTRUE);
+    }
+    TEST_ASSERT_EQUAL(2, acquireCount);
+    TEST_ASSERT_EQUAL(2, acquireOrder[0]);
+    TEST_ASSERT_EQUAL(1, acquireOrder[1]);
+    TEST_ASSERT_FALSE(testMutex->isLocked());
+    vSemaphoreDelete(orderDone);
+}
+
+static SemaphoreHandle_t waiterDone = nullptr;
+static volatile bool waiterGotLock = false;
+
+static void blockingWaiterTask(void* param) {
+    (void)param;
+    NotifyMutexGuard guard(*testMutex, portMAX_DELAY);
+    waiterGotLock = guard.hasLock();
+    guard.unlock();
+    xSemaphoreGive(waiterDone);
+    vTaskDelete(NULL);
+}
+
+static SemaphoreHandle_t timedDone = nullptr;
+static volatile bool timedGotLock = true;
+
+static void timedWaiterTask(void* param) {
+    (void)param;
+    NotifyMutexGuard guard(*testMutex, pdMS_TO_TICKS(20));
+    timedGotLock = guard.hasLock();
+    guard.unlock();
+    xSemaphoreGive(timedDone);
+    vTaskDelete(NULL);
+}
+
+void test_notify_timed_out_waiter_leaves_others_queued() {
+    timedGotLock = true;
+    waiterGotLock = false;
+    waiterDone = xSemaphoreCreateBinary();
+    timedDone = xSemaphoreCreateBinary();
+    TEST_ASSERT_TRUE(testMutex->lock());
+
+    xTaskCreate(blockingWaiterTask, "Waiter", 2048, NULL, 1, NULL);
+    xTaskCreate(timedWaiterTask, "Timed", 2048, NULL, 1, NULL);
+    TEST_ASSERT_TRUE(xSemaphoreTake(timedDone, pdMS_TO_TICKS(1000)) == pdTRUE);
+    TEST_ASSERT_FALSE(timedGotLock);
+
+    testMutex->unlock();
+    TEST_ASSERT_TRUE(xSemaphoreTake(waiterDone, pdMS_TO_TICKS(1000)) == pdTRUE);
+    TEST_ASSERT_TRUE(waiterGotLock);
+    TEST_ASSERT_FALSE(testMutex->isLocked());
+
+    vSemaphoreDelete(waiterDone);
+    vSemaphoreDelete(timedDone);
+}
+
+static volatile uint32_t notifyCounter = 0;
+static SemaphoreHandle_t incrementDone = nullptr;
+
+static void notifyIncrementTask(void* param) {
+    (void)param;
+    for (int i = 0; i < NOTIFY_TEST_ITERATIONS; i++) {
+        NotifyMutexGuard guard(*testMutex, portMAX_DELAY);
+        if (guard) {
+            uint32_t value = notifyCounter;
+            if ((i & 0xff) == 0) {
+                taskYIELD();  // Let the others queue up behind the lock
+            }
+            notifyCounter = value + 1;
+        }
+    }
+    xSemaphoreGive(incrementDone);
+    vTaskDelete(NULL);
+}
+
+void test_notify_mutual_exclusion() {
+    notifyCounter = 0;
+    incrementDone = xSemaphoreCreateCounting(NOTIFY_TEST_TASKS, 0);
+
+    for (int i = 0; i < NOTIFY_TEST_TASKS; i++) {
+        xTaskCreatePinnedToCore(notifyIncrementTask, "Notify", 2048, NULL, 1, NULL,
+                                i % portNUM_PROCESSORS);
+    }
+    for (int i = 0; i < NOTIFY_TEST_TASKS; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(incrementDone, pdMS_TO_TICKS(10000)) == pdTRUE);
+    }
+
+    TEST_ASSERT_EQUAL(NOTIFY_TEST_TASKS * NOTIFY_TEST_ITERATIONS, notifyCounter);
+    TEST_ASSERT_FALSE(testMutex->isLocked());
+    vSemaphoreDelete(incrementDone);
+}
+
+void runNotifyMutexTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_notify_guard_acquires_lock);
+    RUN_TEST(test_notify_guard_unlock);
+    RUN_TEST(test_notify_guard_timeout);
+    RUN_TEST(test_notify_unlock_hands_over_to_waiter);
+    RUN_TEST(test_notify_waiters_served_by_priority);
+    RUN_TEST(test_notify_timed_out_waiter_leaves_others_queued);
+    RUN_TEST(test_notify_mutual_exclusion);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== NotifyMutex Tests ===\n");
+    runNotifyMutexTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST
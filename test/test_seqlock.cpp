@@ -0,0 +1,140 @@
+/**
+ * @file test_seqlock.cpp
+ * @brief Unit tests for SeqLocked<T>
+ */
+
+#ifdef UNIT_TEST
+
+#include <Arduino.h>
+#include <unity.h>
+#include <SeqLock.h>
+
+#define SEQLOCK_TEST_READERS 3
+#define SEQLOCK_TEST_READS 20000
+
+// Every field derives from `counter`, so a torn copy is detectable
+struct Snapshot {
+    uint32_t counter;
+    uint32_t inverted;
+    uint32_t tripled;
+    uint8_t tail;  // Odd size exercises the partial last word
+};
+
+static Snapshot makeSnapshot(uint32_t counter) {
+    Snapshot s;
+    s.counter = counter;
+    s.inverted = ~counter;
+    s.tripled = counter * 3;
+    s.tail = (uint8_t)counter;
+    return s;
+}
+
+static bool isConsistent(const Snapshot& s) {
+    return s.inverted == ~s.counter && s.tripled == s.counter * 3 && s.tail == (uint8_t)s.counter;
+}
+
+void test_seqlock_initial_value() {
+    SeqLocked<Snapshot> zero;
+    TEST_ASSERT_EQUAL(0, zero.read().counter);
+
+    SeqLocked<Snapshot> initial(makeSnapshot(7));
+    TEST_ASSERT_EQUAL(7, initial.read().counter);
+    TEST_ASSERT_EQUAL(0, initial.sequence());
+}
+
+void test_seqlock_write_and_read() {
+    SeqLocked<Snapshot> value;
+    value.write(makeSnapshot(42));
+    Snapshot out = value.read();
+    TEST_ASSERT_EQUAL(42, out.counter);
+    TEST_ASSERT_TRUE(isConsistent(out));
+    TEST_ASSERT_EQUAL(2, value.sequence());
+
+    Snapshot tried = {};
+    TEST_ASSERT_TRUE(value.tryRead(tried));
+    TEST_ASSERT_EQUAL(42, tried.counter);
+}
+
+void test_seqlock_update() {
+    SeqLocked<Snapshot> value(makeSnapshot(1));
+    value.update([](Snapshot& s) { s = makeSnapshot(s.counter + 1); });
+    TEST_ASSERT_EQUAL(2, value.read().counter);
+    TEST_ASSERT_EQUAL(2, value.sequence());
+}
+
+static SeqLocked<Snapshot>* shared = nullptr;
+static std::atomic<bool> writerStop(false);
+static volatile uint32_t tornReads = 0;
+static SemaphoreHandle_t tasksDone = nullptr;
+
+static void seqWriterTask(void* param) {
+    (void)param;
+    uint32_t counter = 0;
+    while (!writerStop.load()) {
+        shared->write(makeSnapshot(++counter));
+        if ((counter & 0xff) == 0) {
+            taskYIELD();
+        }
+    }
+    xSemaphoreGive(tasksDone);
+    vTaskDelete(NULL);
+}
+
+static void seqReaderTask(void* param) {
+    (void)param;
+    uint32_t last = 0;
+    for (int i = 0; i < SEQLOCK_TEST_READS; i++) {
+        Snapshot s = shared->read();
+        if (!isConsistent(s) || s.counter < last) {
+            tornReads = tornReads + 1;
+        }
+        last = s.counter;
+    }
+    xSemaphoreGive(tasksDone);
+    vTaskDelete(NULL);
+}
+
+void test_seqlock_concurrent_readers_see_consistent_values() {
+    shared = new SeqLocked<Snapshot>();
+    writerStop.store(false);
+    tornReads = 0;
+    tasksDone = xSemaphoreCreateCounting(SEQLOCK_TEST_READERS + 1, 0);
+
+    xTaskCreatePinnedToCore(seqWriterTask, "SeqW", 2048, NULL, 1, NULL, 0);
+    for (int i = 0; i < SEQLOCK_TEST_READERS; i++) {
+        xTaskCreatePinnedToCore(seqReaderTask, "SeqR", 2048, NULL, 1, NULL,
+                                (i + 1) % portNUM_PROCESSORS);
+    }
+    for (int i = 0; i < SEQLOCK_TEST_READERS; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(tasksDone, pdMS_TO_TICKS(20000)) == pdTRUE);
+    }
+    writerStop.store(true);
+    TEST_ASSERT_TRUE(xSemaphoreTake(tasksDone, pdMS_TO_TICKS(1000)) == pdTRUE);
+
+    TEST_ASSERT_EQUAL(0, tornReads);
+    TEST_ASSERT_GREATER_THAN(0, shared->read().counter);
+    vSemaphoreDelete(tasksDone);
+    delete shared;
+}
+
+void runSeqLockTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_seqlock_initial_value);
+    RUN_TEST(test_seqlock_write_and_read);
+    RUN_TEST(test_seqlock_update);
+    RUN_TEST(test_seqlock_concurrent_readers_see_consistent_values);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== SeqLocked Tests ===\n");
+    runSeqLockTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST
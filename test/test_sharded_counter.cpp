@@ -0,0 +1,126 @@
+/**
+ * @file test_sharded_counter.cpp
+ * @brief Unit tests for ShardedCounter
+ */
+
+#ifdef UNIT_TEST
+
+#include <Arduino.h>
+#include <unity.h>
+#include <ShardedCounter.h>
+
+#define COUNTER_TEST_TASKS 4
+#define COUNTER_TEST_ITERATIONS 20000
+
+static ShardedCounter<int32_t> counter;
+static ShardedCounter<uint32_t, COUNTER_TEST_TASKS> perTask;
+static SemaphoreHandle_t startSemaphore = nullptr;
+static SemaphoreHandle_t doneSemaphore = nullptr;
+
+void setUp() {
+    counter.reset();
+    perTask.reset();
+}
+
+void tearDown() {}
+
+void test_sharded_counter_starts_at_zero() {
+    ShardedCounter<uint16_t, 3> local;
+    TEST_ASSERT_EQUAL(0, local.value());
+    TEST_ASSERT_EQUAL(3, (int)local.shards());
+}
+
+void test_sharded_counter_add_and_decrement() {
+    counter.increment();
+    counter.add(10);
+    counter.decrement();
+    counter.add(-3);
+    TEST_ASSERT_EQUAL(7, counter.value());
+}
+
+void test_sharded_counter_add_to_shard() {
+    perTask.addTo(0, 5);
+    perTask.addTo(COUNTER_TEST_TASKS - 1, 7);
+    perTask.addTo(COUNTER_TEST_TASKS + 1, 1);  // Wraps to shard 1
+    TEST_ASSERT_EQUAL_UINT32(13, perTask.value());
+}
+
+void test_sharded_counter_reset() {
+    counter.add(42);
+    TEST_ASSERT_EQUAL(42, counter.reset());
+    TEST_ASSERT_EQUAL(0, counter.value());
+    counter.add(-1);
+    TEST_ASSERT_EQUAL(-1, counter.reset());
+}
+
+void test_sharded_counter_slots_padded() {
+    // Every slot owns a whole cache line
+    TEST_ASSERT_TRUE(sizeof(ShardedCounter<int32_t, 2>) >= 2 * MUTEXGUARD_CACHE_LINE_SIZE);
+    TEST_ASSERT_EQUAL(0, (int)((uintptr_t)&counter % MUTEXGUARD_CACHE_LINE_SIZE));
+}
+
+static void incrementTask(void* param) {
+    size_t index = (size_t)(intptr_t)param;
+    xSemaphoreTake(startSemaphore, portMAX_DELAY);
+    for (int i = 0; i < COUNTER_TEST_ITERATIONS; i++) {
+        counter.increment();
+        perTask.addTo(index, 1);
+    }
+    xSemaphoreGive(doneSemaphore);
+    vTaskDelete(NULL);
+}
+
+void test_sharded_counter_concurrent_increment() {
+    startSemaphore = xSemaphoreCreateCounting(COUNTER_TEST_TASKS, 0);
+    doneSemaphore = xSemaphoreCreateCounting(COUNTER_TEST_TASKS, 0);
+
+    for (int i = 0; i < COUNTER_TEST_TASKS; i++) {
+        xTaskCreatePinnedToCore(incrementTask, "Count", 2048, (void*)(intptr_t)i, 1, NULL,
+                                i % portNUM_PROCESSORS);
+    }
+    for (int i = 0; i < COUNTER_TEST_TASKS; i++) {
+        xSemaphoreGive(startSemaphore);
+    }
+
+    // Reads while the tasks count never exceed the final total
+    int32_t previous = 0;
+    for (int done = 0; done < COUNTER_TEST_TASKS;) {
+        int32_t current = counter.value();
+        TEST_ASSERT_TRUE(current >= previous);
+        TEST_ASSERT_TRUE(current <= COUNTER_TEST_TASKS * COUNTER_TEST_ITERATIONS);
+        previous = current;
+        if (xSemaphoreTake(doneSemaphore, pdMS_TO_TICKS(1)) == pdTRUE) {
+            done++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(COUNTER_TEST_TASKS * COUNTER_TEST_ITERATIONS, counter.value());
+    TEST_ASSERT_EQUAL_UINT32(COUNTER_TEST_TASKS * COUNTER_TEST_ITERATIONS, perTask.value());
+
+    vSemaphoreDelete(startSemaphore);
+    vSemaphoreDelete(doneSemaphore);
+}
+
+void runShardedCounterTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sharded_counter_starts_at_zero);
+    RUN_TEST(test_sharded_counter_add_and_decrement);
+    RUN_TEST(test_sharded_counter_add_to_shard);
+    RUN_TEST(test_sharded_counter_reset);
+    RUN_TEST(test_sharded_counter_slots_padded);
+    RUN_TEST(test_sharded_counter_concurrent_increment);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== ShardedCounter Tests ===\n");
+    runShardedCounterTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST
@@ -0,0 +1,200 @@
+/**
+ * @file test_shared_mutex.cpp
+ * @brief Unit tests for SharedMutex, SharedGuard and ExclusiveGuard
+ */
+
+#ifdef UNIT_TEST
+
+#include <Arduino.h>
+#include <unity.h>
+#include <SharedMutex.h>
+
+#define RW_TEST_TASKS 4
+#define RW_TEST_ITERATIONS 2000
+
+static SharedMutex* testLock = nullptr;
+
+void setUp() {
+    testLock = new SharedMutex();
+}
+
+void tearDown() {
+    delete testLock;
+    testLock = nullptr;
+}
+
+void test_shared_guards_allow_concurrent_readers() {
+    SharedGuard first(*testLock);
+    SharedGuard second(*testLock, 0);
+    TEST_ASSERT_TRUE(first.hasLock());
+    TEST_ASSERT_TRUE(second.hasLock());
+    TEST_ASSERT_EQUAL(2, testLock->readerCount());
+
+    // Readers exclude writers
+    ExclusiveGuard writer(*testLock, pdMS_TO_TICKS(10));
+    TEST_ASSERT_FALSE(writer.hasLock());
+}
+
+void test_exclusive_guard_excludes_everyone() {
+    ExclusiveGuard writer(*testLock);
+    TEST_ASSERT_TRUE(writer.hasLock());
+
+    SharedGuard reader(*testLock, 0);
+    TEST_ASSERT_FALSE(reader.hasLock());
+    ExclusiveGuard other(*testLock, pdMS_TO_TICKS(10));
+    TEST_ASSERT_FALSE(other.hasLock());
+
+    writer.unlock();
+    SharedGuard after(*testLock, 0);
+    TEST_ASSERT_TRUE(after.hasLock());
+}
+
+void test_shared_guard_unlock() {
+    SharedGuard reader(*testLock);
+    reader.unlock();
+    TEST_ASSERT_FALSE(reader.hasLock());
+    reader.unlock();  // Second unlock is a no-op
+    TEST_ASSERT_EQUAL(0, testLock->readerCount());
+
+    ExclusiveGuard writer(*testLock, 0);
+    TEST_ASSERT_TRUE(writer.hasLock());
+}
+
+static SemaphoreHandle_t writerDone = nullptr;
+static volatile bool writerGotLock = false;
+
+static void waitingWriterTask(void* param) {
+    TickType_t timeout = (TickType_t)(uintptr_t)param;
+    ExclusiveGuard writer(*testLock, timeout);
+    writerGotLock = writer.hasLock();
+    writer.unlock();
+    xSemaphoreGive(writerDone);
+    vTaskDelete(NULL);
+}
+
+void test_writer_preference_blocks_new_readers() {
+    writerGotLock = false;
+    writerDone = xSemaphoreCreateBinary();
+
+    SharedGuard reader(*testLock);
+    xTaskCreate(waitingWriterTask, "Writer", 2048, (void*)(uintptr_t)portMAX_DELAY, 1, NULL);
+    delay(50);  // The writer is now queued behind the reader
+
+    SharedGuard lateReader(*testLock, 0);
+    TEST_ASSERT_FALSE(lateReader.hasLock());
+
+    // Releasing the last reader hands the lock to the writer
+    reader.unlock();
+    TEST_ASSERT_TRUE(xSemaphoreTake(writerDone, pdMS_TO_TICKS(1000)) == pdTRUE);
+    TEST_ASSERT_TRUE(writerGotLock);
+    vSemaphoreDelete(writerDone);
+}
+
+void test_reader_preference_admits_new_readers() {
+    delete testLock;
+    testLock = new SharedMutex(SharedMutex::Preference::Readers);
+    writerGotLock = false;
+    writerDone = xSemaphoreCreateBinary();
+
+    SharedGuard reader(*testLock);
+    xTaskCreate(waitingWriterTask, "Writer", 2048, (void*)(uintptr_t)portMAX_DELAY, 1, NULL);
+    delay(50);
+
+    SharedGuard lateReader(*testLock, 0);
+    TEST_ASSERT_TRUE(lateReader.hasLock());
+
+    lateReader.unlock();
+    reader.unlock();
+    TEST_ASSERT_TRUE(xSemaphoreTake(writerDone, pdMS_TO_TICKS(1000)) == pdTRUE);
+    TEST_ASSERT_TRUE(writerGotLock);
+    vSemaphoreDelete(writerDone);
+}
+
+void test_writer_timeout_releases_readers() {
+    writerGotLock = true;
+    writerDone = xSemaphoreCreateBinary();
+
+    SharedGuard reader(*testLock);
+    xTaskCreate(waitingWriterTask, "Writer", 2048, (void*)(uintptr_t)pdMS_TO_TICKS(50), 1, NULL);
+    delay(10);
+
+    // Blocked by the queued writer until it gives up
+    SharedGuard lateReader(*testLock, pdMS_TO_TICKS(1000));
+    TEST_ASSERT_TRUE(lateReader.hasLock());
+    TEST_ASSERT_TRUE(xSemaphoreTake(writerDone, pdMS_TO_TICKS(1000)) == pdTRUE);
+    TEST_ASSERT_FALSE(writerGotLock);
+    vSemaphoreDelete(writerDone);
+}
+
+// Writers keep both halves equal; a reader seeing them differ means a
+// reader overlapped a writer.
+static volatile uint32_t pairA = 0;
+static volatile uint32_t pairB = 0;
+static volatile uint32_t tornReads = 0;
+static SemaphoreHandle_t stressDone = nullptr;
+
+static void mixedStressTask(void* param) {
+    uint32_t id = (uint32_t)(uintptr_t)param;
+    for (uint32_t i = 0; i < RW_TEST_ITERATIONS; i++) {
+        if ((i + id) % 8 == 0) {
+            ExclusiveGuard writer(*testLock, portMAX_DELAY);
+            pairA = pairA + 1;
+            taskYIELD();
+            pairB = pairB + 1;
+        } else {
+            SharedGuard reader(*testLock, portMAX_DELAY);
+            uint32_t a = pairA;
+            taskYIELD();
+            if (a != pairB) {
+                tornReads = tornReads + 1;
+            }
+        }
+    }
+    xSemaphoreGive(stressDone);
+    vTaskDelete(NULL);
+}
+
+void test_shared_mutex_stress() {
+    pairA = 0;
+    pairB = 0;
+    tornReads = 0;
+    stressDone = xSemaphoreCreateCounting(RW_TEST_TASKS, 0);
+
+    for (int i = 0; i < RW_TEST_TASKS; i++) {
+        xTaskCreatePinnedToCore(mixedStressTask, "RW", 2048, (void*)(uintptr_t)i, 1, NULL,
+                                i % portNUM_PROCESSORS);
+    }
+    for (int i = 0; i < RW_TEST_TASKS; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(stressDone, pdMS_TO_TICKS(20000)) == pdTRUE);
+    }
+
+    TEST_ASSERT_EQUAL(0, tornReads);
+    TEST_ASSERT_EQUAL(RW_TEST_TASKS * RW_TEST_ITERATIONS / 8, pairA);
+    TEST_ASSERT_EQUAL(0, testLock->readerCount());
+    vSemaphoreDelete(stressDone);
+}
+
+void runSharedMutexTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_shared_guards_allow_concurrent_readers);
+    RUN_TEST(test_exclusive_guard_excludes_everyone);
+    RUN_TEST(test_shared_guard_unlock);
+    RUN_TEST(test_writer_preference_blocks_new_readers);
+    RUN_TEST(test_reader_preference_admits_new_readers);
+    RUN_TEST(test_writer_timeout_releases_readers);
+    RUN_TEST(test_shared_mutex_stress);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== SharedMutex Tests ===\n");
+    runSharedMutexTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST
@@ -0,0 +1,109 @@
+/**
+ * @file test_spinlock_guard.cpp
+ * @brief Unit tests for SpinlockGuard and SpinlockGuardISR
+ */
+
+#ifdef UNIT_TEST
+
+#include <Arduino.h>
+#include <unity.h>
+#include <SpinlockGuard.h>
+
+#define SPIN_TEST_TASKS 2
+#define SPIN_TEST_ITERATIONS 20000
+
+static portMUX_TYPE testLock = portMUX_INITIALIZER_UNLOCKED;
+
+void test_spinlock_guard_acquires_lock() {
+    SpinlockGuard guard(&testLock);
+    TEST_ASSERT_TRUE(guard.hasLock());
+    TEST_ASSERT_TRUE(guard.isValid());
+    TEST_ASSERT_TRUE(static_cast<bool>(guard));
+}
+
+void test_spinlock_guard_null() {
+    SpinlockGuard guard(nullptr);
+    TEST_ASSERT_FALSE(guard.hasLock());
+    TEST_ASSERT_FALSE(guard.isValid());
+
+    SpinlockGuardISR isrGuard(nullptr);
+    TEST_ASSERT_FALSE(isrGuard.hasLock());
+    TEST_ASSERT_FALSE(isrGuard.isValid());
+}
+
+void test_spinlock_guard_unlock() {
+    SpinlockGuard guard(&testLock);
+    guard.unlock();
+    TEST_ASSERT_FALSE(guard.hasLock());
+    guard.unlock();  // Second unlock is a no-op
+    TEST_ASSERT_FALSE(guard.hasLock());
+
+    // The lock is free again
+    SpinlockGuard again(&testLock);
+    TEST_ASSERT_TRUE(again.hasLock());
+}
+
+void test_spinlock_guard_isr_variant_from_task() {
+    SpinlockGuardISR guard(&testLock);
+    TEST_ASSERT_TRUE(guard.hasLock());
+    guard.unlock();
+    TEST_ASSERT_FALSE(guard.hasLock());
+}
+
+static volatile uint32_t spinCounter = 0;
+static SemaphoreHandle_t spinDone = nullptr;
+
+static void spinIncrementTask(void* param) {
+    bool useIsrVariant = param != nullptr;
+    for (int i = 0; i < SPIN_TEST_ITERATIONS; i++) {
+        if (useIsrVariant) {
+            SpinlockGuardISR guard(&testLock);
+            spinCounter = spinCounter + 1;
+        } else {
+            SpinlockGuard guard(&testLock);
+            spinCounter = spinCounter + 1;
+        }
+    }
+    xSemaphoreGive(spinDone);
+    vTaskDelete(NULL);
+}
+
+void test_spinlock_guard_mutual_exclusion() {
+    spinCounter = 0;
+    spinDone = xSemaphoreCreateCounting(SPIN_TEST_TASKS, 0);
+
+    // One task per core, mixing both guard types on the same lock
+    for (int i = 0; i < SPIN_TEST_TASKS; i++) {
+        xTaskCreatePinnedToCore(spinIncrementTask, "Spin", 2048, (void*)(intptr_t)(i & 1), 1, NULL,
+                                i % portNUM_PROCESSORS);
+    }
+    for (int i = 0; i < SPIN_TEST_TASKS; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(spinDone, pdMS_TO_TICKS(10000)) == pdTRUE);
+    }
+
+    TEST_ASSERT_EQUAL(SPIN_TEST_TASKS * SPIN_TEST_ITERATIONS, spinCounter);
+    vSemaphoreDelete(spinDone);
+}
+
+void runSpinlockGuardTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_spinlock_guard_acquires_lock);
+    RUN_TEST(test_spinlock_guard_null);
+    RUN_TEST(test_spinlock_guard_unlock);
+    RUN_TEST(test_spinlock_guard_isr_variant_from_task);
+    RUN_TEST(test_spinlock_guard_mutual_exclusion);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== SpinlockGuard Tests ===\n");
+    runSpinlockGuardTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST
@@ -0,0 +1,172 @@
+/**
+ * @file test_spsc_ring.cpp
+ * @brief Unit tests for SpscRing and BlockingSpscRing
+ */
+
+#ifdef UNIT_TEST
+
+#include <Arduino.h>
+#include <unity.h>
+#include <SpscRing.h>
+
+#define SPSC_TEST_ITEMS 20000
+
+static SpscRing<uint32_t, 8> smallRing;
+static SpscRing<uint32_t, 64> streamRing;
+static BlockingSpscRing<uint32_t, 4> blockingRing;
+static BlockingSpscRing<uint32_t, 16> batchRing;
+
+static SemaphoreHandle_t producerDone = nullptr;
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_spsc_ring_fifo_and_bounds() {
+    uint32_t value = 0;
+    TEST_ASSERT_TRUE(smallRing.empty());
+    TEST_ASSERT_FALSE(smallRing.pop(value));
+
+    // Several laps so the free-running indices wrap around the slots
+    for (uint32_t lap = 0; lap < 3; lap++) {
+        for (uint32_t i = 0; i < smallRing.capacity(); i++) {
+            TEST_ASSERT_TRUE(smallRing.push(lap * 100 + i));
+        }
+        TEST_ASSERT_FALSE(smallRing.push(999));
+        TEST_ASSERT_EQUAL_UINT32(8, smallRing.size());
+
+        for (uint32_t i = 0; i < smallRing.capacity(); i++) {
+            TEST_ASSERT_TRUE(smallRing.pop(value));
+            TEST_ASSERT_EQUAL_UINT32(lap * 100 + i, value);
+        }
+        TEST_ASSERT_FALSE(smallRing.pop(value));
+    }
+}
+
+void test_spsc_ring_bulk_transfers_are_partial_at_the_edges() {
+    uint32_t items[12];
+    for (uint32_t i = 0; i < 12; i++) {
+        items[i] = i;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(5, smallRing.pushN(items, 5));
+    uint32_t out[12] = {};
+    TEST_ASSERT_EQUAL_UINT32(3, smallRing.popN(out, 3));
+
+    // 2 left, 6 free: the batch is cut and wraps around the end of the slots
+    TEST_ASSERT_EQUAL_UINT32(6, smallRing.pushN(items + 5, 7));
+    TEST_ASSERT_EQUAL_UINT32(0, smallRing.pushN(items, 1));
+    TEST_ASSERT_EQUAL_UINT32(8, smallRing.popN(out + 3, 12));
+    for (uint32_t i = 0; i < 11; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i, out[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, smallRing.popN(out, 12));
+}
+
+static void streamProducerTask(void* param) {
+    (void)param;
+    for (uint32_t i = 0; i < SPSC_TEST_ITEMS; i++) {
+        while (!streamRing.push(i)) {
+            taskYIELD();
+        }
+    }
+    xSemaphoreGive(producerDone);
+    vTaskDelete(NULL);
+}
+
+void test_spsc_ring_cross_task_order() {
+    producerDone = xSemaphoreCreateBinary();
+    xTaskCreatePinnedToCore(streamProducerTask, "SpscProducer", 2048, NULL, 1, NULL, 1);
+
+    uint32_t expected = 0;
+    uint32_t batch[16];
+    while (expected < SPSC_TEST_ITEMS) {
+        size_t n = streamRing.popN(batch, 16);
+        if (n == 0) {
+            taskYIELD();
+        }
+        for (size_t i = 0; i < n; i++) {
+            TEST_ASSERT_EQUAL_UINT32(expected, batch[i]);
+            expected++;
+        }
+    }
+
+    TEST_ASSERT_TRUE(xSemaphoreTake(producerDone, pdMS_TO_TICKS(5000)) == pdTRUE);
+    TEST_ASSERT_TRUE(streamRing.empty());
+    vSemaphoreDelete(producerDone);
+}
+
+void test_blocking_spsc_ring_timeouts() {
+    uint32_t value = 0;
+    TickType_t start = xTaskGetTickCount();
+    TEST_ASSERT_FALSE(blockingRing.pop(value, pdMS_TO_TICKS(20)));
+    TEST_ASSERT_TRUE(xTaskGetTickCount() - start >= pdMS_TO_TICKS(15));
+
+    for (uint32_t i = 0; i < blockingRing.capacity(); i++) {
+        TEST_ASSERT_TRUE(blockingRing.push(i, 0));
+    }
+    TEST_ASSERT_FALSE(blockingRing.push(99, pdMS_TO_TICKS(10)));
+
+    for (uint32_t i = 0; i < blockingRing.capacity(); i++) {
+        TEST_ASSERT_TRUE(blockingRing.pop(value, 0));
+        TEST_ASSERT_EQUAL_UINT32(i, value);
+    }
+}
+
+static void blockingProducerTask(void* param) {
+    (void)param;
+    uint32_t batch[5];
+    for (uint32_t i = 0; i < SPSC_TEST_ITEMS; i += 5) {
+        for (uint32_t j = 0; j < 5; j++) {
+            batch[j] = i + j;
+        }
+        // The ring holds 16, so the producer keeps sleeping on a full ring
+        size_t pushed = batchRing.pushN(batch, 5, portMAX_DELAY);
+        configASSERT(pushed == 5);
+    }
+    xSemaphoreGive(producerDone);
+    vTaskDelete(NULL);
+}
+
+void test_blocking_spsc_ring_sleeps_and_wakes() {
+    producerDone = xSemaphoreCreateBinary();
+    xTaskCreatePinnedToCore(blockingProducerTask, "SpscBlocking", 2048, NULL, 1, NULL, 1);
+
+    uint32_t expected = 0;
+    uint32_t batch[7];
+    while (expected < SPSC_TEST_ITEMS) {
+        size_t n = batchRing.popN(batch, 7, pdMS_TO_TICKS(5000));
+        TEST_ASSERT_TRUE(n > 0);
+        for (size_t i = 0; i < n; i++) {
+            TEST_ASSERT_EQUAL_UINT32(expected, batch[i]);
+            expected++;
+        }
+    }
+
+    TEST_ASSERT_TRUE(xSemaphoreTake(producerDone, pdMS_TO_TICKS(5000)) == pdTRUE);
+    TEST_ASSERT_TRUE(batchRing.empty());
+    vSemaphoreDelete(producerDone);
+}
+
+void runSpscRingTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_spsc_ring_fifo_and_bounds);
+    RUN_TEST(test_spsc_ring_bulk_transfers_are_partial_at_the_edges);
+    RUN_TEST(test_spsc_ring_cross_task_order);
+    RUN_TEST(test_blocking_spsc_ring_timeouts);
+    RUN_TEST(test_blocking_spsc_ring_sleeps_and_wakes);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== SpscRing Tests ===\n");
+    runSpscRingTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST
@@ -0,0 +1,131 @@
+/**
+ * @file test_static_mutex.cpp
+ * @brief Unit tests for StaticMutex and StaticRecursiveMutex
+ */
+
+#ifdef UNIT_TEST
+
+#include <Arduino.h>
+#include <unity.h>
+#include <StaticMutex.h>
+
+#define STATIC_TEST_TASKS 4
+
+static StaticMutex staticMutex;
+static StaticRecursiveMutex staticRecursive;
+
+// Used from a static constructor; works because staticMutex is
+// constant-initialized regardless of initialization order
+static SemaphoreHandle_t handleDuringStaticInit = nullptr;
+static struct EarlyUser {
+    EarlyUser() { handleDuringStaticInit = staticMutex.handle(); }
+} earlyUser;
+
+void setUp() {}
+
+void tearDown() {}
+
+static bool isFree(SemaphoreHandle_t handle) {
+    if (xSemaphoreTake(handle, 0) != pdTRUE) {
+        return false;
+    }
+    xSemaphoreGive(handle);
+    return true;
+}
+
+void test_static_mutex_usable_during_static_init() {
+    TEST_ASSERT_NOT_NULL(handleDuringStaticInit);
+    TEST_ASSERT_TRUE(handleDuringStaticInit == staticMutex.handle());
+}
+
+void test_static_mutex_handle_is_stable() {
+    SemaphoreHandle_t first = staticMutex.handle();
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_TRUE(first == staticMutex.handle());
+}
+
+void test_static_mutex_guard_locks_and_releases() {
+    {
+        StaticMutexGuard lock(staticMutex);
+        TEST_ASSERT_TRUE(lock.hasLock());
+        TEST_ASSERT_TRUE(lock.isValid());
+        TEST_ASSERT_FALSE(isFree(staticMutex.handle()));
+
+        StaticMutexGuard second(staticMutex, pdMS_TO_TICKS(10));
+        TEST_ASSERT_FALSE(second.hasLock());
+    }
+    TEST_ASSERT_TRUE(isFree(staticMutex.handle()));
+}
+
+void test_static_mutex_works_with_mutex_guard() {
+    MutexGuard lock(staticMutex.handle());
+    TEST_ASSERT_TRUE(lock.hasLock());
+}
+
+void test_static_recursive_mutex_nests() {
+    StaticRecursiveMutexGuard outer(staticRecursive);
+    TEST_ASSERT_TRUE(outer.hasLock());
+    {
+        StaticRecursiveMutexGuard inner(staticRecursive);
+        TEST_ASSERT_TRUE(inner.hasLock());
+    }
+    TEST_ASSERT_TRUE(outer.hasLock());
+}
+
+static StaticMutex* raced = nullptr;
+static SemaphoreHandle_t seenHandles[STATIC_TEST_TASKS];
+static SemaphoreHandle_t racersDone = nullptr;
+
+static void firstUseTask(void* param) {
+    int index = (int)(intptr_t)param;
+    StaticMutexGuard lock(*raced, portMAX_DELAY);
+    seenHandles[index] = lock.hasLock() ? raced->handle() : nullptr;
+    xSemaphoreGive(racersDone);
+    vTaskDelete(NULL);
+}
+
+void test_static_mutex_concurrent_first_use() {
+    raced = new StaticMutex();
+    racersDone = xSemaphoreCreateCounting(STATIC_TEST_TASKS, 0);
+
+    for (int i = 0; i < STATIC_TEST_TASKS; i++) {
+        xTaskCreatePinnedToCore(firstUseTask, "StaticUse", 2048, (void*)(intptr_t)i, 1, NULL,
+                                i % portNUM_PROCESSORS);
+    }
+    for (int i = 0; i < STATIC_TEST_TASKS; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(racersDone, pdMS_TO_TICKS(5000)) == pdTRUE);
+    }
+
+    // All tasks locked the one kernel object
+    for (int i = 0; i < STATIC_TEST_TASKS; i++) {
+        TEST_ASSERT_NOT_NULL(seenHandles[i]);
+        TEST_ASSERT_TRUE(seenHandles[i] == raced->handle());
+    }
+    vSemaphoreDelete(raced->handle());
+    delete raced;
+    vSemaphoreDelete(racersDone);
+}
+
+void runStaticMutexTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_static_mutex_usable_during_static_init);
+    RUN_TEST(test_static_mutex_handle_is_stable);
+    RUN_TEST(test_static_mutex_guard_locks_and_releases);
+    RUN_TEST(test_static_mutex_works_with_mutex_guard);
+    RUN_TEST(test_static_recursive_mutex_nests);
+    RUN_TEST(test_static_mutex_concurrent_first_use);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== StaticMutex Tests ===\n");
+    runStaticMutexTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST
@@ -0,0 +1,209 @@
+/**
+ * @file test_synchronized.cpp
+ * @brief Unit tests for Synchronized<T>
+ */
+
+#ifdef UNIT_TEST
+
+#include <type_traits>
+
+#include <Arduino.h>
+#include <unity.h>
+#include <Synchronized.h>
+
+#define SYNC_TEST_TASKS 4
+#define SYNC_TEST_ITERATIONS 500
+
+struct Account {
+    int32_t balance;
+    uint32_t updates;
+};
+
+// Used from a static constructor that runs before their definitions; the
+// values survive because both are constant-initialized
+extern Synchronized<int> earlyDefault;
+extern Synchronized<int> earlyValue;
+static struct EarlyUser {
+    EarlyUser() {
+        earlyDefault.withLock([](int& v) { v += 5; });
+        earlyValue.withLock([](int& v) { v += 5; });
+    }
+} earlyUser;
+Synchronized<int> earlyDefault;
+Synchronized<int> earlyValue(7);
+
+void setUp() {}
+
+void tearDown() {}
+
+static bool isFree(SemaphoreHandle_t handle) {
+    if (xSemaphoreTake(handle, 0) != pdTRUE) {
+        return false;
+    }
+    xSemaphoreGive(handle);
+    return true;
+}
+
+void test_synchronized_lock_holds_mutex() {
+    Synchronized<Account> account(Account{100, 0});
+    {
+        auto locked = account.lock();
+        TEST_ASSERT_TRUE(locked.hasLock());
+        TEST_ASSERT_FALSE(isFree(account.handle()));
+        locked->balance += 5;
+        (*locked).updates++;
+
+        // A second handle times out while the first one holds the mutex
+        auto second = account.lock(pdMS_TO_TICKS(10));
+        TEST_ASSERT_FALSE(second);
+    }
+    TEST_ASSERT_TRUE(isFree(account.handle()));
+
+    Account copy = {};
+    TEST_ASSERT_TRUE(account.get(copy));
+    TEST_ASSERT_EQUAL_INT(105, copy.balance);
+    TEST_ASSERT_EQUAL_UINT32(1, copy.updates);
+}
+
+static_assert(!std::is_constructible<Synchronized<int>, Synchronized<int>&>::value,
+              "Synchronized must not be copyable through the forwarding constructor");
+
+void test_synchronized_default_constructed() {
+    static Synchronized<Account> stats = {};
+    Account copy = {1, 1};
+    TEST_ASSERT_TRUE(stats.get(copy));
+    TEST_ASSERT_EQUAL_INT(0, copy.balance);
+    TEST_ASSERT_EQUAL_UINT32(0, copy.updates);
+}
+
+void test_synchronized_constant_initialized() {
+    int value = 0;
+    TEST_ASSERT_TRUE(earlyDefault.get(value));
+    TEST_ASSERT_EQUAL_INT(5, value);
+    TEST_ASSERT_TRUE(earlyValue.get(value));
+    TEST_ASSERT_EQUAL_INT(12, value);
+}
+
+void test_synchronized_handle_unlock_and_move() {
+    Synchronized<int> value(7);
+    auto locked = value.lock();
+    auto moved = std::move(locked);
+    TEST_ASSERT_FALSE(locked.hasLock());
+    TEST_ASSERT_TRUE(moved.hasLock());
+    TEST_ASSERT_EQUAL_INT(7, *moved);
+
+    moved.unlock();
+    TEST_ASSERT_FALSE(moved.hasLock());
+    TEST_ASSERT_TRUE(isFree(value.handle()));
+}
+
+void test_synchronized_const_access() {
+    Synchronized<int> value(42);
+    const Synchronized<int>& view = value;
+
+    auto locked = view.lock();
+    TEST_ASSERT_TRUE(locked.hasLock());
+    TEST_ASSERT_EQUAL_INT(42, *locked);
+    locked.unlock();
+
+    int seen = 0;
+    TEST_ASSERT_TRUE(view.withLock([&seen](const int& v) { seen = v; }));
+    TEST_ASSERT_EQUAL_INT(42, seen);
+}
+
+void test_synchronized_with_lock_times_out() {
+    Synchronized<int> value(0);
+    auto locked = value.lock();
+
+    bool ran = false;
+    TEST_ASSERT_FALSE(value.withLock([&ran](int&) { ran = true; }, pdMS_TO_TICKS(10)));
+    TEST_ASSERT_FALSE(ran);
+    TEST_ASSERT_FALSE(value.set(1, pdMS_TO_TICKS(10)));
+}
+
+void test_synchronized_for_each_batches_under_one_lock() {
+    Synchronized<Account> account(Account{0, 0});
+    const int32_t deposits[] = {10, 20, 30, 40};
+
+    size_t applied = account.forEach(deposits, deposits + 4, [&account](Account& a, int32_t amount) {
+        // Still inside the single acquisition
+        TEST_ASSERT_FALSE(isFree(account.handle()));
+        a.balance += amount;
+        a.updates++;
+    });
+    TEST_ASSERT_EQUAL_UINT32(4, applied);
+
+    Account copy = {};
+    TEST_ASSERT_TRUE(account.get(copy));
+    TEST_ASSERT_EQUAL_INT(100, copy.balance);
+    TEST_ASSERT_EQUAL_UINT32(4, copy.updates);
+
+    auto locked = account.lock();
+    TEST_ASSERT_EQUAL_UINT32(0, account.forEach(deposits, deposits + 4,
+                                                [](Account&, int32_t) {}, pdMS_TO_TICKS(10)));
+}
+
+static Synchronized<Account>* shared = nullptr;
+static SemaphoreHandle_t workersDone = nullptr;
+
+static void depositTask(void* param) {
+    (void)param;
+    for (int i = 0; i < SYNC_TEST_ITERATIONS; i++) {
+        shared->withLock([](Account& a) {
+            // Read-modify-write that would lose updates without the lock
+            int32_t balance = a.balance;
+            a.updates++;
+            a.balance = balance + 1;
+        }, portMAX_DELAY);
+    }
+    xSemaphoreGive(workersDone);
+    vTaskDelete(NULL);
+}
+
+void test_synchronized_concurrent_updates() {
+    shared = new Synchronized<Account>(Account{0, 0});
+    workersDone = xSemaphoreCreateCounting(SYNC_TEST_TASKS, 0);
+
+    for (int i = 0; i < SYNC_TEST_TASKS; i++) {
+        xTaskCreatePinnedToCore(depositTask, "SyncDeposit", 2048, NULL, 1, NULL,
+                                i % portNUM_PROCESSORS);
+    }
+    for (int i = 0; i < SYNC_TEST_TASKS; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(workersDone, pdMS_TO_TICKS(10000)) == pdTRUE);
+    }
+
+    Account copy = {};
+    TEST_ASSERT_TRUE(shared->get(copy));
+    TEST_ASSERT_EQUAL_INT(SYNC_TEST_TASKS * SYNC_TEST_ITERATIONS, copy.balance);
+    TEST_ASSERT_EQUAL_UINT32(SYNC_TEST_TASKS * SYNC_TEST_ITERATIONS, copy.updates);
+
+    vSemaphoreDelete(shared->handle());
+    delete shared;
+    vSemaphoreDelete(workersDone);
+}
+
+void runSynchronizedTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_synchronized_lock_holds_mutex);
+    RUN_TEST(test_synchronized_default_constructed);
+    RUN_TEST(test_synchronized_constant_initialized);
+    RUN_TEST(test_synchronized_handle_unlock_and_move);
+    RUN_TEST(test_synchronized_const_access);
+    RUN_TEST(test_synchronized_with_lock_times_out);
+    RUN_TEST(test_synchronized_for_each_batches_under_one_lock);
+    RUN_TEST(test_synchronized_concurrent_updates);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== Synchronized Tests ===\n");
+    runSynchronizedTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST
@@ -18,7 +18,7 @@ static volatile int sharedCounter = 0;
 static volatile int threadsDone = 0;
 
 void incrementTask(void* param) {
-    int taskId = (int)(intptr_t)param;
+    (void)param;
 
     // Wait for start signal
     xSemaphoreTake(startSemaphore, portMAX_DELAY);
@@ -42,15 +42,17 @@ void test_concurrent_increment() {
     threadsDone = 0;
 
     testMutex = xSemaphoreCreateMutex();
-    startSemaphore = xSemaphoreCreateBinary();
+    startSemaphore = xSemaphoreCreateCounting(TEST_THREADS, 0);
 
     // Create worker tasks
     for (int i = 0; i < TEST_THREADS; i++) {
         xTaskCreate(incrementTask, "Inc", 2048, (void*)(intptr_t)i, 1, NULL);
     }
 
-    // Start all tasks simultaneously
-    xSemaphoreGive(startSemaphore);
+    // Start all tasks simultaneously (one start token per task)
+    for (int i = 0; i < TEST_THREADS; i++) {
+        xSemaphoreGive(startSemaphore);
+    }
 
     // Wait for all tasks to complete
     while (threadsDone < TEST_THREADS) {
@@ -137,13 +139,15 @@ void test_mutual_exclusion() {
     currentAccess = 0;
 
     SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
-    startSemaphore = xSemaphoreCreateBinary();
+    startSemaphore = xSemaphoreCreateCounting(TEST_THREADS, 0);
 
     for (int i = 0; i < TEST_THREADS; i++) {
         xTaskCreate(resourceAccessTask, "Res", 2048, mutex, 1, NULL);
     }
 
-    xSemaphoreGive(startSemaphore);
+    for (int i = 0; i < TEST_THREADS; i++) {
+        xSemaphoreGive(startSemaphore);
+    }
 
     while (threadsDone < TEST_THREADS) {
         vTaskDelay(pdMS_TO_TICKS(100));
@@ -0,0 +1,178 @@
+/**
+ * @file test_unique_mutex_guard.cpp
+ * @brief Unit tests for UniqueMutexGuard
+ */
+
+#ifdef UNIT_TEST
+
+#include <Arduino.h>
+#include <unity.h>
+#include <utility>
+#include <MutexGuard.h>
+#include <UniqueMutexGuard.h>
+
+static_assert(sizeof(UniqueMutexGuard) == sizeof(MutexGuard),
+              "UniqueMutexGuard must stay as small as MutexGuard");
+
+static SemaphoreHandle_t testMutex = nullptr;
+
+void setUp() {
+    if (testMutex == nullptr) {
+        testMutex = xSemaphoreCreateMutex();
+    }
+}
+
+void tearDown() {
+    // Ensure mutex is released
+    xSemaphoreGive(testMutex);
+}
+
+static bool mutexIsFree() {
+    if (xSemaphoreTake(testMutex, 0) != pdTRUE) {
+        return false;
+    }
+    xSemaphoreGive(testMutex);
+    return true;
+}
+
+static UniqueMutexGuard lockTestMutex() {
+    return UniqueMutexGuard(testMutex);
+}
+
+void test_unique_guard_locks_and_releases() {
+    {
+        UniqueMutexGuard guard(testMutex);
+        TEST_ASSERT_TRUE(guard.hasLock());
+        TEST_ASSERT_TRUE(guard.mutex() == testMutex);
+        TEST_ASSERT_FALSE(mutexIsFree());
+    }
+    TEST_ASSERT_TRUE(mutexIsFree());
+}
+
+void test_unique_guard_returned_from_function() {
+    {
+        UniqueMutexGuard guard = lockTestMutex();
+        TEST_ASSERT_TRUE(guard.hasLock());
+        TEST_ASSERT_FALSE(mutexIsFree());
+    }
+    TEST_ASSERT_TRUE(mutexIsFree());
+}
+
+void test_unique_guard_move_transfers_ownership() {
+    UniqueMutexGuard first(testMutex);
+    UniqueMutexGuard second(std::move(first));
+    TEST_ASSERT_FALSE(first.hasLock());
+    TEST_ASSERT_FALSE(first.isValid());
+    TEST_ASSERT_TRUE(second.hasLock());
+
+    UniqueMutexGuard third;
+    third = std::move(second);
+    TEST_ASSERT_FALSE(second.hasLock());
+    TEST_ASSERT_TRUE(third.hasLock());
+
+    third.unlock();
+    TEST_ASSERT_TRUE(mutexIsFree());
+}
+
+void test_unique_guard_move_assignment_unlocks_previous() {
+    SemaphoreHandle_t other = xSemaphoreCreateMutex();
+    UniqueMutexGuard target(other);
+    TEST_ASSERT_TRUE(target.hasLock());
+
+    target = UniqueMutexGuard(testMutex);
+    TEST_ASSERT_TRUE(target.hasLock());
+    TEST_ASSERT_TRUE(target.mutex() == testMutex);
+
+    // The previously held mutex was released by the assignment
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(other, 0));
+    xSemaphoreGive(other);
+    target.unlock();
+    vSemaphoreDelete(other);
+}
+
+void test_unique_guard_defer_and_relock() {
+    UniqueMutexGuard guard(testMutex, deferLock);
+    TEST_ASSERT_TRUE(guard.isValid());
+    TEST_ASSERT_FALSE(guard.hasLock());
+    TEST_ASSERT_TRUE(mutexIsFree());
+
+    TEST_ASSERT_TRUE(guard.lock());
+    TEST_ASSERT_FALSE(mutexIsFree());
+    guard.unlock();
+    TEST_ASSERT_TRUE(mutexIsFree());
+    TEST_ASSERT_TRUE(guard.tryLock());
+    TEST_ASSERT_TRUE(guard.hasLock());
+}
+
+void test_unique_guard_try_to_lock() {
+    xSemaphoreTake(testMutex, portMAX_DELAY);
+
+    unsigned long start = millis();
+    UniqueMutexGuard busy(testMutex, tryToLock);
+    TEST_ASSERT_FALSE(busy.hasLock());
+    TEST_ASSERT_LESS_OR_EQUAL(20, millis() - start);
+    TEST_ASSERT_FALSE(busy.tryLock());
+
+    xSemaphoreGive(testMutex);
+    UniqueMutexGuard free(testMutex, tryToLock);
+    TEST_ASSERT_TRUE(free.hasLock());
+}
+
+void test_unique_guard_release_and_adopt() {
+    UniqueMutexGuard guard(testMutex);
+    SemaphoreHandle_t handle = guard.release();
+    TEST_ASSERT_TRUE(handle == testMutex);
+    TEST_ASSERT_FALSE(guard.hasLock());
+    TEST_ASSERT_FALSE(guard.isValid());
+    TEST_ASSERT_FALSE(mutexIsFree());  // Released ownership, not the mutex
+
+    {
+        UniqueMutexGuard adopted(handle, adoptLock);
+        TEST_ASSERT_TRUE(adopted.hasLock());
+    }
+    TEST_ASSERT_TRUE(mutexIsFree());
+}
+
+void test_unique_guard_swap() {
+    UniqueMutexGuard held(testMutex);
+    UniqueMutexGuard empty;
+    empty.swap(held);
+    TEST_ASSERT_FALSE(held.hasLock());
+    TEST_ASSERT_TRUE(empty.hasLock());
+    TEST_ASSERT_TRUE(empty.mutex() == testMutex);
+}
+
+void test_unique_guard_null_handle() {
+    UniqueMutexGuard guard(nullptr);
+    TEST_ASSERT_FALSE(guard.hasLock());
+    TEST_ASSERT_FALSE(guard.isValid());
+    TEST_ASSERT_FALSE(guard.lock(0));
+    TEST_ASSERT_TRUE(guard.release() == nullptr);
+}
+
+void runUniqueMutexGuardTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_unique_guard_locks_and_releases);
+    RUN_TEST(test_unique_guard_returned_from_function);
+    RUN_TEST(test_unique_guard_move_transfers_ownership);
+    RUN_TEST(test_unique_guard_move_assignment_unlocks_previous);
+    RUN_TEST(test_unique_guard_defer_and_relock);
+    RUN_TEST(test_unique_guard_try_to_lock);
+    RUN_TEST(test_unique_guard_release_and_adopt);
+    RUN_TEST(test_unique_guard_swap);
+    RUN_TEST(test_unique_guard_null_handle);
+
+    UNITY_END();
+}
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== UniqueMutexGuard Tests ===\n");
+    runUniqueMutexGuardTests();
+}
+
+void loop() {}
+
+#endif // UNIT_TEST
@@ -0,0 +1,304 @@
+#!/usr/bin/env python3
+"""Decode MUTEXGUARD_BINARY_LOG records back into log text.
+
+Build the firmware with MUTEXGUARD_BINARY_LOG and save the raw serial output
+(or whatever the BinaryLog sink wrote), then:
+
+    python3 tools/binary_log.py table src -o strings.json
+    python3 tools/binary_log.py decode --table strings.json capture.bin
+
+`table` scans the sources for MUTEXG_LOG_*, RMUTEXG_LOG_*, MUTEX_GUARD_LOG and
+RECURSIVE_MUTEX_GUARD_LOG calls and writes the string table. Each entry maps
+a message ID to the level, tag and format string. The IDs are computed with
+the same hash as BinaryLog::messageId(). `decode --sources DIR` (repeatable)
+builds the table on the fly. Records print in the ESP-IDF layout:
+
+    I (1234) MutexGuard: Mutex 'config' locked
+
+Text between the records (e.g. other prints on the same UART) is passed
+through unchanged.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+ID_BITS = 21  # MUTEXGUARD_BINARY_LOG_ID_BITS
+ESCAPE = 0x7D  # Followed by LF, CR or 0x7D XOR 0x20
+
+LEVELS = {"E": 1, "W": 2, "I": 3, "D": 4, "V": 5}  # esp_log_level_t
+LEVEL_LETTERS = {value: key for key, value in LEVELS.items()}
+
+# Logging macro -> (tag macro, level letter; None if part of the name)
+MACROS = {
+    "MUTEXG_LOG": ("MUTEXG_LOG_TAG", None),
+    "RMUTEXG_LOG": ("RMUTEXG_LOG_TAG", None),
+    "MUTEX_GUARD_LOG": ("MUTEXG_LOG_TAG", "I"),
+    "RECURSIVE_MUTEX_GUARD_LOG": ("RMUTEXG_LOG_TAG", "I"),
+}
+
+CALL_RE = re.compile(r"\b(RECURSIVE_MUTEX_GUARD_LOG|MUTEX_GUARD_LOG|R?MUTEXG_LOG)(?:_([EWIDV]))?\s*\(\s*"
+                     r"((?:\"(?:[^\"\\\n]|\\.)*\"\s*)+)")
+STRING_RE = re.compile(r"\"((?:[^\"\\\n]|\\.)*)\"")
+TAG_RE = re.compile(r"#define\s+(\w+_LOG_TAG)\s+\"((?:[^\"\\\n]|\\.)*)\"")
+SPEC_RE = re.compile(r"%(?:%|[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|j|z|t|L)?([diouxXcspfFeEgGaA]))")
+
+SOURCE_SUFFIXES = (".h", ".hpp", ".c", ".cpp", ".ino")
+
+
+def c_unescape(text):
+    """Bytes of a C string literal body."""
+    return text.encode("latin-1").decode("unicode_escape").encode("latin-1")
+
+
+def fnv1a(data, value):
+    for byte in data:
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def message_id(level, tag, fmt):
+    """Same as BinaryLog::messageId(); tag and fmt are bytes."""
+    value = ((2166136261 ^ level) * 16777619) & 0xFFFFFFFF
+    value = (fnv1a(tag, value) * 16777619) & 0xFFFFFFFF  # '\0' separator
+    return fnv1a(fmt, value) & ((1 << ID_BITS) - 1)
+
+
+def source_files(paths):
+    for path in paths:
+        if os.path.isfile(path):
+            yield path
+            continue
+        for root, _, names in os.walk(path):
+            for name in sorted(names):
+                if name.endswith(SOURCE_SUFFIXES):
+                    yield os.path.join(root, name)
+
+
+def build_table(paths):
+    """Return {id: {"level", "tag", "format", "where"}} for all log calls."""
+    texts = {}
+    for path in source_files(paths):
+        with open(path, encoding="utf-8", errors="replace") as stream:
+            texts[path] = stream.read()
+
+    tags = {}
+    for text in texts.values():
+        for name, value in TAG_RE.findall(text):
+            tags[name] = c_unescape(value)
+
+    table = {}
+    collisions = []
+    for path, text in texts.items():
+        for match in CALL_RE.finditer(text):
+            macro, letter, literals = match.groups()
+            tag_macro, fixed_letter = MACROS[macro]
+            letter = letter or fixed_letter
+            if letter is None or tag_macro not in tags:
+                continue  # A macro definition or an unknown tag
+            tag = tags[tag_macro]
+            fmt = b"".join(c_unescape(body) for body in STRING_RE.findall(literals))
+            level = LEVELS[letter]
+            key = message_id(level, tag, fmt)
+            entry = {"level": level, "tag": tag.decode("latin-1"), "format": fmt.decode("latin-1"),
+                     "where": "%s:%d" % (path, text.count("\n", 0, match.start()) + 1)}
+            other = table.get(key)
+            if other is not None and (other["level"], other["tag"], other["format"]) != \
+                    (entry["level"], entry["tag"], entry["format"]):
+                collisions.append((key, other, entry))
+            table.setdefault(key, entry)
+    if collisions:
+        details = "; ".join("%s and %s share ID %d" % (a["where"], b["where"], key)
+                            for key, a, b in collisions)
+        raise ValueError("message ID collision, reword one of the messages: " + details)
+    return table
+
+
+def load_table(path):
+    with open(path, encoding="utf-8") as stream:
+        return {int(key): value for key, value in json.load(stream).items()}
+
+
+def unescape(chunk):
+    out = bytearray()
+    index = 0
+    while index < len(chunk):
+        byte = chunk[index]
+        if byte == ESCAPE:
+            if index + 1 >= len(chunk) or chunk[index + 1] ^ 0x20 not in (0x0A, 0x0D, ESCAPE):
+                return None
+            byte = chunk[index + 1] ^ 0x20
+            index += 1
+        out.append(byte)
+        index += 1
+    return bytes(out)
+
+
+def cobs_decode(chunk):
+    out = bytearray()
+    index = 0
+    while index < len(chunk):
+        code = chunk[index]
+        end = index + code
+        if end > len(chunk):
+            return None
+        out += chunk[index + 1:end]
+        index = end
+        if code < 0xFF and index < len(chunk):
+            out.append(0)
+    return bytes(out)
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.offset = 0
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            if self.offset >= len(self.data) or shift > 63:
+                raise ValueError("truncated varint")
+            byte = self.data[self.offset]
+            self.offset += 1
+            value |= (byte & 0x7F) << shift
+            if byte < 0x80:
+                return value
+            shift += 7
+
+    def signed(self):
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+    def double(self):
+        if self.offset + 8 > len(self.data):
+            raise ValueError("truncated double")
+        value = struct.unpack_from("<d", self.data, self.offset)[0]
+        self.offset += 8
+        return value
+
+    def string(self):
+        length = self.varint()
+        if self.offset + length > len(self.data):
+            raise ValueError("truncated string")
+        value = self.data[self.offset:self.offset + length].decode("utf-8", errors="replace")
+        self.offset += length
+        return value
+
+
+def render(fmt, reader):
+    """printf the format with the arguments read from the record."""
+    def convert(match):
+        spec = match.group(0)
+        conversion = match.group(1)
+        if spec == "%%":
+            return "%"
+        # Python's % has no length modifiers, %u or %p
+        base = re.sub(r"(hh|h|ll|l|j|z|t|L)(?=[a-zA-Z]$)", "", spec)
+        if conversion in "di":
+            return base % reader.signed()
+        if conversion in "fFeEgGaA":
+            value = reader.double()
+            return float.hex(value) if conversion in "aA" else base % value
+        if conversion == "s":
+            return base % reader.string()
+        value = reader.varint()
+        if conversion == "u":
+            return (base[:-1] + "d") % value
+        if conversion == "c":
+            return base % chr(value)
+        if conversion == "p":
+            return (base[:-1] + "s") % ("0x%x" % value)
+        return base % value
+
+    return SPEC_RE.sub(convert, fmt)
+
+
+def decode_record(payload, table):
+    reader = Reader(payload)
+    key = reader.varint()
+    timestamp = reader.varint()
+    entry = table.get(key)
+    if entry is None:
+        raise ValueError("unknown message ID %d" % key)
+    text = render(entry["format"], reader)
+    if reader.offset != len(payload):
+        raise ValueError("%d bytes left over" % (len(payload) - reader.offset))
+    return "%s (%u) %s: %s" % (LEVEL_LETTERS.get(entry["level"], "?"), timestamp, entry["tag"], text)
+
+
+def decode_stream(data, table, out):
+    """Write the decoded records and the text between them to out."""
+    records = 0
+    for chunk in data.split(b"\x00"):
+        if not chunk:
+            continue
+        stuffed = unescape(chunk)
+        payload = cobs_decode(stuffed) if stuffed is not None else None
+        line = None
+        if payload is not None:
+            try:
+                line = decode_record(payload, table)
+            except ValueError:
+                line = None
+        if line is not None:
+            out.write(line + "\n")
+            records += 1
+        else:
+            out.write(chunk.decode("utf-8", errors="replace"))
+    return records
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    commands = parser.add_subparsers(dest="command")
+
+    table_parser = commands.add_parser("table", help="write the string table")
+    table_parser.add_argument("sources", nargs="+", help="source files or directories")
+    table_parser.add_argument("-o", "--output", help="JSON file to write (default: stdout)")
+
+    decode_parser = commands.add_parser("decode", help="decode a capture")
+    decode_parser.add_argument("input", nargs="?", help="raw capture (default: stdin)")
+    group = decode_parser.add_mutually_exclusive_group(required=True)
+    group.add_argument("--table", help="string table from the 'table' command")
+    group.add_argument("--sources", action="append", metavar="PATH",
+                       help="build the table from this source file or directory (repeatable)")
+    decode_parser.add_argument("-o", "--output", help="text file to write (default: stdout)")
+
+    options = parser.parse_args()
+    if options.command == "table":
+        table = build_table(options.sources)
+        result = json.dumps({str(key): table[key] for key in sorted(table)}, indent=1)
+        if options.output:
+            with open(options.output, "w", encoding="utf-8") as stream:
+                stream.write(result + "\n")
+            print("%d messages -> %s" % (len(table), options.output), file=sys.stderr)
+        else:
+            print(result)
+    elif options.command == "decode":
+        table = load_table(options.table) if options.table else build_table(options.sources)
+        if options.input:
+            with open(options.input, "rb") as stream:
+                data = stream.read()
+        else:
+            data = sys.stdin.buffer.read()
+        if options.output:
+            with open(options.output, "w", encoding="utf-8") as stream:
+                records = decode_stream(data, table, stream)
+            print("%d records -> %s" % (records, options.output), file=sys.stderr)
+        else:
+            decode_stream(data, table, sys.stdout)
+    else:
+        parser.print_help()
+        sys.exit(2)
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except ValueError as error:
+        sys.exit("binary_log: %s" % error)
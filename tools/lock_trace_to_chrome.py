@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+"""Convert a LockTrace::dump() capture into Chrome trace_event JSON.
+
+Build the firmware with MUTEXGUARD_TRACE, call LockTrace::dump() and save
+the serial output, then:
+
+    python3 tools/lock_trace_to_chrome.py trace.log -o trace.json
+
+Open trace.json in https://ui.perfetto.dev or chrome://tracing. Every task
+is a row. A "wait <mutex>" slice runs from the start of a take until the
+mutex was acquired, "hold <mutex>" until it was released again, and
+"timeout <mutex>" marks a take that gave up.
+
+The dump lines may carry log prefixes and colour codes; everything before
+"LT " is ignored. If the log holds several dumps, the last one is used.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+LINE_RE = re.compile(r"\bLT (begin|end|T|M|E)\b ?(.*)$")
+ANSI_RE = re.compile(r"\x1b\[[0-9;]*m")
+
+PID = 1
+
+
+def read_dump(lines):
+    """Return (tasks, mutexes, events) of the last complete dump."""
+    dumps = []
+    current = None
+    for raw in lines:
+        match = LINE_RE.search(ANSI_RE.sub("", raw).rstrip())
+        if not match:
+            continue
+        kind, rest = match.groups()
+        if kind == "begin":
+            current = {"tasks": {}, "mutexes": {}, "events": []}
+        elif current is None:
+            continue
+        elif kind == "T" or kind == "M":
+            address, _, name = rest.partition(" ")
+            current["tasks" if kind == "T" else "mutexes"][address] = name
+        elif kind == "E":
+            fields = rest.split()
+            if len(fields) != 5:
+                continue
+            timestamp, core, event_type, task, handle = fields
+            current["events"].append((int(timestamp), int(core), event_type, task, handle))
+        elif kind == "end":
+            dumps.append(current)
+            current = None
+    if not dumps:
+        raise ValueError("no complete 'LT begin' ... 'LT end' block found")
+    last = dumps[-1]
+    return last["tasks"], last["mutexes"], last["events"]
+
+
+def unwrap(events):
+    """Turn the 32-bit microsecond timestamps into a monotonic timeline."""
+    result = []
+    previous_raw = None
+    offset = 0
+    for timestamp, core, event_type, task, handle in events:
+        if previous_raw is not None:
+            delta = (timestamp - previous_raw) & 0xFFFFFFFF
+            if delta >= 0x80000000:
+                delta -= 0x100000000  # Slightly out of order, not a wrap
+            offset += delta
+        else:
+            offset = timestamp
+        previous_raw = timestamp
+        result.append((offset, core, event_type, task, handle))
+    result.sort(key=lambda event: event[0])
+    return result
+
+
+def convert(tasks, mutexes, events):
+    events = unwrap(events)
+    origin = events[0][0] if events else 0
+
+    tids = {}
+    trace = [{"ph": "M", "pid": PID, "name": "process_name", "args": {"name": "MutexGuard locks"}}]
+
+    def tid_of(task):
+        if task not in tids:
+            tids[task] = len(tids) + 1
+            trace.append({"ph": "M", "pid": PID, "tid": tids[task], "name": "thread_name",
+                          "args": {"name": tasks.get(task, task)}})
+        return tids[task]
+
+    def slice_event(name, category, task, start, end, args):
+        trace.append({"ph": "X", "pid": PID, "tid": tid_of(task), "name": name, "cat": category,
+                      "ts": start - origin, "dur": max(end - start, 0), "args": args})
+
+    waits = {}  # (task, handle) -> stack of (start, core)
+    holds = {}
+    for timestamp, core, event_type, task, handle in events:
+        key = (task, handle)
+        mutex = mutexes.get(handle, handle)
+        args = {"mutex": mutex, "core": core}
+        if event_type == "W":
+            waits.setdefault(key, []).append((timestamp, core))
+        elif event_type in ("A", "T"):
+            pending = waits.get(key)
+            start = pending.pop()[0] if pending else timestamp
+            if event_type == "A":
+                slice_event("wait " + mutex, "wait", task, start, timestamp, args)
+                holds.setdefault(key, []).append((timestamp, core))
+            else:
+                slice_event("timeout " + mutex, "timeout", task, start, timestamp, args)
+        elif event_type == "R":
+            pending = holds.get(key)
+            if pending:
+                slice_event("hold " + mutex, "hold", task, pending.pop()[0], timestamp, args)
+            else:
+                # Acquired before the oldest event still in the ring
+                trace.append({"ph": "i", "s": "t", "pid": PID, "tid": tid_of(task),
+                              "name": "release " + mutex, "cat": "hold",
+                              "ts": timestamp - origin, "args": args})
+
+    # Still waiting or holding when the trace was stopped
+    end = events[-1][0] if events else origin
+    for stacks, label in ((waits, "wait"), (holds, "hold")):
+        for (task, handle), pending in stacks.items():
+            mutex = mutexes.get(handle, handle)
+            for start, core in pending:
+                slice_event(label + " " + mutex, label, task, start, end,
+                            {"mutex": mutex, "core": core, "unfinished": True})
+
+    return {"traceEvents": trace, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", nargs="?", help="captured log (default: stdin)")
+    parser.add_argument("-o", "--output", help="JSON file to write (default: stdout)")
+    options = parser.parse_args()
+
+    if options.input:
+        with open(options.input, encoding="utf-8", errors="replace") as stream:
+            tasks, mutexes, events = read_dump(stream)
+    else:
+        tasks, mutexes, events = read_dump(sys.stdin)
+
+    result = convert(tasks, mutexes, events)
+    if options.output:
+        with open(options.output, "w", encoding="utf-8") as stream:
+            json.dump(result, stream)
+        print("%d lock events from %d tasks -> %s" % (len(events), len(tasks), options.output),
+              file=sys.stderr)
+    else:
+        json.dump(result, sys.stdout)
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except ValueError as error:
+        sys.exit("lock_trace_to_chrome: %s" % error)